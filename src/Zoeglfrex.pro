@@ -7,12 +7,25 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
 
+# shm_open is part of librt on older glibc versions
+unix:!macx: LIBS += -lrt
+
+# Working on the file in memory needs the SQLite C API, build with CONFIG+=system_sqlite if Qt's SQLite driver uses the system library
+# Zöglfrex checks at runtime that the driver doesn't use a bundled copy of SQLite before it uses the driver's connection
+system_sqlite {
+    LIBS += -lsqlite3
+    unix: LIBS += -ldl
+    DEFINES += ZOEGLFREX_SQLITE_API
+}
+
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
     aboutwindow/aboutwindow.cpp \
+    artnetserver/artnetoutput.cpp \
+    artnetserver/artnetserver.cpp \
     controlpanel/controlpanel.cpp \
     controlpanel/intensitycolorpositiontab/attributepanel.cpp \
     controlpanel/intensitycolorpositiontab/intensitycolorpositiontab.cpp \
@@ -20,19 +33,39 @@ SOURCES += \
     controlpanel/rawtab/rawtab.cpp \
     cuelistview/cuelisttablemodel.cpp \
     cuelistview/cuelistview.cpp \
+    database/checkpointthread.cpp \
+    database/databasenotifier.cpp \
+    database/databaseprofile.cpp \
+    database/itemindex.cpp \
+    database/memorydatabase.cpp \
+    database/preparedquery.cpp \
+    database/queryplancheck.cpp \
+    datagramsender/datagramsender.cpp \
     dmxengine/dmxengine.cpp \
+    dmxengine/enginecache.cpp \
     inspector/inspector.cpp \
     inspector/itemtablemodel.cpp \
     main.cpp \
     mainwindow/mainwindow.cpp \
+    outputbackend/outputbackend.cpp \
+    outputsettings/outputsettings.cpp \
+    outputthread/dmxframe.cpp \
+    outputthread/outputthread.cpp \
     playbackmonitor/playbackmonitor.cpp \
     preview2d/fixturegraphicsitem.cpp \
     preview2d/preview2d.cpp \
+    sacnserver/sacninput.cpp \
+    sacnserver/sacnoutput.cpp \
     sacnserver/sacnserver.cpp \
+    sharedmemoryoutput/sharedmemoryoutput.cpp \
+    statisticswindow/statisticswindow.cpp \
+    terminal/idselection.cpp \
     terminal/terminal.cpp
 
 HEADERS += \
     aboutwindow/aboutwindow.h \
+    artnetserver/artnetoutput.h \
+    artnetserver/artnetserver.h \
     constants.h \
     controlpanel/controlpanel.h \
     controlpanel/intensitycolorpositiontab/attributepanel.h \
@@ -41,14 +74,35 @@ HEADERS += \
     controlpanel/rawtab/rawtab.h \
     cuelistview/cuelisttablemodel.h \
     cuelistview/cuelistview.h \
+    database/checkpointthread.h \
+    database/databasenotifier.h \
+    database/databaseprofile.h \
+    database/itemindex.h \
+    database/memorydatabase.h \
+    database/preparedquery.h \
+    database/queryplancheck.h \
+    datagramsender/datagramsender.h \
     dmxengine/dmxengine.h \
+    dmxengine/enginecache.h \
     inspector/inspector.h \
     inspector/itemtablemodel.h \
     mainwindow/mainwindow.h \
+    outputbackend/outputbackend.h \
+    outputsettings/outputsettings.h \
+    outputthread/dmxframe.h \
+    outputthread/frameoutput.h \
+    outputthread/framequeue.h \
+    outputthread/outputthread.h \
     playbackmonitor/playbackmonitor.h \
     preview2d/fixturegraphicsitem.h \
     preview2d/preview2d.h \
+    sacnserver/sacninput.h \
+    sacnserver/sacnoutput.h \
     sacnserver/sacnserver.h \
+    sharedmemoryoutput/sharedmemorylayout.h \
+    sharedmemoryoutput/sharedmemoryoutput.h \
+    statisticswindow/statisticswindow.h \
+    terminal/idselection.h \
     terminal/terminal.h
 
 # Default rules for deployment.
@@ -0,0 +1,129 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "artnetoutput.h"
+
+ArtNetOutput::ArtNetOutput(QObject* parent) : OutputBackend("Art-Net", 6454, parent) {
+    syncPacket = createSyncPacket();
+}
+
+bool ArtNetOutput::supportsSync() const {
+    return true;
+}
+
+int ArtNetOutput::getMaximumRate() const {
+    return 44;
+}
+
+void ArtNetOutput::setSync(const bool enabled) {
+    QMutexLocker locker(&configurationMutex);
+    configuration.sync = enabled;
+    setConfigurationChanged();
+}
+
+void ArtNetOutput::applyConfiguration() {
+    sync = configuration.sync;
+}
+
+void ArtNetOutput::queueFrame(const DmxFrame& frame) {
+    for (int index = 0; index < frame.universeCount; index++) {
+        const int universe = frame.universes.at(index);
+        const QByteArray& data = frame.data.at(index);
+        Q_ASSERT(data.size() <= 512);
+        if ((universe < 1) || (universe > 32768)) {
+            continue;
+        }
+        const int length = std::max(2, (int)(data.size() + 1) & ~1);
+
+        QByteArray* packet = getDataPacket(universe);
+        packet->resize(18 + length);
+        char* packetData = packet->data();
+
+        // Sequence (Octet 12)
+        packetData[12] = (char)(((uint8_t)packetData[12] % 255) + 1);
+
+        // Length (Octet 16-17)
+        packetData[16] = (char)(length / 256);
+        packetData[17] = (char)(length % 256);
+
+        // Data (Octet 18-529)
+        memcpy(packetData + 18, data.constData(), data.size());
+        memset(packetData + 18 + data.size(), 0, length - data.size());
+
+        queuePacket(*packet, universe);
+    }
+    if (sync) {
+        queuePacket(syncPacket, 0, true);
+    }
+}
+
+quint32 ArtNetOutput::getDefaultDestination(const int universe, const QNetworkAddressEntry& address) const {
+    Q_UNUSED(universe);
+    if (address.broadcast().isNull()) {
+        return QHostAddress(QHostAddress::Broadcast).toIPv4Address();
+    }
+    return address.broadcast().toIPv4Address();
+}
+
+QByteArray ArtNetOutput::createDataPacket(const int universe) {
+    const int portAddress = universe - 1;
+    QByteArray packet;
+    // ID (Octet 0-7)
+    packet.append("Art-Net");
+    packet.append((char)0x00);
+
+    // OpCode (Octet 8-9)
+    packet.append((char)0x00);
+    packet.append((char)0x50);
+
+    // Protocol Version (Octet 10-11)
+    packet.append((char)0x00);
+    packet.append((char)0x0e);
+
+    // Sequence (Octet 12)
+    packet.append((char)0x00);
+
+    // Physical (Octet 13)
+    packet.append((char)0x00);
+
+    // SubUni (Octet 14)
+    packet.append((char)(portAddress % 256));
+
+    // Net (Octet 15)
+    packet.append((char)((portAddress / 256) & 0x7f));
+
+    // Length (Octet 16-17)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    packet.reserve(18 + 512);
+    return packet;
+}
+
+QByteArray ArtNetOutput::createSyncPacket() {
+    QByteArray packet;
+    // ID (Octet 0-7)
+    packet.append("Art-Net");
+    packet.append((char)0x00);
+
+    // OpCode (Octet 8-9)
+    packet.append((char)0x00);
+    packet.append((char)0x52);
+
+    // Protocol Version (Octet 10-11)
+    packet.append((char)0x00);
+    packet.append((char)0x0e);
+
+    // Aux1 (Octet 12)
+    packet.append((char)0x00);
+
+    // Aux2 (Octet 13)
+    packet.append((char)0x00);
+
+    return packet;
+}
@@ -0,0 +1,38 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ARTNETOUTPUT_H
+#define ARTNETOUTPUT_H
+
+#include <QtNetwork>
+
+#include "outputbackend/outputbackend.h"
+
+class ArtNetOutput : public OutputBackend {
+    Q_OBJECT
+public:
+    ArtNetOutput(QObject* parent = nullptr);
+    bool supportsSync() const override;
+    int getMaximumRate() const override;
+    void setSync(bool enabled);
+protected:
+    void applyConfiguration() override;
+    void queueFrame(const DmxFrame& frame) override;
+    QByteArray createDataPacket(int universe) override;
+    quint32 getDefaultDestination(int universe, const QNetworkAddressEntry& address) const override;
+private:
+    struct Configuration {
+        bool sync = false;
+    };
+    QByteArray createSyncPacket();
+    Configuration configuration;
+    bool sync = false;
+    QByteArray syncPacket;
+};
+
+#endif // ARTNETOUTPUT_H
@@ -0,0 +1,119 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "artnetserver.h"
+
+ArtNetServer::ArtNetServer(QWidget* parent) : QWidget(parent, Qt::Window) {
+    settings = new QSettings("Zoeglfrex");
+    output = new ArtNetOutput(this);
+    connect(output, &ArtNetOutput::statisticsChanged, this, &ArtNetServer::statisticsChanged);
+    output->setSync(settings->value("artnet/sync", false).toBool());
+    QGridLayout* layout = new QGridLayout();
+    setLayout(layout);
+    setWindowTitle("Zöglfrex Art-Net Settings");
+
+    QLabel* networkInterfaceLabel = new QLabel("Network Interface");
+    layout->addWidget(networkInterfaceLabel, 0, 0);
+    networkInterfaceComboBox = new QComboBox();
+    reloadNetworkInterfaces();
+
+    loadSocket(networkInterfaceComboBox->currentIndex());
+    connect(networkInterfaceComboBox, &QComboBox::currentIndexChanged, this, &ArtNetServer::loadSocket);
+    layout->addWidget(networkInterfaceComboBox, 0, 1);
+
+    QPushButton* reloadNetworkInterfaceButton = new QPushButton("Reload Network Interfaces");
+    connect(reloadNetworkInterfaceButton, &QPushButton::clicked, this, &ArtNetServer::reloadNetworkInterfaces);
+    layout->addWidget(reloadNetworkInterfaceButton, 1, 0);
+
+    QCheckBox* syncCheckBox = new QCheckBox("Send ArtSync");
+    syncCheckBox->setChecked(settings->value("artnet/sync", false).toBool());
+    connect(syncCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        output->setSync(checked);
+        settings->setValue("artnet/sync", checked);
+    });
+    layout->addWidget(syncCheckBox, 2, 1);
+
+    QLabel* unicastLabel = new QLabel("Unicast Destinations");
+    layout->addWidget(unicastLabel, 3, 0);
+    unicastTableWidget = new QTableWidget(0, 2);
+    unicastTableWidget->setHorizontalHeaderLabels({"Universe", "IP Addresses"});
+    unicastTableWidget->verticalHeader()->hide();
+    unicastTableWidget->horizontalHeader()->setStretchLastSection(true);
+    const int unicastUniverses = settings->beginReadArray("artnet/unicast");
+    for (int row = 0; row < unicastUniverses; row++) {
+        settings->setArrayIndex(row);
+        unicastTableWidget->insertRow(row);
+        unicastTableWidget->setItem(row, 0, new QTableWidgetItem(settings->value("universe").toString()));
+        unicastTableWidget->setItem(row, 1, new QTableWidgetItem(settings->value("addresses").toString()));
+    }
+    settings->endArray();
+    loadUnicastDestinations();
+    connect(unicastTableWidget, &QTableWidget::itemChanged, this, &ArtNetServer::loadUnicastDestinations);
+    layout->addWidget(unicastTableWidget, 3, 1);
+
+    QPushButton* addUnicastButton = new QPushButton("Add Unicast Universe");
+    connect(addUnicastButton, &QPushButton::clicked, this, [this] {
+        const int row = unicastTableWidget->rowCount();
+        unicastTableWidget->insertRow(row);
+        unicastTableWidget->setItem(row, 0, new QTableWidgetItem());
+        unicastTableWidget->setItem(row, 1, new QTableWidgetItem());
+        unicastTableWidget->editItem(unicastTableWidget->item(row, 0));
+    });
+    layout->addWidget(addUnicastButton, 4, 0);
+    QPushButton* removeUnicastButton = new QPushButton("Remove Unicast Universe");
+    connect(removeUnicastButton, &QPushButton::clicked, this, [this] {
+        unicastTableWidget->removeRow(unicastTableWidget->currentRow());
+        loadUnicastDestinations();
+    });
+    layout->addWidget(removeUnicastButton, 4, 1);
+}
+
+void ArtNetServer::reloadNetworkInterfaces() {
+    networkInterfaceComboBox->clear();
+    networkInterfaces.clear();
+    networkAddresses.clear();
+    networkInterfaceComboBox->addItem("None");
+    int interfaceIndex = 0;
+    for (QNetworkInterface interface : QNetworkInterface::allInterfaces()) {
+        for (QNetworkAddressEntry address : interface.addressEntries()) {
+            if (address.ip().protocol() == QAbstractSocket::IPv4Protocol) {
+                networkInterfaceComboBox->addItem(interface.name() + " (" + address.ip().toString() + ")");
+                networkInterfaces.append(interface);
+                networkAddresses.append(address);
+                if ((settings->value("artnet/interface") == interface.name()) && (settings->value("artnet/address") == address.ip().toString())) {
+                    interfaceIndex = networkInterfaces.length();
+                }
+            }
+        }
+    }
+    networkInterfaceComboBox->setCurrentIndex(interfaceIndex);
+}
+
+void ArtNetServer::loadSocket(int index) {
+    index--;
+    if (index >= 0) {
+        OutputBackend::Interface interface;
+        interface.networkInterface = networkInterfaces.at(index);
+        interface.address = networkAddresses.at(index);
+        output->setInterfaces({interface});
+        settings->setValue("artnet/interface", networkInterfaces.at(index).name());
+        settings->setValue("artnet/address", networkAddresses.at(index).ip().toString());
+    } else {
+        output->setInterfaces(QList<OutputBackend::Interface>());
+        settings->setValue("artnet/interface", "none");
+        settings->setValue("artnet/address", "none");
+    }
+}
+
+void ArtNetServer::loadUnicastDestinations() {
+    output->loadUnicastDestinations(unicastTableWidget, settings, "artnet/unicast", 32768);
+}
+
+ArtNetOutput* ArtNetServer::getOutput() const {
+    return output;
+}
@@ -26,6 +26,12 @@ ControlPanel::ControlPanel(QWidget *parent) : QWidget(parent, Qt::Window) {
     tabWidget->addTab(rawTab, "Raws");
 }
 
+void ControlPanel::subscribe(DatabaseNotifier* notifier) {
+    const QStringList valueTables = {"intensity_model_dimmer", "intensity_fixture_dimmer", "color_model_hue", "color_fixture_hue", "color_model_saturation", "color_fixture_saturation", "position_model_pan", "position_fixture_pan", "position_model_tilt", "position_fixture_tilt", "position_model_zoom", "position_fixture_zoom", "position_model_focus", "position_fixture_focus"};
+    notifier->subscribe(valueTables + QStringList({"currentitems", "cuelists", "cues", "models", "fixtures", "groups", "intensities", "colors", "positions", "cue_group_intensities", "cue_group_colors", "cue_group_positions"}), intensityColorPositionTab, [this] { intensityColorPositionTab->reload(); });
+    notifier->subscribe({"currentitems", "models", "fixtures", "groups", "group_fixtures", "raws", "raw_channel_values", "raw_model_channel_values", "raw_fixture_channel_values"}, rawTab, [this] { rawTab->reload(); });
+}
+
 void ControlPanel::reload() {
     intensityColorPositionTab->reload();
     rawTab->reload();
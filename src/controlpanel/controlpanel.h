@@ -11,6 +11,7 @@
 
 #include <QtWidgets>
 
+#include "database/databasenotifier.h"
 #include "intensitycolorpositiontab/intensitycolorpositiontab.h"
 #include "rawtab/rawtab.h"
 
@@ -18,6 +19,7 @@ class ControlPanel : public QWidget {
     Q_OBJECT
 public:
     ControlPanel(QWidget *parent = nullptr);
+    void subscribe(DatabaseNotifier* notifier);
 public slots:
     void reload();
 signals:
@@ -55,15 +55,14 @@ void AttributePanel::reload(const int item, const int model, const int fixture)
     valueDial->setEnabled(itemGiven);
     float value = 0;
     if (itemGiven) {
-        QSqlQuery query;
-        query.prepare("SELECT ROUND(" + attribute + ", 3) FROM " + table + " WHERE key = :key");
-        query.bindValue(":key", itemKey);
-        if (query.exec()) {
-            if (query.next()) {
-                value = query.value(0).toFloat();
+        PreparedQuery query("SELECT ROUND(" + attribute + ", 3) FROM " + table + " WHERE key = :key");
+        query->bindValue(":key", itemKey);
+        if (query->exec()) {
+            if (query->next()) {
+                value = query->value(0).toFloat();
             }
         } else {
-            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
         }
         valueButton->setText(QString::number(value) + unit);
     } else {
@@ -82,22 +81,22 @@ void AttributePanel::reload(const int item, const int model, const int fixture)
 
 void AttributePanel::setValue(const int value) {
     Q_ASSERT(itemKey >= 0);
-    QSqlQuery query;
+    PreparedQuery query;
     if (fixtureValueButton->isChecked()) {
         Q_ASSERT(fixtureKey >= 0);
         query.prepare("UPDATE " + fixtureValueTable + " SET value = :value WHERE item_key = :key AND foreignitem_key = :fixture");
-        query.bindValue(":fixture", fixtureKey);
+        query->bindValue(":fixture", fixtureKey);
     } else if (modelValueButton->isChecked()) {
         Q_ASSERT(modelKey >= 0);
         query.prepare("UPDATE " + modelValueTable + " SET value = :value WHERE item_key = :key AND foreignitem_key = :model");
-        query.bindValue(":model", modelKey);
+        query->bindValue(":model", modelKey);
     } else {
         query.prepare("UPDATE " + table + " SET " + attribute + " = :value WHERE key = :key");
     }
-    query.bindValue(":key", itemKey);
-    query.bindValue(":value", value);
-    if (!query.exec()) {
-        qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+    query->bindValue(":key", itemKey);
+    query->bindValue(":value", value);
+    if (!query->exec()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
     }
     emit dbChanged();
 }
@@ -105,16 +104,16 @@ void AttributePanel::setValue(const int value) {
 void AttributePanel::setException(const int exceptionItemKey, const bool exception, const QString table) {
     Q_ASSERT(itemKey >= 0);
     Q_ASSERT(exceptionItemKey >= 0);
-    QSqlQuery query;
+    PreparedQuery query;
     if (exception) {
         query.prepare("INSERT OR REPLACE INTO " + table + " (item_key, foreignitem_key, value) VALUES (:key, :exceptionitem, 0)");
     } else {
         query.prepare("DELETE FROM " + table + " WHERE item_key = :key AND foreignitem_key = :exceptionitem");
     }
-    query.bindValue(":key", itemKey);
-    query.bindValue(":exceptionitem", exceptionItemKey);
-    if (!query.exec()) {
-        qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+    query->bindValue(":key", itemKey);
+    query->bindValue(":exceptionitem", exceptionItemKey);
+    if (!query->exec()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
     }
     emit dbChanged();
 }
@@ -125,17 +124,16 @@ void AttributePanel::setExceptionButton(const int exceptionItemKey, QPushButton*
     button->setEnabled(itemGiven && exceptionItemGiven);
     bool valueGiven = false;
     if (itemGiven && exceptionItemGiven) {
-        QSqlQuery query;
-        query.prepare("SELECT ROUND(value, 3) FROM " + table + " WHERE item_key = :key AND foreignitem_key = :exceptionkey");
-        query.bindValue(":key", itemKey);
-        query.bindValue(":exceptionkey", exceptionItemKey);
-        if (query.exec()) {
-            valueGiven = query.next();
+        PreparedQuery query("SELECT ROUND(value, 3) FROM " + table + " WHERE item_key = :key AND foreignitem_key = :exceptionkey");
+        query->bindValue(":key", itemKey);
+        query->bindValue(":exceptionkey", exceptionItemKey);
+        if (query->exec()) {
+            valueGiven = query->next();
             if (valueGiven) {
-                (*value) = query.value(0).toFloat();
+                (*value) = query->value(0).toFloat();
             }
         } else {
-            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
         }
     }
     if (itemGiven) {
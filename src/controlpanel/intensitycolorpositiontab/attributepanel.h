@@ -12,6 +12,8 @@
 #include <QtWidgets>
 #include <QtSql>
 
+#include "database/preparedquery.h"
+
 class AttributePanel : public QWidget {
     Q_OBJECT
 public:
@@ -68,15 +68,15 @@ void FixtureChannelModel::setRawKey(const int raw) {
     fixtureKey = -1;
     rawKey = raw;
     QString channelsString = QString();
-    QSqlQuery query;
-    if (query.exec("SELECT models.key, fixtures.key, models.channels FROM models, fixtures, currentitems WHERE currentitems.fixture_key = fixtures.key AND fixtures.model_key = models.key")) {
-        if (query.next()) {
-            modelKey = query.value(0).toInt();
-            fixtureKey = query.value(1).toInt();
-            channelsString = query.value(2).toString();
+    PreparedQuery query("SELECT models.key, fixtures.key, models.channels FROM models, fixtures, currentitems WHERE currentitems.fixture_key = fixtures.key AND fixtures.model_key = models.key");
+    if (query->exec()) {
+        if (query->next()) {
+            modelKey = query->value(0).toInt();
+            fixtureKey = query->value(1).toInt();
+            channelsString = query->value(2).toString();
         }
     } else {
-        qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
     }
 
     channels.clear();
@@ -124,13 +124,12 @@ void FixtureChannelModel::setRawKey(const int raw) {
     }
 
     if ((rawKey >= 0) && (modelKey >= 0)) {
-        QSqlQuery valueQuery;
-        valueQuery.prepare("SELECT key, value FROM raw_channel_values WHERE item_key = :raw");
-        valueQuery.bindValue(":raw", rawKey);
-        if (valueQuery.exec()) {
-            while (valueQuery.next()) {
-                const int channel = valueQuery.value(0).toInt();
-                const uint8_t value = valueQuery.value(1).toInt();
+        PreparedQuery valueQuery("SELECT key, value FROM raw_channel_values WHERE item_key = :raw");
+        valueQuery->bindValue(":raw", rawKey);
+        if (valueQuery->exec()) {
+            while (valueQuery->next()) {
+                const int channel = valueQuery->value(0).toInt();
+                const uint8_t value = valueQuery->value(1).toInt();
                 if (channel <= channels.length()) {
                     channels[channel - 1].valueGiven = true;
                     channels[channel - 1].value = value;
@@ -139,17 +138,16 @@ void FixtureChannelModel::setRawKey(const int raw) {
                 }
             }
         } else {
-            qWarning() << Q_FUNC_INFO << valueQuery.executedQuery() << valueQuery.lastError().text();
+            qWarning() << Q_FUNC_INFO << valueQuery->executedQuery() << valueQuery->lastError().text();
         }
 
-        QSqlQuery modelQuery;
-        modelQuery.prepare("SELECT key, value FROM raw_model_channel_values WHERE item_key = :raw AND foreignitem_key = :model");
-        modelQuery.bindValue(":raw", rawKey);
-        modelQuery.bindValue(":model", modelKey);
-        if (modelQuery.exec()) {
-            while (modelQuery.next()) {
-                const int channel = modelQuery.value(0).toInt();
-                const uint8_t value = modelQuery.value(1).toInt();
+        PreparedQuery modelQuery("SELECT key, value FROM raw_model_channel_values WHERE item_key = :raw AND foreignitem_key = :model");
+        modelQuery->bindValue(":raw", rawKey);
+        modelQuery->bindValue(":model", modelKey);
+        if (modelQuery->exec()) {
+            while (modelQuery->next()) {
+                const int channel = modelQuery->value(0).toInt();
+                const uint8_t value = modelQuery->value(1).toInt();
                 if (channel <= channels.length()) {
                     channels[channel - 1].modelValueGiven = true;
                     channels[channel - 1].modelValue = value;
@@ -157,24 +155,23 @@ void FixtureChannelModel::setRawKey(const int raw) {
                 }
             }
         } else {
-            qWarning() << Q_FUNC_INFO << modelQuery.executedQuery() << modelQuery.lastError().text();
+            qWarning() << Q_FUNC_INFO << modelQuery->executedQuery() << modelQuery->lastError().text();
         }
 
-        QSqlQuery fixtureQuery;
-        fixtureQuery.prepare("SELECT key, value FROM raw_fixture_channel_values WHERE item_key = :raw AND foreignitem_key = :fixture");
-        fixtureQuery.bindValue(":raw", rawKey);
-        fixtureQuery.bindValue(":fixture", fixtureKey);
-        if (fixtureQuery.exec()) {
-            while (fixtureQuery.next()) {
-                const int channel = fixtureQuery.value(0).toInt();
-                const uint8_t value = fixtureQuery.value(1).toInt();
+        PreparedQuery fixtureQuery("SELECT key, value FROM raw_fixture_channel_values WHERE item_key = :raw AND foreignitem_key = :fixture");
+        fixtureQuery->bindValue(":raw", rawKey);
+        fixtureQuery->bindValue(":fixture", fixtureKey);
+        if (fixtureQuery->exec()) {
+            while (fixtureQuery->next()) {
+                const int channel = fixtureQuery->value(0).toInt();
+                const uint8_t value = fixtureQuery->value(1).toInt();
                 if (channel <= channels.length()) {
                     channels[channel - 1].fixtureValueGiven = true;
                     channels[channel - 1].fixtureValue = value;
                 }
             }
         } else {
-            qWarning() << Q_FUNC_INFO << fixtureQuery.executedQuery() << fixtureQuery.lastError().text();
+            qWarning() << Q_FUNC_INFO << fixtureQuery->executedQuery() << fixtureQuery->lastError().text();
         }
     }
 
@@ -184,16 +181,16 @@ void FixtureChannelModel::setRawKey(const int raw) {
 void FixtureChannelModel::setChannelDifference(const int channel, int difference) {
     Q_ASSERT(channel <= channels.length());
     const ChannelData channelData = channels.at(channel - 1);
-    QSqlQuery query;
+    PreparedQuery query;
     if (channelData.fixtureValueGiven) {
         Q_ASSERT(fixtureKey >= 0);
         query.prepare("INSERT OR REPLACE INTO raw_fixture_channel_values (item_key, key, foreignitem_key, value) VALUES (:raw, :channel, :fixture, :value)");
-        query.bindValue(":fixture", fixtureKey);
+        query->bindValue(":fixture", fixtureKey);
         difference += channelData.fixtureValue;
     } else if (channelData.modelValueGiven) {
         Q_ASSERT(modelKey >= 0);
         query.prepare("INSERT OR REPLACE INTO raw_model_channel_values (item_key, key, foreignitem_key, value) VALUES (:raw, :channel, :model, :value)");
-        query.bindValue(":model", modelKey);
+        query->bindValue(":model", modelKey);
         difference += channelData.modelValue;
     } else if (channelData.valueGiven) {
         query.prepare("INSERT OR REPLACE INTO raw_channel_values (item_key, key, value) VALUES (:raw, :channel, :value)");
@@ -203,11 +200,11 @@ void FixtureChannelModel::setChannelDifference(const int channel, int difference
     }
     difference = std::min(difference, 255);
     difference = std::max(difference, 0);
-    query.bindValue(":value", difference);
-    query.bindValue(":raw", rawKey);
-    query.bindValue(":channel", channel);
-    if (!query.exec()) {
-        qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+    query->bindValue(":value", difference);
+    query->bindValue(":raw", rawKey);
+    query->bindValue(":channel", channel);
+    if (!query->exec()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
     }
     emit dbChanged();
 }
@@ -220,16 +217,16 @@ void FixtureChannelModel::updateButtons(const int channel, QPushButton* valueBut
     valueButton->setChecked(channelData.valueGiven);
     connect(valueButton, &QPushButton::clicked, this, [this, channel, valueButton] {
         Q_ASSERT(rawKey >= 0);
-        QSqlQuery query;
+        PreparedQuery query;
         if (valueButton->isChecked()) {
             query.prepare("INSERT OR REPLACE INTO raw_channel_values (item_key, key) VALUES (:raw, :channel)");
         } else {
             query.prepare("DELETE FROM raw_channel_values WHERE item_key = :raw AND key = :channel");
         }
-        query.bindValue(":raw", rawKey);
-        query.bindValue(":channel", channel);
-        if (!query.exec()) {
-            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+        query->bindValue(":raw", rawKey);
+        query->bindValue(":channel", channel);
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
         }
         emit dbChanged();
     });
@@ -239,17 +236,17 @@ void FixtureChannelModel::updateButtons(const int channel, QPushButton* valueBut
     connect(modelButton, &QPushButton::clicked, this, [this, channel, modelButton] {
         Q_ASSERT(rawKey >= 0);
         Q_ASSERT(modelKey >= 0);
-        QSqlQuery query;
+        PreparedQuery query;
         if (modelButton->isChecked()) {
             query.prepare("INSERT OR REPLACE INTO raw_model_channel_values (item_key, key, foreignitem_key) VALUES (:raw, :channel, :model)");
         } else {
             query.prepare("DELETE FROM raw_model_channel_values WHERE item_key = :raw AND foreignitem_key = :model AND key = :channel");
         }
-        query.bindValue(":model", modelKey);
-        query.bindValue(":raw", rawKey);
-        query.bindValue(":channel", channel);
-        if (!query.exec()) {
-            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+        query->bindValue(":model", modelKey);
+        query->bindValue(":raw", rawKey);
+        query->bindValue(":channel", channel);
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
         }
         emit dbChanged();
     });
@@ -259,17 +256,17 @@ void FixtureChannelModel::updateButtons(const int channel, QPushButton* valueBut
     connect(fixtureButton, &QPushButton::clicked, this, [this, channel, fixtureButton] {
         Q_ASSERT(rawKey >= 0);
         Q_ASSERT(fixtureKey >= 0);
-        QSqlQuery query;
+        PreparedQuery query;
         if (fixtureButton->isChecked()) {
             query.prepare("INSERT OR REPLACE INTO raw_fixture_channel_values (item_key, key, foreignitem_key) VALUES (:raw, :channel, :fixture)");
         } else {
             query.prepare("DELETE FROM raw_fixture_channel_values WHERE item_key = :raw AND foreignitem_key = :fixture AND key = :channel");
         }
-        query.bindValue(":fixture", fixtureKey);
-        query.bindValue(":raw", rawKey);
-        query.bindValue(":channel", channel);
-        if (!query.exec()) {
-            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+        query->bindValue(":fixture", fixtureKey);
+        query->bindValue(":raw", rawKey);
+        query->bindValue(":channel", channel);
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
         }
         emit dbChanged();
     });
@@ -12,6 +12,8 @@
 #include <QtWidgets>
 #include <QtSql>
 
+#include "database/preparedquery.h"
+
 class FixtureChannelModel : public QAbstractTableModel {
     Q_OBJECT
 public:
@@ -15,49 +15,48 @@ void CuelistTableModel::refresh() {
     rows.clear();
 
     int currentCueKey = -1;
-    QSqlQuery currentCueQuery;
-    if (currentCueQuery.exec("SELECT key FROM currentcue")) {
-        if (currentCueQuery.next()) {
-            currentCueKey = currentCueQuery.value(0).toInt();
+    PreparedQuery currentCueQuery("SELECT key FROM currentcue");
+    if (currentCueQuery->exec()) {
+        if (currentCueQuery->next()) {
+            currentCueKey = currentCueQuery->value(0).toInt();
         }
     } else {
-        qWarning() << Q_FUNC_INFO << currentCueQuery.executedQuery() << currentCueQuery.lastError().text();
+        qWarning() << Q_FUNC_INFO << currentCueQuery->executedQuery() << currentCueQuery->lastError().text();
     }
     int currentGroupKey = -1;
-    QSqlQuery currentGroupQuery;
-    if (currentGroupQuery.exec("SELECT group_key FROM currentitems")) {
-        if (currentGroupQuery.next()) {
-            currentGroupKey = currentGroupQuery.value(0).toInt();
+    PreparedQuery currentGroupQuery("SELECT group_key FROM currentitems");
+    if (currentGroupQuery->exec()) {
+        if (currentGroupQuery->next()) {
+            currentGroupKey = currentGroupQuery->value(0).toInt();
         }
     } else {
-        qWarning() << Q_FUNC_INFO << currentGroupQuery.executedQuery() << currentGroupQuery.lastError().text();
+        qWarning() << Q_FUNC_INFO << currentGroupQuery->executedQuery() << currentGroupQuery->lastError().text();
     }
     currentKey = -1;
     int lastCueKey = -1;
-    QSqlQuery rowQuery;
+    PreparedQuery rowQuery;
     if (mode == CueMode) {
         currentKey = currentGroupKey;
         rowQuery.prepare("SELECT key, CONCAT(id, ' ', label) FROM groups ORDER BY sortkey");
 
-        QSqlQuery lastCueKeyQuery;
-        lastCueKeyQuery.prepare("SELECT key FROM cues WHERE cuelist_key = (SELECT cuelist_key FROM cues WHERE key = :cue) AND sortkey = (SELECT MAX(sortkey) FROM cues WHERE sortkey < (SELECT sortkey FROM cues WHERE key = :cue) AND cuelist_key = (SELECT cuelist_key FROM cues WHERE key = :cue))");
-        lastCueKeyQuery.bindValue(":cue", currentCueKey);
-        if (lastCueKeyQuery.exec()) {
-            if (lastCueKeyQuery.next()) {
-                lastCueKey = lastCueKeyQuery.value(0).toInt();
+        PreparedQuery lastCueKeyQuery("SELECT key FROM cues WHERE cuelist_key = (SELECT cuelist_key FROM cues WHERE key = :cue) AND sortkey = (SELECT MAX(sortkey) FROM cues WHERE sortkey < (SELECT sortkey FROM cues WHERE key = :cue) AND cuelist_key = (SELECT cuelist_key FROM cues WHERE key = :cue))");
+        lastCueKeyQuery->bindValue(":cue", currentCueKey);
+        if (lastCueKeyQuery->exec()) {
+            if (lastCueKeyQuery->next()) {
+                lastCueKey = lastCueKeyQuery->value(0).toInt();
             }
         } else {
-            qWarning() << Q_FUNC_INFO << lastCueKeyQuery.executedQuery() << lastCueKeyQuery.lastError().text();
+            qWarning() << Q_FUNC_INFO << lastCueKeyQuery->executedQuery() << lastCueKeyQuery->lastError().text();
         }
     } else if (mode == GroupMode) {
         currentKey = currentCueKey;
         rowQuery.prepare("SELECT key, CONCAT(id, ' ', label) FROM currentcuelist_cues ORDER BY sortkey");
     }
-    if (rowQuery.exec()) {
-        while (rowQuery.next()) {
+    if (rowQuery->exec()) {
+        while (rowQuery->next()) {
             RowData row;
-            row.key = rowQuery.value(0).toInt();
-            row.name = rowQuery.value(1).toString();
+            row.key = rowQuery->value(0).toInt();
+            row.name = rowQuery->value(1).toString();
             int cueKey = currentCueKey;
             int groupKey = currentGroupKey;
             if (mode == CueMode) {
@@ -96,23 +95,22 @@ void CuelistTableModel::refresh() {
             }
         }
     } else {
-        qWarning() << Q_FUNC_INFO << rowQuery.executedQuery() << rowQuery.lastError().text();
+        qWarning() << Q_FUNC_INFO << rowQuery->executedQuery() << rowQuery->lastError().text();
     }
     endResetModel();
 }
 
 QStringList CuelistTableModel::getCueValue(const QString table, const QString valueTable, const int cueKey, const int groupKey) {
-    QSqlQuery query;
-    query.prepare("SELECT CONCAT(" + table + ".id, ' ', " + table + ".label) FROM " + valueTable + ", " + table + " WHERE " + valueTable + ".item_key = :cue AND " + valueTable + ".foreignitem_key = :group AND " + valueTable + ".valueitem_key = " + table + ".key ORDER BY " + table + ".sortkey");
-    query.bindValue(":cue", cueKey);
-    query.bindValue(":group", groupKey);
-    if (!query.exec()) {
-        qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+    PreparedQuery query("SELECT CONCAT(" + table + ".id, ' ', " + table + ".label) FROM " + valueTable + ", " + table + " WHERE " + valueTable + ".item_key = :cue AND " + valueTable + ".foreignitem_key = :group AND " + valueTable + ".valueitem_key = " + table + ".key ORDER BY " + table + ".sortkey");
+    query->bindValue(":cue", cueKey);
+    query->bindValue(":group", groupKey);
+    if (!query->exec()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
         return QStringList();
     }
     QStringList values;
-    while (query.next()) {
-        values.append(query.value(0).toString());
+    while (query->next()) {
+        values.append(query->value(0).toString());
     }
     return values;
 }
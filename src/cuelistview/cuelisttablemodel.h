@@ -12,6 +12,8 @@
 #include <QtWidgets>
 #include <QtSql>
 
+#include "database/preparedquery.h"
+
 class CuelistTableModel : public QAbstractTableModel {
     Q_OBJECT
 public:
@@ -143,7 +143,7 @@ void CuelistView::selectItem(const QString table, const QString currentSortkeyQu
         } else {
             keyQuery.prepare("SELECT key FROM " + table + " WHERE sortkey = (SELECT MAX(sortkey) FROM " + table + " WHERE sortkey < :sortkey)");
         }
-        keyQuery.bindValue(":sortkey", currentSortkeyQuery.value(0).toInt());
+        keyQuery.bindValue(":sortkey", currentSortkeyQuery.value(0).toLongLong());
     } else {
         keyQuery.prepare("SELECT key FROM " + table + " WHERE sortkey = (SELECT MIN(sortkey) FROM " + table + ")");
     }
@@ -0,0 +1,164 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "checkpointthread.h"
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+CheckpointThread::CheckpointThread(QObject* parent) : QThread(parent) {}
+
+CheckpointThread::~CheckpointThread() {
+    stop();
+    wait();
+}
+
+bool CheckpointThread::write(const QByteArray& snapshot, const QString& fileName, const QString& journalFileName) {
+    QMutexLocker locker(&mutex);
+    if (busy || stopping) {
+        return false;
+    }
+    pendingSnapshot = snapshot;
+    pendingFileName = fileName;
+    pendingJournalFileName = journalFileName;
+    busy = true;
+    condition.wakeAll();
+    return true;
+}
+
+void CheckpointThread::setJournal(const int fileDescriptor, const int syncInterval) {
+    QMutexLocker locker(&mutex);
+#ifdef Q_OS_UNIX
+    // The thread keeps its own descriptor, so the main thread can close and rename the journal at any time
+    if (nextJournalDescriptor >= 0) {
+        ::close(nextJournalDescriptor);
+    }
+    nextJournalDescriptor = (fileDescriptor >= 0) ? ::dup(fileDescriptor) : -1;
+#else
+    Q_UNUSED(fileDescriptor)
+#endif
+    journalSyncInterval = syncInterval;
+    journalReplaced = true;
+    condition.wakeAll();
+}
+
+void CheckpointThread::syncJournal() {
+    QMutexLocker locker(&mutex);
+    if (!journalDirty) {
+        // Edits are synced together, so they only wait for the disk once per interval
+        journalDirty = true;
+        journalSyncDeadline = QDeadlineTimer(journalSyncInterval);
+        condition.wakeAll();
+    }
+}
+
+bool CheckpointThread::isBusy() {
+    QMutexLocker locker(&mutex);
+    return busy;
+}
+
+bool CheckpointThread::waitForIdle() {
+    QMutexLocker locker(&mutex);
+    while (busy && isRunning()) {
+        condition.wait(&mutex);
+    }
+    return lastWriteSucceeded;
+}
+
+void CheckpointThread::stop() {
+    QMutexLocker locker(&mutex);
+    stopping = true;
+    condition.wakeAll();
+}
+
+void CheckpointThread::run() {
+    QMutexLocker locker(&mutex);
+    while (true) {
+        while (!busy && !stopping && !journalReplaced && !(journalDirty && journalSyncDeadline.hasExpired())) {
+            if (journalDirty) {
+                condition.wait(&mutex, journalSyncDeadline);
+            } else {
+                condition.wait(&mutex);
+            }
+        }
+        while ((journalDirty && (journalSyncDeadline.hasExpired() || stopping)) || journalReplaced) {
+            syncJournalDescriptor(&locker);
+        }
+        if (!busy) {
+            if (stopping) {
+#ifdef Q_OS_UNIX
+                if (journalDescriptor >= 0) {
+                    ::close(journalDescriptor);
+                    journalDescriptor = -1;
+                }
+#endif
+                return;
+            }
+            continue;
+        }
+        const QByteArray snapshot = pendingSnapshot;
+        const QString fileName = pendingFileName;
+        const QString journalFileName = pendingJournalFileName;
+        locker.unlock();
+
+        QElapsedTimer writeTimer;
+        writeTimer.start();
+        // QSaveFile writes to a temporary file and renames it, so the file on disk is never half written
+        QSaveFile file(fileName);
+        bool success = file.open(QIODevice::WriteOnly);
+        success = success && (file.write(snapshot) == snapshot.size());
+        success = success && file.commit();
+        if (success) {
+            // The snapshot contains all journaled edits up to the checkpoint
+            QFile::remove(journalFileName);
+        } else {
+            qWarning() << Q_FUNC_INFO << "Failed to write" << fileName << file.errorString();
+        }
+        emit checkpointWritten(success, writeTimer.nsecsElapsed(), snapshot.size());
+
+        locker.relock();
+        pendingSnapshot.clear();
+        lastWriteSucceeded = success;
+        busy = false;
+        condition.wakeAll();
+    }
+}
+
+void CheckpointThread::syncJournalDescriptor(QMutexLocker<QMutex>* locker) {
+    const int descriptor = journalDescriptor;
+    const bool replaced = journalReplaced;
+    if (replaced) {
+        // The old journal is synced a last time, edits in the new journal are synced after the next interval
+        journalDescriptor = nextJournalDescriptor;
+        nextJournalDescriptor = -1;
+        journalReplaced = false;
+    } else {
+        journalDirty = false;
+    }
+    locker->unlock();
+#ifdef Q_OS_UNIX
+    if (descriptor >= 0) {
+#ifdef Q_OS_LINUX
+        const int result = ::fdatasync(descriptor);
+#else
+        const int result = ::fsync(descriptor);
+#endif
+        if (result != 0) {
+            qWarning() << Q_FUNC_INFO << "Failed to sync the journal:" << qt_error_string(errno);
+        }
+        if (replaced) {
+            ::close(descriptor);
+        }
+    }
+#else
+    Q_UNUSED(descriptor)
+    Q_UNUSED(replaced)
+#endif
+    locker->relock();
+}
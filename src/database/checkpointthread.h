@@ -0,0 +1,48 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef CHECKPOINTTHREAD_H
+#define CHECKPOINTTHREAD_H
+
+#include <QtCore>
+
+// Writes database snapshots to disk and syncs the journal without blocking the main thread
+class CheckpointThread : public QThread {
+    Q_OBJECT
+public:
+    CheckpointThread(QObject* parent = nullptr);
+    ~CheckpointThread();
+    bool write(const QByteArray& snapshot, const QString& fileName, const QString& journalFileName);
+    void setJournal(int fileDescriptor, int syncInterval);
+    void syncJournal();
+    bool isBusy();
+    bool waitForIdle();
+    void stop();
+signals:
+    void checkpointWritten(bool success, qint64 writeTime, qint64 size);
+protected:
+    void run() override;
+private:
+    QMutex mutex;
+    QWaitCondition condition;
+    QByteArray pendingSnapshot;
+    QString pendingFileName;
+    QString pendingJournalFileName;
+    bool busy = false;
+    bool stopping = false;
+    bool lastWriteSucceeded = true;
+    int journalDescriptor = -1;
+    int nextJournalDescriptor = -1;
+    bool journalReplaced = false;
+    bool journalDirty = false;
+    int journalSyncInterval = 100;
+    QDeadlineTimer journalSyncDeadline;
+    void syncJournalDescriptor(QMutexLocker<QMutex>* locker);
+};
+
+#endif // CHECKPOINTTHREAD_H
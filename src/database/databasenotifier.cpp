@@ -0,0 +1,112 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "databasenotifier.h"
+
+DatabaseNotifier::DatabaseNotifier(QObject* parent) : QObject(parent) {}
+
+bool DatabaseNotifier::start() {
+    QSqlQuery tableQuery;
+    if (!tableQuery.exec("SELECT name FROM main.sqlite_master WHERE type = 'table' AND name NOT LIKE 'sqlite_%'")) {
+        qWarning() << Q_FUNC_INFO << tableQuery.executedQuery() << tableQuery.lastError().text();
+        return false;
+    }
+    QStringList queries;
+    // Temporary tables and triggers aren't saved in the file and roll back with the transaction that changed the rows
+    queries.append("CREATE TEMP TABLE IF NOT EXISTS notifier_changes (tablename TEXT NOT NULL, operation INTEGER NOT NULL, row INTEGER NOT NULL)");
+    while (tableQuery.next()) {
+        const QString table = tableQuery.value(0).toString();
+        queries.append("CREATE TEMP TRIGGER IF NOT EXISTS " + table + "_insert_notification AFTER INSERT ON main." + table + " BEGIN INSERT INTO notifier_changes (tablename, operation, row) VALUES ('" + table + "', " + QString::number(Insert) + ", NEW.rowid); END");
+        queries.append("CREATE TEMP TRIGGER IF NOT EXISTS " + table + "_update_notification AFTER UPDATE ON main." + table + " BEGIN INSERT INTO notifier_changes (tablename, operation, row) VALUES ('" + table + "', " + QString::number(Update) + ", NEW.rowid); END");
+        queries.append("CREATE TEMP TRIGGER IF NOT EXISTS " + table + "_delete_notification AFTER DELETE ON main." + table + " BEGIN INSERT INTO notifier_changes (tablename, operation, row) VALUES ('" + table + "', " + QString::number(Delete) + ", OLD.rowid); END");
+    }
+    for (const QString& queryText : queries) {
+        QSqlQuery query;
+        if (!query.exec(queryText)) {
+            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+            return false;
+        }
+    }
+    active = true;
+    return true;
+}
+
+bool DatabaseNotifier::isActive() const {
+    return active;
+}
+
+void DatabaseNotifier::subscribe(const QStringList& tables, const QObject* context, const std::function<void()>& callback) {
+    Subscription subscription;
+    subscription.tables = QSet<QString>(tables.begin(), tables.end());
+    subscription.context = context;
+    subscription.callback = callback;
+    subscriptions.append(subscription);
+}
+
+void DatabaseNotifier::collect() {
+    if (!active) {
+        return;
+    }
+    QList<Change> changes;
+    qint64 lastRow = 0;
+    {
+        PreparedQuery query("SELECT rowid, tablename, operation, row FROM temp.notifier_changes ORDER BY rowid");
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+            return;
+        }
+        while (query->next()) {
+            lastRow = query->value(0).toLongLong();
+            Change change;
+            change.table = query->value(1).toString();
+            change.operation = static_cast<Operation>(query->value(2).toInt());
+            change.rowId = query->value(3).toLongLong();
+            changes.append(change);
+        }
+    }
+    if (changes.isEmpty()) {
+        return;
+    }
+    PreparedQuery deleteQuery("DELETE FROM temp.notifier_changes WHERE rowid <= :row");
+    deleteQuery->bindValue(":row", lastRow);
+    if (!deleteQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << deleteQuery->executedQuery() << deleteQuery->lastError().text();
+    }
+    for (const Change& change : changes) {
+        pendingChanges.append(change);
+        emit rowChanged(change);
+    }
+}
+
+void DatabaseNotifier::schedulePublish() {
+    if (!publishScheduled) {
+        publishScheduled = true;
+        QMetaObject::invokeMethod(this, &DatabaseNotifier::publish, Qt::QueuedConnection);
+    }
+}
+
+void DatabaseNotifier::publish() {
+    // Called outside of transactions, changes of rolled back transactions that were collected before only cause another reload
+    publishScheduled = false;
+    collect();
+    if (pendingChanges.isEmpty()) {
+        return;
+    }
+    const QList<Change> changes = pendingChanges;
+    pendingChanges.clear();
+    QSet<QString> changedTables;
+    for (const Change& change : changes) {
+        changedTables.insert(change.table);
+    }
+    emit transactionCommitted(changes);
+    for (const Subscription& subscription : subscriptions) {
+        if (!subscription.context.isNull() && subscription.tables.intersects(changedTables)) {
+            subscription.callback();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DATABASENOTIFIER_H
+#define DATABASENOTIFIER_H
+
+#include <QtCore>
+#include <QtSql>
+#include <functional>
+
+#include "database/preparedquery.h"
+
+// Collects the rows changed in the database with temporary triggers, so views only reload if a table they show has changed
+class DatabaseNotifier : public QObject {
+    Q_OBJECT
+public:
+    enum Operation {
+        Insert,
+        Update,
+        Delete,
+    };
+    struct Change {
+        QString table;
+        Operation operation;
+        qint64 rowId;
+    };
+    DatabaseNotifier(QObject* parent = nullptr);
+    bool start();
+    bool isActive() const;
+    void subscribe(const QStringList& tables, const QObject* context, const std::function<void()>& callback);
+    void collect();
+public slots:
+    void publish();
+    void schedulePublish();
+signals:
+    void rowChanged(const DatabaseNotifier::Change& change); // Also emitted for changes of the current transaction
+    void transactionCommitted(const QList<DatabaseNotifier::Change>& changes);
+private:
+    struct Subscription {
+        QSet<QString> tables;
+        QPointer<const QObject> context;
+        std::function<void()> callback;
+    };
+    bool active = false;
+    QList<Change> pendingChanges;
+    bool publishScheduled = false;
+    QList<Subscription> subscriptions;
+};
+
+#endif // DATABASENOTIFIER_H
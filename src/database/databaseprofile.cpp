@@ -0,0 +1,62 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "databaseprofile.h"
+
+QMap<QString, DatabaseProfile::Pragmas> DatabaseProfile::getProfiles() {
+    QMap<QString, Pragmas> profiles;
+    // SQLite defaults: rollback journal and a full sync on every commit
+    profiles["safe"] = {"DELETE", "FULL", 0, -2000, "DEFAULT"};
+    // WAL only syncs on checkpoints, commits can only be lost on power failure
+    profiles["balanced"] = {"WAL", "NORMAL", 64 * 1024 * 1024, -16384, "MEMORY"};
+    // Never syncs, an operating system crash or power failure can corrupt the file
+    profiles["performance"] = {"WAL", "OFF", 256 * 1024 * 1024, -65536, "MEMORY"};
+    return profiles;
+}
+
+QStringList DatabaseProfile::getNames() {
+    return getProfiles().keys();
+}
+
+bool DatabaseProfile::contains(const QString name) {
+    return getProfiles().contains(name);
+}
+
+QString DatabaseProfile::getDefaultName() {
+    return "balanced";
+}
+
+bool DatabaseProfile::apply(QSqlDatabase database, const QString name) {
+    if (!contains(name)) {
+        qWarning() << Q_FUNC_INFO << "Unknown database profile" << name;
+        return false;
+    }
+    const Pragmas pragmas = getProfiles().value(name);
+    QSqlQuery journalModeQuery(database);
+    if (!journalModeQuery.exec("PRAGMA journal_mode = " + pragmas.journalMode)) {
+        qWarning() << Q_FUNC_INFO << journalModeQuery.executedQuery() << journalModeQuery.lastError().text();
+        return false;
+    }
+    // SQLite keeps the old journal mode if the new one isn't possible (e.g. WAL on network file systems)
+    if (!journalModeQuery.next() || (journalModeQuery.value(0).toString().toUpper() != pragmas.journalMode)) {
+        qWarning() << Q_FUNC_INFO << "Failed to set journal mode" << pragmas.journalMode << "for database profile" << name;
+    }
+    QStringList queries;
+    queries.append("PRAGMA synchronous = " + pragmas.synchronous);
+    queries.append("PRAGMA mmap_size = " + QString::number(pragmas.mmapSize));
+    queries.append("PRAGMA cache_size = " + QString::number(pragmas.cacheSize));
+    queries.append("PRAGMA temp_store = " + pragmas.tempStore);
+    for (const QString queryText : queries) {
+        QSqlQuery query(database);
+        if (!query.exec(queryText)) {
+            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,31 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DATABASEPROFILE_H
+#define DATABASEPROFILE_H
+
+#include <QtSql>
+
+class DatabaseProfile {
+public:
+    static QStringList getNames();
+    static bool contains(QString name);
+    static bool apply(QSqlDatabase database, QString name);
+    static QString getDefaultName();
+private:
+    struct Pragmas {
+        QString journalMode;
+        QString synchronous;
+        qint64 mmapSize;
+        int cacheSize; // negative values are KiB
+        QString tempStore;
+    };
+    static QMap<QString, Pragmas> getProfiles();
+};
+
+#endif // DATABASEPROFILE_H
@@ -0,0 +1,269 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "itemindex.h"
+
+namespace {
+struct Source {
+    QString itemTable;
+    QString memberTable;
+    QString selectionQuery;
+};
+// The table whose row IDs are the item keys, the table that decides which items are part of a view and the current item the view belongs to
+const QHash<QString, Source> sources = {
+    {"models", {"models", QString(), QString()}},
+    {"fixtures", {"fixtures", QString(), QString()}},
+    {"groups", {"groups", QString(), QString()}},
+    {"intensities", {"intensities", QString(), QString()}},
+    {"colors", {"colors", QString(), QString()}},
+    {"positions", {"positions", QString(), QString()}},
+    {"raws", {"raws", QString(), QString()}},
+    {"effects", {"effects", QString(), QString()}},
+    {"cuelists", {"cuelists", QString(), QString()}},
+    {"currentcuelist_cues", {"cues", QString(), "SELECT cuelist_key FROM currentitems"}},
+    {"currentgroup_fixtures", {"fixtures", "group_fixtures", "SELECT group_key FROM currentitems"}},
+};
+}
+
+void ItemIndex::setDatabaseNotifier(DatabaseNotifier* notifier) {
+    Index* index = getIndex();
+    index->tables.clear();
+    index->notifier = notifier->isActive() ? notifier : nullptr;
+    if (index->notifier == nullptr) {
+        return;
+    }
+    QObject::connect(notifier, &DatabaseNotifier::rowChanged, notifier, [] (const DatabaseNotifier::Change& change) {
+        invalidate(change);
+    });
+    QObject::connect(notifier, &QObject::destroyed, [] {
+        getIndex()->notifier = nullptr;
+        getIndex()->tables.clear();
+    });
+}
+
+void ItemIndex::invalidateAll() {
+    for (Table& items : getIndex()->tables) {
+        items.loaded = false;
+    }
+}
+
+int ItemIndex::getKey(const QString& table, const QString& id, bool* ok) {
+    return getKeys(table, {id}, ok).value(id, -1);
+}
+
+QHash<QString, int> ItemIndex::getKeys(const QString& table, const QStringList& ids, bool* ok) {
+    QHash<QString, int> keys;
+    Table* items = getTable(table, ok);
+    if (!*ok) {
+        return keys;
+    }
+    if (items != nullptr) {
+        for (const QString& id : ids) {
+            if (items->keys.contains(id)) {
+                keys[id] = items->keys.value(id);
+            }
+        }
+        return keys;
+    }
+    PreparedQuery query("SELECT key FROM " + table + " WHERE id = :id");
+    for (const QString& id : ids) {
+        query->bindValue(":id", id);
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+            *ok = false;
+            return keys;
+        }
+        if (query->next()) {
+            keys[id] = query->value(0).toInt();
+        }
+    }
+    return keys;
+}
+
+QString ItemIndex::getId(const QString& table, const int key, bool* ok) {
+    Table* items = getTable(table, ok);
+    if (!*ok) {
+        return QString();
+    }
+    if (items != nullptr) {
+        return items->items.value(key).id;
+    }
+    PreparedQuery query("SELECT id FROM " + table + " WHERE key = :key");
+    query->bindValue(":key", key);
+    if (!query->exec()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+        *ok = false;
+        return QString();
+    }
+    if (!query->next()) {
+        return QString();
+    }
+    return query->value(0).toString();
+}
+
+int ItemIndex::getRow(const QString& table, const QString& id, bool* ok) {
+    Table* items = getTable(table, ok);
+    if (!*ok) {
+        return -1;
+    }
+    if (items != nullptr) {
+        if (!items->keys.contains(id)) {
+            return -1;
+        }
+        const qint64 sortkey = items->items.value(items->keys.value(id)).sortkey;
+        int row = 0;
+        for (const Item& item : items->items) {
+            if (item.sortkey < sortkey) {
+                row++;
+            }
+        }
+        return row;
+    }
+    PreparedQuery query("SELECT (SELECT COUNT(*) FROM " + table + " WHERE sortkey < item.sortkey) FROM " + table + " AS item WHERE item.id = :id");
+    query->bindValue(":id", id);
+    if (!query->exec()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+        *ok = false;
+        return -1;
+    }
+    if (!query->next()) {
+        return -1;
+    }
+    return query->value(0).toInt();
+}
+
+ItemIndex::Index* ItemIndex::getIndex() {
+    static Index* index = new Index();
+    return index;
+}
+
+ItemIndex::Table* ItemIndex::getTable(const QString& table, bool* ok) {
+    *ok = true;
+    Index* index = getIndex();
+    if ((index->notifier == nullptr) || !sources.contains(table)) {
+        return nullptr;
+    }
+    // Changes of the current transaction are read as well, rolled back transactions have to call invalidateAll()
+    index->notifier->collect();
+    const Source source = sources.value(table);
+    Table* items = &index->tables[table];
+    if (items->loaded && items->selectionChanged) {
+        // Only selecting another Cuelist or Group replaces all items of a view
+        items->selectionChanged = false;
+        PreparedQuery selectionQuery(source.selectionQuery);
+        if (!selectionQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << selectionQuery->executedQuery() << selectionQuery->lastError().text();
+            items->loaded = false;
+            *ok = false;
+            return nullptr;
+        }
+        if (!selectionQuery->next() || (selectionQuery->value(0) != items->selection)) {
+            items->loaded = false;
+        }
+    }
+    // Reading the changed rows one by one only pays off for a few rows
+    if (items->loaded && (items->changedKeys.size() > (items->items.size() / 4))) {
+        items->loaded = false;
+    }
+    if (!items->loaded) {
+        items->items.clear();
+        items->keys.clear();
+        items->changedKeys.clear();
+        items->membersChanged = false;
+        items->selectionChanged = false;
+        if (!source.selectionQuery.isEmpty()) {
+            PreparedQuery selectionQuery(source.selectionQuery);
+            if (!selectionQuery->exec()) {
+                qWarning() << Q_FUNC_INFO << selectionQuery->executedQuery() << selectionQuery->lastError().text();
+                *ok = false;
+                return nullptr;
+            }
+            items->selection = selectionQuery->next() ? selectionQuery->value(0) : QVariant();
+        }
+        PreparedQuery query("SELECT key, id, sortkey FROM " + table);
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+            *ok = false;
+            return nullptr;
+        }
+        while (query->next()) {
+            const int key = query->value(0).toInt();
+            const QString id = query->value(1).toString();
+            items->items[key] = {id, query->value(2).toLongLong()};
+            items->keys[id] = key;
+        }
+        items->loaded = true;
+        return items;
+    }
+    if (items->membersChanged) {
+        // Items that were added to or removed from the view are read like changed items
+        items->membersChanged = false;
+        QSet<int> memberKeys;
+        PreparedQuery memberQuery("SELECT key FROM " + table);
+        if (!memberQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << memberQuery->executedQuery() << memberQuery->lastError().text();
+            items->loaded = false;
+            *ok = false;
+            return nullptr;
+        }
+        while (memberQuery->next()) {
+            memberKeys.insert(memberQuery->value(0).toInt());
+        }
+        for (auto item = items->items.cbegin(); item != items->items.cend(); item++) {
+            if (!memberKeys.contains(item.key())) {
+                items->changedKeys.insert(item.key());
+            }
+        }
+        for (const int key : memberKeys) {
+            if (!items->items.contains(key)) {
+                items->changedKeys.insert(key);
+            }
+        }
+    }
+    const QSet<int> changedKeys = items->changedKeys;
+    items->changedKeys.clear();
+    for (const int key : changedKeys) {
+        if (items->items.contains(key)) {
+            const QString oldId = items->items.take(key).id;
+            if (items->keys.value(oldId) == key) {
+                items->keys.remove(oldId);
+            }
+        }
+        PreparedQuery query("SELECT id, sortkey FROM " + table + " WHERE key = :key");
+        query->bindValue(":key", key);
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+            items->loaded = false;
+            *ok = false;
+            return nullptr;
+        }
+        if (query->next()) {
+            const QString id = query->value(0).toString();
+            items->items[key] = {id, query->value(1).toLongLong()};
+            items->keys[id] = key;
+        }
+    }
+    return items;
+}
+
+void ItemIndex::invalidate(const DatabaseNotifier::Change& change) {
+    Index* index = getIndex();
+    for (auto items = index->tables.begin(); items != index->tables.end(); items++) {
+        if (!items->loaded) {
+            continue;
+        }
+        const Source source = sources.value(items.key());
+        if (change.table == source.itemTable) {
+            items->changedKeys.insert(static_cast<int>(change.rowId));
+        } else if (change.table == source.memberTable) {
+            items->membersChanged = true;
+        } else if (!source.selectionQuery.isEmpty() && (change.table == "currentitems")) {
+            items->selectionChanged = true;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ITEMINDEX_H
+#define ITEMINDEX_H
+
+#include <QtCore>
+#include <QtSql>
+
+#include "database/databasenotifier.h"
+#include "database/preparedquery.h"
+
+// Keeps the ID, key and sorting key of all items in memory, so IDs are resolved without a query per ID
+class ItemIndex {
+public:
+    static void setDatabaseNotifier(DatabaseNotifier* notifier);
+    static void invalidateAll();
+    static int getKey(const QString& table, const QString& id, bool* ok);
+    static QHash<QString, int> getKeys(const QString& table, const QStringList& ids, bool* ok);
+    static QString getId(const QString& table, int key, bool* ok);
+    static int getRow(const QString& table, const QString& id, bool* ok);
+private:
+    struct Item {
+        QString id;
+        qint64 sortkey;
+    };
+    struct Table {
+        bool loaded = false;
+        QHash<int, Item> items;
+        QHash<QString, int> keys;
+        QSet<int> changedKeys;
+        bool membersChanged = false;
+        bool selectionChanged = false;
+        QVariant selection;
+    };
+    struct Index {
+        DatabaseNotifier* notifier = nullptr;
+        QHash<QString, Table> tables;
+    };
+    static Index* getIndex();
+    static Table* getTable(const QString& table, bool* ok);
+    static void invalidate(const DatabaseNotifier::Change& change);
+};
+
+#endif // ITEMINDEX_H
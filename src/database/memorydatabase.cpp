@@ -0,0 +1,444 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "memorydatabase.h"
+
+#ifdef ZOEGLFREX_SQLITE_API
+#include <sqlite3.h>
+#ifdef Q_OS_UNIX
+#include <dlfcn.h>
+#endif
+
+static bool usesLinkedSqlite(QSqlDatabase database) {
+#ifdef Q_OS_UNIX
+    // Qt's driver may bundle its own copy of SQLite, whose connections must never be passed to the library Zöglfrex links
+    Dl_info driverInfo;
+    if ((database.driver() == nullptr) || (dladdr(database.driver()->metaObject(), &driverInfo) == 0) || (driverInfo.dli_fname == nullptr)) {
+        return false;
+    }
+    void* driverLibrary = dlopen(driverInfo.dli_fname, RTLD_LAZY | RTLD_NOLOAD);
+    if (driverLibrary == nullptr) {
+        return false;
+    }
+    // Every copy of SQLite returns its own version string, so the strings are only the same if the driver uses the linked library
+    const auto driverVersion = reinterpret_cast<const char* (*)()>(dlsym(driverLibrary, "sqlite3_libversion"));
+    const bool linked = (driverVersion != nullptr) && (driverVersion() == sqlite3_libversion());
+    dlclose(driverLibrary);
+    return linked;
+#else
+    Q_UNUSED(database)
+    return false;
+#endif
+}
+
+static sqlite3* getSqliteHandle(QSqlDatabase database) {
+    if (!usesLinkedSqlite(database)) {
+        return nullptr;
+    }
+    const QVariant handle = database.driver()->handle();
+    if (!handle.isValid() || (qstrcmp(handle.typeName(), "sqlite3*") != 0)) {
+        return nullptr;
+    }
+    return *static_cast<sqlite3* const*>(handle.data());
+}
+#endif
+
+static const char* getTransactionKeyword(const char* queryText) {
+    while ((*queryText == ' ') || (*queryText == '\n') || (*queryText == '\t')) {
+        queryText++;
+    }
+    for (const char* keyword : {"BEGIN", "COMMIT", "END", "ROLLBACK"}) {
+        const uint length = qstrlen(keyword);
+        if ((qstrnicmp(queryText, keyword, length) == 0) && ((queryText[length] == '\0') || (queryText[length] == ' ') || (queryText[length] == ';'))) {
+            return keyword;
+        }
+    }
+    return nullptr;
+}
+
+static bool isTemporaryStatement(const char* queryText) {
+    while ((*queryText == ' ') || (*queryText == '\n') || (*queryText == '\t')) {
+        queryText++;
+    }
+    for (const char* prefix : {"INSERT INTO temp.", "DELETE FROM temp.", "UPDATE temp."}) {
+        if (qstrnicmp(queryText, prefix, qstrlen(prefix)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+MemoryDatabase::MemoryDatabase(QSqlDatabase memoryDatabase, const QString& file, QObject* parent) : QObject(parent) {
+    database = memoryDatabase;
+    fileName = file;
+    checkpointThread = new CheckpointThread(this);
+    connect(checkpointThread, &CheckpointThread::checkpointWritten, this, &MemoryDatabase::finishCheckpoint);
+    QSettings settings("Zoeglfrex");
+    checkpointEdits = settings.value("database/checkpointedits", 500).toInt();
+    journalSyncInterval = settings.value("database/journalsyncinterval", 100).toInt();
+    checkpointTimer = new QTimer(this);
+    checkpointTimer->setInterval(settings.value("database/checkpointinterval", 60).toInt() * 1000);
+    connect(checkpointTimer, &QTimer::timeout, this, &MemoryDatabase::checkpoint);
+    journalStream.setVersion(QDataStream::Qt_6_0);
+}
+
+MemoryDatabase::~MemoryDatabase() {
+    close();
+}
+
+bool MemoryDatabase::isAvailable(QSqlDatabase database) {
+#ifdef ZOEGLFREX_SQLITE_API
+    return usesLinkedSqlite(database);
+#else
+    Q_UNUSED(database)
+    return false;
+#endif
+}
+
+bool MemoryDatabase::load(QSqlDatabase memoryDatabase, const QString& file) {
+#ifdef ZOEGLFREX_SQLITE_API
+    sqlite3* memoryHandle = getSqliteHandle(memoryDatabase);
+    if (memoryHandle == nullptr) {
+        qWarning() << Q_FUNC_INFO << "Failed to access the SQLite connection.";
+        return false;
+    }
+    const QString connectionName = "zoeglfrex-load";
+    bool success = false;
+    {
+        QSqlDatabase fileDatabase = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        fileDatabase.setDatabaseName(file);
+        if (!fileDatabase.open()) {
+            qWarning() << Q_FUNC_INFO << "Failed to open" << file << fileDatabase.lastError().text();
+        } else {
+            sqlite3* fileHandle = getSqliteHandle(fileDatabase);
+            sqlite3_backup* backup = (fileHandle != nullptr) ? sqlite3_backup_init(memoryHandle, "main", fileHandle, "main") : nullptr;
+            if (backup == nullptr) {
+                qWarning() << Q_FUNC_INFO << "Failed to start loading" << file << sqlite3_errmsg(memoryHandle);
+            } else {
+                const int result = sqlite3_backup_step(backup, -1);
+                success = (sqlite3_backup_finish(backup) == SQLITE_OK) && (result == SQLITE_DONE);
+                if (!success) {
+                    qWarning() << Q_FUNC_INFO << "Failed to load" << file << sqlite3_errstr(result);
+                }
+            }
+            fileDatabase.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return success;
+#else
+    Q_UNUSED(memoryDatabase)
+    Q_UNUSED(file)
+    return false;
+#endif
+}
+
+int MemoryDatabase::replayJournals(QSqlDatabase database, const QString& file) {
+    int entries = 0;
+    int failedEntries = 0;
+    bool transaction = false;
+    for (const QString journalFileName : {getOldJournalFileName(file), getJournalFileName(file)}) {
+        QFile journalFile(journalFileName);
+        if (!journalFile.exists()) {
+            continue;
+        }
+        if (!journalFile.open(QIODevice::ReadOnly)) {
+            qWarning() << Q_FUNC_INFO << "Failed to open" << journalFileName << journalFile.errorString();
+            continue;
+        }
+        QDataStream stream(&journalFile);
+        stream.setVersion(QDataStream::Qt_6_0);
+        while (!stream.atEnd()) {
+            QString queryText;
+            stream >> queryText;
+            if (stream.status() != QDataStream::Ok) {
+                // The last entry may be incomplete if Zöglfrex crashed while writing it
+                qWarning() << Q_FUNC_INFO << "Stopped reading" << journalFileName << "at an incomplete entry.";
+                break;
+            }
+            QSqlQuery query(database);
+            if (query.exec(queryText)) {
+                const char* keyword = getTransactionKeyword(queryText.toUtf8().constData());
+                if (keyword != nullptr) {
+                    transaction = (qstrcmp(keyword, "BEGIN") == 0);
+                }
+            } else {
+                failedEntries++;
+            }
+            entries++;
+        }
+    }
+    if (transaction) {
+        // Discard the edit that was running when Zöglfrex stopped
+        QSqlQuery rollbackQuery(database);
+        rollbackQuery.exec("ROLLBACK");
+    }
+    if (failedEntries > 0) {
+        qWarning() << Q_FUNC_INFO << failedEntries << "of" << entries << "journaled edits failed.";
+    }
+    return entries;
+}
+
+void MemoryDatabase::removeJournals(const QString& file) {
+    QFile::remove(getOldJournalFileName(file));
+    QFile::remove(getJournalFileName(file));
+}
+
+MemoryDatabase::Statistics MemoryDatabase::takeStatistics() {
+    Statistics* statistics = getStatistics();
+    const Statistics result = *statistics;
+    statistics->journalEntries = 0;
+    return result;
+}
+
+bool MemoryDatabase::start() {
+#ifdef ZOEGLFREX_SQLITE_API
+    handle = getSqliteHandle(database);
+    if (handle == nullptr) {
+        qWarning() << Q_FUNC_INFO << "Failed to access the SQLite connection.";
+        return false;
+    }
+    checkpointThread->start();
+    // Save the loaded file (including migrations and recovered edits) before journaling new edits
+    journal.setFileName(getJournalFileName(fileName));
+    if (!checkpoint() || !checkpointThread->waitForIdle()) {
+        return false;
+    }
+    sqlite3_trace_v2(static_cast<sqlite3*>(handle), SQLITE_TRACE_PROFILE, &MemoryDatabase::traceStatement, this);
+    sqlite3_commit_hook(static_cast<sqlite3*>(handle), &MemoryDatabase::commitTransaction, this);
+    sqlite3_rollback_hook(static_cast<sqlite3*>(handle), &MemoryDatabase::rollbackTransaction, this);
+    checkpointTimer->start();
+    getStatistics()->active = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MemoryDatabase::close() {
+#ifdef ZOEGLFREX_SQLITE_API
+    if (handle == nullptr) {
+        return true;
+    }
+    checkpointTimer->stop();
+    sqlite3_trace_v2(static_cast<sqlite3*>(handle), 0, nullptr, nullptr);
+    sqlite3_commit_hook(static_cast<sqlite3*>(handle), nullptr, nullptr);
+    sqlite3_rollback_hook(static_cast<sqlite3*>(handle), nullptr, nullptr);
+    checkpointThread->waitForIdle();
+    bool success = checkpoint() && checkpointThread->waitForIdle();
+    checkpointThread->stop();
+    checkpointThread->wait();
+    journal.close();
+    if (success) {
+        journal.remove();
+    } else {
+        qWarning() << Q_FUNC_INFO << "Failed to save" << fileName << "the journal will be replayed when the file is opened again.";
+    }
+    handle = nullptr;
+    getStatistics()->active = false;
+    return success;
+#else
+    return true;
+#endif
+}
+
+bool MemoryDatabase::checkpoint() {
+#ifdef ZOEGLFREX_SQLITE_API
+    if (handle == nullptr) {
+        return false;
+    }
+    sqlite3* sqliteHandle = static_cast<sqlite3*>(handle);
+    if (checkpointThread->isBusy()) {
+        checkpointPending = true;
+        return false;
+    }
+    if (!sqlite3_get_autocommit(sqliteHandle)) {
+        // Only save committed edits
+        QTimer::singleShot(100, this, &MemoryDatabase::checkpoint);
+        return false;
+    }
+    QElapsedTimer snapshotTimer;
+    snapshotTimer.start();
+    if (!rotateJournal()) {
+        return false;
+    }
+    sqlite3_int64 size = 0;
+    unsigned char* data = sqlite3_serialize(sqliteHandle, "main", &size, 0);
+    if (data == nullptr) {
+        qWarning() << Q_FUNC_INFO << "Failed to create a snapshot of the database.";
+        return false;
+    }
+    const QByteArray snapshot(reinterpret_cast<const char*>(data), size);
+    sqlite3_free(data);
+    if (!checkpointThread->write(snapshot, fileName, getOldJournalFileName(fileName))) {
+        return false;
+    }
+    editsSinceCheckpoint = 0;
+    checkpointPending = false;
+    getStatistics()->snapshotTime = snapshotTimer.nsecsElapsed();
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MemoryDatabase::rotateJournal() {
+    // Edits made after the snapshot go to a new journal, the old one is removed once the snapshot is on disk
+    journal.close();
+    const QString oldJournalFileName = getOldJournalFileName(fileName);
+    if (journal.exists()) {
+        if (QFile::exists(oldJournalFileName)) {
+            // The last checkpoint failed, so the old journal is still needed
+            QFile oldJournal(oldJournalFileName);
+            if (!journal.open(QIODevice::ReadOnly) || !oldJournal.open(QIODevice::Append) || (oldJournal.write(journal.readAll()) < 0)) {
+                qWarning() << Q_FUNC_INFO << "Failed to merge" << journal.fileName() << "into" << oldJournalFileName;
+                journal.close();
+                return false;
+            }
+            journal.close();
+        } else if (!journal.rename(oldJournalFileName)) {
+            qWarning() << Q_FUNC_INFO << "Failed to rename" << journal.fileName() << journal.errorString();
+            return false;
+        }
+        journal.setFileName(getJournalFileName(fileName));
+    }
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << journal.fileName() << journal.errorString();
+        return false;
+    }
+    journalStream.setDevice(&journal);
+    checkpointThread->setJournal(journal.handle(), journalSyncInterval);
+    return true;
+}
+
+void MemoryDatabase::finishCheckpoint(const bool success, const qint64 writeTime, const qint64 size) {
+    Statistics* statistics = getStatistics();
+    if (success) {
+        statistics->checkpoints++;
+        statistics->writeTime = writeTime;
+        statistics->size = size;
+        emit checkpointWritten();
+    } else {
+        statistics->failedCheckpoints++;
+    }
+    if (checkpointPending) {
+        checkpoint();
+    }
+}
+
+bool MemoryDatabase::appendJournal(const QStringList& queryTexts) {
+    for (const QString& queryText : queryTexts) {
+        journalStream << queryText;
+    }
+    // Hand the entries to the operating system, so they survive a crash of Zöglfrex, the checkpoint thread syncs them to the disk
+    if ((journalStream.status() != QDataStream::Ok) || !journal.flush()) {
+        qWarning() << Q_FUNC_INFO << "Failed to write" << journal.fileName() << journal.errorString();
+        journalStream.resetStatus();
+        return false;
+    }
+    checkpointThread->syncJournal();
+    getStatistics()->journalEntries += queryTexts.length();
+    editsSinceCheckpoint += queryTexts.length();
+    if ((checkpointEdits > 0) && (editsSinceCheckpoint >= checkpointEdits)) {
+        editsSinceCheckpoint = 0;
+        QTimer::singleShot(0, this, &MemoryDatabase::checkpoint);
+    }
+    return true;
+}
+
+int MemoryDatabase::traceStatement(const unsigned int type, void* context, void* statement, void* time) {
+    Q_UNUSED(type)
+    Q_UNUSED(time)
+#ifdef ZOEGLFREX_SQLITE_API
+    // Called when a statement has finished, statements run by triggers are replayed by the triggers themselves
+    MemoryDatabase* memoryDatabase = static_cast<MemoryDatabase*>(context);
+    sqlite3_stmt* sqliteStatement = static_cast<sqlite3_stmt*>(statement);
+    sqlite3* sqliteHandle = sqlite3_db_handle(sqliteStatement);
+    const char* queryText = sqlite3_sql(sqliteStatement);
+    if (queryText == nullptr) {
+        return 0;
+    }
+    const QString text = QString::fromUtf8(queryText).simplified();
+    const QStringList words = text.toUpper().remove(';').split(' ', Qt::SkipEmptyParts);
+    if (words.isEmpty()) {
+        return 0;
+    }
+    if (words.first() == "SAVEPOINT") {
+        if (words.length() > 1) {
+            memoryDatabase->savepoints.append({words.at(1), memoryDatabase->pendingStatements.length()});
+        }
+        return 0;
+    }
+    if ((words.first() == "RELEASE") || ((words.first() == "ROLLBACK") && words.contains("TO"))) {
+        // RELEASE removes the savepoint, ROLLBACK TO reverts the statements since the savepoint but keeps it
+        const bool release = (words.first() == "RELEASE");
+        for (int savepointIndex = memoryDatabase->savepoints.length() - 1; savepointIndex >= 0; savepointIndex--) {
+            if (memoryDatabase->savepoints.at(savepointIndex).first == words.last()) {
+                if (!release) {
+                    memoryDatabase->pendingStatements.resize(memoryDatabase->savepoints.at(savepointIndex).second);
+                }
+                memoryDatabase->savepoints.resize(release ? savepointIndex : (savepointIndex + 1));
+                break;
+            }
+        }
+        return 0;
+    }
+    if (sqlite3_stmt_readonly(sqliteStatement) || (getTransactionKeyword(queryText) != nullptr) || isTemporaryStatement(queryText)) {
+        return 0;
+    }
+    // Only INSERT, UPDATE and DELETE set the number of changes, which is 0 if they failed or didn't match a row
+    const bool changesRows = QStringList({"INSERT", "UPDATE", "DELETE", "REPLACE", "WITH"}).contains(words.first());
+    if (changesRows && (sqlite3_changes(sqliteHandle) <= 0)) {
+        return 0;
+    }
+    char* expandedQueryText = sqlite3_expanded_sql(sqliteStatement);
+    const QString journalText = QString::fromUtf8((expandedQueryText != nullptr) ? expandedQueryText : queryText);
+    sqlite3_free(expandedQueryText);
+    if (sqlite3_get_autocommit(sqliteHandle)) {
+        // Statements outside of transactions are already committed when they have finished
+        memoryDatabase->appendJournal({journalText});
+    } else {
+        memoryDatabase->pendingStatements.append(journalText);
+    }
+#else
+    Q_UNUSED(context)
+    Q_UNUSED(statement)
+#endif
+    return 0;
+}
+
+int MemoryDatabase::commitTransaction(void* context) {
+    MemoryDatabase* memoryDatabase = static_cast<MemoryDatabase*>(context);
+    const QStringList statements = memoryDatabase->pendingStatements;
+    memoryDatabase->pendingStatements.clear();
+    memoryDatabase->savepoints.clear();
+    if (statements.isEmpty()) {
+        return 0;
+    }
+    // A transaction that couldn't be journaled is rolled back instead of being committed
+    return memoryDatabase->appendJournal(QStringList("BEGIN") + statements + QStringList("COMMIT")) ? 0 : 1;
+}
+
+void MemoryDatabase::rollbackTransaction(void* context) {
+    MemoryDatabase* memoryDatabase = static_cast<MemoryDatabase*>(context);
+    memoryDatabase->pendingStatements.clear();
+    memoryDatabase->savepoints.clear();
+}
+
+QString MemoryDatabase::getJournalFileName(const QString& file) {
+    return file + ".edits";
+}
+
+QString MemoryDatabase::getOldJournalFileName(const QString& file) {
+    return file + ".edits.old";
+}
+
+MemoryDatabase::Statistics* MemoryDatabase::getStatistics() {
+    static Statistics statistics;
+    return &statistics;
+}
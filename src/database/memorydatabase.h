@@ -0,0 +1,68 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef MEMORYDATABASE_H
+#define MEMORYDATABASE_H
+
+#include <QtCore>
+#include <QtSql>
+
+#include "database/checkpointthread.h"
+
+// Keeps the working copy of a file in an in-memory database, saves it in the background and journals every edit in between
+class MemoryDatabase : public QObject {
+    Q_OBJECT
+public:
+    struct Statistics {
+        bool active = false;
+        int checkpoints = 0;
+        int failedCheckpoints = 0;
+        qint64 snapshotTime = 0;
+        qint64 writeTime = 0;
+        qint64 size = 0;
+        int journalEntries = 0;
+    };
+    MemoryDatabase(QSqlDatabase memoryDatabase, const QString& file, QObject* parent = nullptr);
+    ~MemoryDatabase();
+    static bool isAvailable(QSqlDatabase database);
+    static bool load(QSqlDatabase memoryDatabase, const QString& file);
+    static int replayJournals(QSqlDatabase database, const QString& file);
+    static void removeJournals(const QString& file);
+    static Statistics takeStatistics();
+    bool start();
+    bool close();
+public slots:
+    bool checkpoint();
+signals:
+    void checkpointWritten();
+private:
+    static QString getJournalFileName(const QString& file);
+    static QString getOldJournalFileName(const QString& file);
+    static Statistics* getStatistics();
+    static int traceStatement(unsigned int type, void* context, void* statement, void* time);
+    static int commitTransaction(void* context);
+    static void rollbackTransaction(void* context);
+    bool appendJournal(const QStringList& queryTexts);
+    void finishCheckpoint(bool success, qint64 writeTime, qint64 size);
+    bool rotateJournal();
+    QSqlDatabase database;
+    QString fileName;
+    void* handle = nullptr;
+    CheckpointThread* checkpointThread;
+    QTimer* checkpointTimer;
+    QFile journal;
+    QDataStream journalStream;
+    QStringList pendingStatements;
+    QList<QPair<QString, int>> savepoints;
+    int checkpointEdits = 500;
+    int journalSyncInterval = 100;
+    int editsSinceCheckpoint = 0;
+    bool checkpointPending = false;
+};
+
+#endif // MEMORYDATABASE_H
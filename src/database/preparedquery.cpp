@@ -0,0 +1,89 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "preparedquery.h"
+
+PreparedQuery::PreparedQuery() : connection(QSqlDatabase::defaultConnection) {}
+
+PreparedQuery::PreparedQuery(const QString& queryText, const QString& connectionName) : connection(connectionName) {
+    prepare(queryText);
+}
+
+PreparedQuery::~PreparedQuery() {
+    release();
+}
+
+bool PreparedQuery::prepare(const QString& queryText) {
+    Q_ASSERT(QThread::currentThread() == QCoreApplication::instance()->thread());
+    release();
+    text = queryText;
+    Cache* cache = getCache();
+    QList<QSqlQuery*>& unusedQueries = cache->unusedQueries[connection][text];
+    if (!unusedQueries.isEmpty()) {
+        query = unusedQueries.takeLast();
+        prepared = true;
+        cache->statistics.reuses++;
+        return true;
+    }
+    QElapsedTimer prepareTimer;
+    prepareTimer.start();
+    query = new QSqlQuery(QSqlDatabase::database(connection, false));
+    prepared = query->prepare(text);
+    cache->statistics.prepares++;
+    cache->statistics.prepareTime += prepareTimer.nsecsElapsed();
+    if (prepared) {
+        cache->statements[connection]++;
+    } else {
+        qWarning() << Q_FUNC_INFO << text << query->lastError().text();
+    }
+    return prepared;
+}
+
+void PreparedQuery::release() {
+    if (query == nullptr) {
+        return;
+    }
+    if (prepared) {
+        // Resets the statement, so it doesn't hold a read transaction open
+        query->finish();
+        getCache()->unusedQueries[connection][text].append(query);
+    } else {
+        delete query;
+    }
+    query = nullptr;
+}
+
+QSqlQuery* PreparedQuery::operator->() const {
+    return query;
+}
+
+PreparedQuery::Statistics PreparedQuery::takeStatistics() {
+    Cache* cache = getCache();
+    Statistics statistics = cache->statistics;
+    statistics.statements = 0;
+    for (const int statements : cache->statements) {
+        statistics.statements += statements;
+    }
+    cache->statistics = Statistics();
+    return statistics;
+}
+
+void PreparedQuery::clear(const QString& connectionName) {
+    Cache* cache = getCache();
+    for (const QList<QSqlQuery*>& queries : cache->unusedQueries.value(connectionName)) {
+        qDeleteAll(queries);
+    }
+    cache->unusedQueries.remove(connectionName);
+    cache->statements.remove(connectionName);
+}
+
+PreparedQuery::Cache* PreparedQuery::getCache() {
+    // Never destroyed, the queries must be cleared before their database is closed
+    static Cache* cache = new Cache();
+    return cache;
+}
@@ -0,0 +1,45 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef PREPAREDQUERY_H
+#define PREPAREDQUERY_H
+
+#include <QtSql>
+
+// Borrows a prepared statement for the given SQL text from a cache, so every statement is only compiled once per connection
+class PreparedQuery {
+public:
+    struct Statistics {
+        int statements = 0;
+        int prepares = 0;
+        qint64 prepareTime = 0;
+        int reuses = 0;
+    };
+    PreparedQuery();
+    PreparedQuery(const QString& queryText, const QString& connectionName = QSqlDatabase::defaultConnection);
+    ~PreparedQuery();
+    bool prepare(const QString& queryText);
+    QSqlQuery* operator->() const;
+    static Statistics takeStatistics();
+    static void clear(const QString& connectionName = QSqlDatabase::defaultConnection);
+private:
+    struct Cache {
+        QHash<QString, QHash<QString, QList<QSqlQuery*>>> unusedQueries;
+        QHash<QString, int> statements;
+        Statistics statistics;
+    };
+    static Cache* getCache();
+    void release();
+    QString text;
+    const QString connection;
+    QSqlQuery* query = nullptr;
+    bool prepared = false;
+    Q_DISABLE_COPY(PreparedQuery)
+};
+
+#endif // PREPAREDQUERY_H
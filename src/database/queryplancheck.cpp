@@ -0,0 +1,55 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "queryplancheck.h"
+
+QStringList QueryPlanCheck::getQueries() {
+    QStringList queries;
+    // Engine
+    queries.append("SELECT valueitem_key FROM cue_group_intensities WHERE item_key = :cue AND foreignitem_key = :group");
+    queries.append("SELECT cue_group_raws.valueitem_key FROM cue_group_raws, raws WHERE cue_group_raws.item_key = :cue AND cue_group_raws.foreignitem_key = :group AND cue_group_raws.valueitem_key = raws.key ORDER BY raws.sortkey");
+    queries.append("SELECT value FROM intensity_fixture_dimmer WHERE item_key = :item AND foreignitem_key = :fixture");
+    queries.append("SELECT key FROM cues WHERE cuelist_key = :cuelist AND sortkey > (SELECT sortkey FROM cues WHERE key = :currentcue) LIMIT 10");
+    // Reverse lookups
+    queries.append("SELECT item_key FROM group_fixtures WHERE valueitem_key = :fixture");
+    queries.append("SELECT item_key FROM cue_group_intensities WHERE foreignitem_key = :group");
+    queries.append("SELECT item_key FROM cue_group_effects WHERE valueitem_key = :effect");
+    queries.append("SELECT item_key FROM intensity_raws WHERE valueitem_key = :raw");
+    queries.append("SELECT item_key FROM effect_step_intensities WHERE valueitem_key = :intensity");
+    queries.append("SELECT key FROM fixtures WHERE model_key = :model");
+    queries.append("SELECT key FROM cuelists WHERE currentcue_key = :cue OR lastcue_key = :cue");
+    // Terminal selections
+    queries.append("SELECT id FROM fixtures WHERE sortid BETWEEN :from AND :to");
+    queries.append("SELECT id FROM cues WHERE cuelist_key = :cuelist AND sortid BETWEEN :from AND :to");
+    // Deleting a fixture cascades like this
+    queries.append("DELETE FROM position_fixture_pan WHERE foreignitem_key = :fixture");
+    queries.append("DELETE FROM raw_fixture_channel_values WHERE foreignitem_key = :fixture");
+    queries.append("DELETE FROM cue_fixture_fade WHERE foreignitem_key = :fixture");
+    return queries;
+}
+
+bool QueryPlanCheck::check(QSqlDatabase database) {
+    bool ok = true;
+    for (const QString queryText : getQueries()) {
+        QSqlQuery query(database);
+        if (!query.exec("EXPLAIN QUERY PLAN " + queryText)) {
+            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+            ok = false;
+            continue;
+        }
+        while (query.next()) {
+            const QString detail = query.value("detail").toString();
+            // "SCAN <table>" without an index means that the whole table is read, a scan of a covering index is fine
+            if (detail.startsWith("SCAN ") && !detail.contains(QRegularExpression("USING .*INDEX")) && (detail != "SCAN CONSTANT ROW")) {
+                qWarning() << Q_FUNC_INFO << "Query without index:" << queryText << detail;
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,152 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "datagramsender.h"
+
+#ifdef Q_OS_LINUX
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#endif
+
+DatagramSender::DatagramSender() {
+    datagrams.reserve(1024);
+}
+
+DatagramSender::~DatagramSender() {
+    close();
+}
+
+bool DatagramSender::bind(const QNetworkInterface interface, const QHostAddress address) {
+    close();
+    error = QString();
+#ifdef Q_OS_LINUX
+    Q_UNUSED(interface);
+    socketDescriptor = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (socketDescriptor < 0) {
+        error = std::strerror(errno);
+        return false;
+    }
+    sockaddr_in localAddress = {};
+    localAddress.sin_family = AF_INET;
+    localAddress.sin_addr.s_addr = htonl(address.toIPv4Address());
+    localAddress.sin_port = 0;
+    in_addr multicastInterface = {};
+    multicastInterface.s_addr = htonl(address.toIPv4Address());
+    const int broadcast = 1;
+    if (
+        (::bind(socketDescriptor, (sockaddr*)&localAddress, sizeof(localAddress)) < 0) ||
+        (setsockopt(socketDescriptor, IPPROTO_IP, IP_MULTICAST_IF, &multicastInterface, sizeof(multicastInterface)) < 0) ||
+        (setsockopt(socketDescriptor, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast)) < 0)
+    ) {
+        error = std::strerror(errno);
+        close();
+        return false;
+    }
+#else
+    socket = new QUdpSocket();
+    if (!socket->bind(address)) {
+        error = socket->errorString();
+        close();
+        return false;
+    }
+    socket->setMulticastInterface(interface);
+#endif
+    return true;
+}
+
+void DatagramSender::close() {
+    datagrams.clear();
+#ifdef Q_OS_LINUX
+    if (socketDescriptor >= 0) {
+        ::close(socketDescriptor);
+    }
+    socketDescriptor = -1;
+#else
+    delete socket;
+    socket = nullptr;
+#endif
+}
+
+bool DatagramSender::isBound() const {
+#ifdef Q_OS_LINUX
+    return (socketDescriptor >= 0);
+#else
+    return (socket != nullptr);
+#endif
+}
+
+void DatagramSender::queueDatagram(const char* data, const int size, const quint32 address, const quint16 port) {
+    datagrams.append({data, size, address, port});
+}
+
+int DatagramSender::flush() {
+    if (!isBound()) {
+        datagrams.clear();
+        return -1;
+    }
+    int sentDatagrams = 0;
+#ifdef Q_OS_LINUX
+    const size_t count = datagrams.length();
+    if (messages.size() < count) {
+        messages.resize(count);
+        vectors.resize(count);
+        addresses.resize(count);
+    }
+    for (size_t index = 0; index < count; index++) {
+        const Datagram datagram = datagrams.at(index);
+        vectors[index].iov_base = (void*)datagram.data;
+        vectors[index].iov_len = datagram.size;
+        addresses[index].sin_family = AF_INET;
+        addresses[index].sin_addr.s_addr = htonl(datagram.address);
+        addresses[index].sin_port = htons(datagram.port);
+        messages[index] = {};
+        messages[index].msg_hdr.msg_name = &addresses[index];
+        messages[index].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        messages[index].msg_hdr.msg_iov = &vectors[index];
+        messages[index].msg_hdr.msg_iovlen = 1;
+    }
+    while ((size_t)sentDatagrams < count) {
+        const int result = sendmmsg(socketDescriptor, &messages[sentDatagrams], count - sentDatagrams, 0);
+        sendCalls++;
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = std::strerror(errno);
+            qWarning() << Q_FUNC_INFO << error;
+            sentDatagrams = -1;
+            break;
+        }
+        sentDatagrams += result;
+    }
+#else
+    for (const Datagram datagram : datagrams) {
+        const qint64 result = socket->writeDatagram(datagram.data, datagram.size, QHostAddress(datagram.address), datagram.port);
+        sendCalls++;
+        if (result < 0) {
+            error = socket->errorString();
+            qWarning() << Q_FUNC_INFO << socket->error() << error;
+            sentDatagrams = -1;
+            break;
+        }
+        sentDatagrams++;
+    }
+#endif
+    datagrams.clear();
+    return sentDatagrams;
+}
+
+int DatagramSender::getSendCalls() const {
+    return sendCalls;
+}
+
+QString DatagramSender::errorString() const {
+    return error;
+}
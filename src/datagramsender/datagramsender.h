@@ -0,0 +1,50 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DATAGRAMSENDER_H
+#define DATAGRAMSENDER_H
+
+#include <QtNetwork>
+
+#ifdef Q_OS_LINUX
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+class DatagramSender {
+public:
+    DatagramSender();
+    ~DatagramSender();
+    bool bind(QNetworkInterface interface, QHostAddress address);
+    void close();
+    bool isBound() const;
+    void queueDatagram(const char* data, int size, quint32 address, quint16 port);
+    int flush();
+    int getSendCalls() const;
+    QString errorString() const;
+private:
+    struct Datagram {
+        const char* data;
+        int size;
+        quint32 address;
+        quint16 port;
+    };
+    QList<Datagram> datagrams;
+    int sendCalls = 0;
+    QString error;
+#ifdef Q_OS_LINUX
+    int socketDescriptor = -1;
+    std::vector<mmsghdr> messages;
+    std::vector<iovec> vectors;
+    std::vector<sockaddr_in> addresses;
+#else
+    QUdpSocket* socket = nullptr;
+#endif
+};
+
+#endif // DATAGRAMSENDER_H
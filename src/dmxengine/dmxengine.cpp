@@ -9,6 +9,7 @@
 #include "dmxengine.h"
 
 DmxEngine::DmxEngine(QWidget* parent) : QWidget(parent) {
+    cache = new EngineCache(FRAMEDURATION, this);
     settings = new QSettings("Zoeglfrex");
 
     QHBoxLayout* layout = new QHBoxLayout();
@@ -52,25 +53,42 @@ DmxEngine::DmxEngine(QWidget* parent) : QWidget(parent) {
     timer->start(FRAMEDURATION);
 }
 
+void DmxEngine::setDatabaseNotifier(DatabaseNotifier* notifier) {
+    databaseNotifier = notifier;
+    cache->setDatabaseNotifier(notifier);
+}
+
+EngineCache::Statistics DmxEngine::takeCacheStatistics() {
+    return cache->takeStatistics();
+}
+
+EngineCache* DmxEngine::getCache() const {
+    return cache;
+}
+
 void DmxEngine::generateDmx() {
+    // Every change is applied to the cache before a frame is rendered from it
+    if (databaseNotifier != nullptr) {
+        databaseNotifier->publish();
+    }
     int currentCuelistKey = -1;
-    QSqlQuery currentCuelistQuery;
-    if (currentCuelistQuery.exec("SELECT cuelist_key FROM currentitems")) {
-        if (currentCuelistQuery.next()) {
-            currentCuelistKey = currentCuelistQuery.value(0).toInt();
+    PreparedQuery currentCuelistQuery("SELECT cuelist_key FROM currentitems");
+    if (currentCuelistQuery->exec()) {
+        if (currentCuelistQuery->next()) {
+            currentCuelistKey = currentCuelistQuery->value(0).toInt();
         }
     } else {
-        qWarning() << Q_FUNC_INFO << currentCuelistQuery.executedQuery() << currentCuelistQuery.lastError().text();
+        qWarning() << Q_FUNC_INFO << currentCuelistQuery->executedQuery() << currentCuelistQuery->lastError().text();
     }
 
     QList<int> groupKeys;
     QHash<int, QSet<int>> groupFixtureKeys;
     QSet<int> fixtureKeys;
-    QSqlQuery groupFixturesQuery;
-    if (groupFixturesQuery.exec("SELECT groups.key, group_fixtures.valueitem_key FROM groups, group_fixtures WHERE groups.key = group_fixtures.item_key ORDER BY groups.sortkey")) {
-        while (groupFixturesQuery.next()) {
-            const int groupKey = groupFixturesQuery.value(0).toInt();
-            const int fixtureKey = groupFixturesQuery.value(1).toInt();
+    PreparedQuery groupFixturesQuery("SELECT groups.key, group_fixtures.valueitem_key FROM groups, group_fixtures WHERE groups.key = group_fixtures.item_key ORDER BY groups.sortkey");
+    if (groupFixturesQuery->exec()) {
+        while (groupFixturesQuery->next()) {
+            const int groupKey = groupFixturesQuery->value(0).toInt();
+            const int fixtureKey = groupFixturesQuery->value(1).toInt();
             if (!groupKeys.contains(groupKey)) {
                 groupKeys.append(groupKey);
                 groupFixtureKeys[groupKey] = QSet<int>();
@@ -79,13 +97,13 @@ void DmxEngine::generateDmx() {
             fixtureKeys.insert(fixtureKey);
         }
     } else {
-        qWarning() << Q_FUNC_INFO << groupFixturesQuery.executedQuery() << groupFixturesQuery.lastError().text();
+        qWarning() << Q_FUNC_INFO << groupFixturesQuery->executedQuery() << groupFixturesQuery->lastError().text();
         return;
     }
 
-    QSqlQuery cuelistQuery;
-    if (!cuelistQuery.exec("SELECT key, currentcue_key, COALESCE(lastcue_key, -1), priority FROM cuelists WHERE currentcue_key IS NOT NULL ORDER BY sortkey")) {
-        qWarning() << Q_FUNC_INFO << cuelistQuery.executedQuery() << cuelistQuery.lastError().text();
+    PreparedQuery cuelistQuery("SELECT key, currentcue_key, COALESCE(lastcue_key, -1), priority FROM cuelists WHERE currentcue_key IS NOT NULL ORDER BY sortkey");
+    if (!cuelistQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << cuelistQuery->executedQuery() << cuelistQuery->lastError().text();
         return;
     }
     QHash<int, QHash<int, int>> oldGroupEffectFrames = groupEffectFrames;
@@ -101,50 +119,47 @@ void DmxEngine::generateDmx() {
     QHash<int, int> fixturePositionPriorities;
     QHash<int, QHash<int, uint8_t>> fixtureChannelRaws;
     QHash<int, QHash<int, int>> fixtureChannelRawPriorities;
-    while (cuelistQuery.next()) {
-        const int cuelistKey = cuelistQuery.value(0).toInt();
-        const int currentCueKey = cuelistQuery.value(1).toInt();
-        const int lastCueKey = cuelistQuery.value(2).toInt();
-        const int priority = cuelistQuery.value(3).toInt();
+    while (cuelistQuery->next()) {
+        const int cuelistKey = cuelistQuery->value(0).toInt();
+        const int currentCueKey = cuelistQuery->value(1).toInt();
+        const int lastCueKey = cuelistQuery->value(2).toInt();
+        const int priority = cuelistQuery->value(3).toInt();
         if (!skipFadeButton->isChecked()) {
             if (oldCuelistCurrentCueKeys.value(cuelistKey, -1) != currentCueKey) {
-                QSqlQuery transitionQuery;
-                transitionQuery.prepare("SELECT fade, delay, sinefade FROM cues WHERE key = :key");
-                transitionQuery.bindValue(":key", currentCueKey);
-                if (transitionQuery.exec()) {
-                    if (transitionQuery.next()) {
-                        const int standardFadeFrames = (transitionQuery.value(0).toFloat() * 1000 / FRAMEDURATION);
-                        const int standardDelayFrames = (transitionQuery.value(1).toFloat() * 1000 / FRAMEDURATION);
-                        const bool sineFade = (transitionQuery.value(2).toInt() == 1);
+                PreparedQuery transitionQuery("SELECT fade, delay, sinefade FROM cues WHERE key = :key");
+                transitionQuery->bindValue(":key", currentCueKey);
+                if (transitionQuery->exec()) {
+                    if (transitionQuery->next()) {
+                        const int standardFadeFrames = (transitionQuery->value(0).toFloat() * 1000 / FRAMEDURATION);
+                        const int standardDelayFrames = (transitionQuery->value(1).toFloat() * 1000 / FRAMEDURATION);
+                        const bool sineFade = (transitionQuery->value(2).toInt() == 1);
                         QHash<int, int> fixtureFadeFrames;
                         int maxFadeFrames = standardFadeFrames;
-                        QSqlQuery fixtureFadeQuery;
-                        fixtureFadeQuery.prepare("SELECT foreignitem_key, value FROM cue_fixture_fade WHERE item_key = :cue");
-                        fixtureFadeQuery.bindValue(":cue", currentCueKey);
-                        if (fixtureFadeQuery.exec()) {
-                            while (fixtureFadeQuery.next()) {
-                                const int fixtureKey = fixtureFadeQuery.value(0).toInt();
-                                const int fadeFrames = (fixtureFadeQuery.value(1).toFloat() * 1000 / FRAMEDURATION);
+                        PreparedQuery fixtureFadeQuery("SELECT foreignitem_key, value FROM cue_fixture_fade WHERE item_key = :cue");
+                        fixtureFadeQuery->bindValue(":cue", currentCueKey);
+                        if (fixtureFadeQuery->exec()) {
+                            while (fixtureFadeQuery->next()) {
+                                const int fixtureKey = fixtureFadeQuery->value(0).toInt();
+                                const int fadeFrames = (fixtureFadeQuery->value(1).toFloat() * 1000 / FRAMEDURATION);
                                 fixtureFadeFrames[fixtureKey] = fadeFrames;
                                 maxFadeFrames = std::max(fadeFrames, maxFadeFrames);
                             }
                         } else {
-                            qWarning() << Q_FUNC_INFO << fixtureFadeQuery.executedQuery() << fixtureFadeQuery.lastError().text();
+                            qWarning() << Q_FUNC_INFO << fixtureFadeQuery->executedQuery() << fixtureFadeQuery->lastError().text();
                         }
                         QHash<int, int> fixtureDelayFrames;
                         int maxDelayFrames = standardDelayFrames;
-                        QSqlQuery fixtureDelayQuery;
-                        fixtureDelayQuery.prepare("SELECT foreignitem_key, value FROM cue_fixture_delay WHERE item_key = :cue");
-                        fixtureDelayQuery.bindValue(":cue", currentCueKey);
-                        if (fixtureDelayQuery.exec()) {
-                            while (fixtureDelayQuery.next()) {
-                                const int fixtureKey = fixtureDelayQuery.value(0).toInt();
-                                const int delayFrames = (fixtureDelayQuery.value(1).toFloat() * 1000 / FRAMEDURATION);
+                        PreparedQuery fixtureDelayQuery("SELECT foreignitem_key, value FROM cue_fixture_delay WHERE item_key = :cue");
+                        fixtureDelayQuery->bindValue(":cue", currentCueKey);
+                        if (fixtureDelayQuery->exec()) {
+                            while (fixtureDelayQuery->next()) {
+                                const int fixtureKey = fixtureDelayQuery->value(0).toInt();
+                                const int delayFrames = (fixtureDelayQuery->value(1).toFloat() * 1000 / FRAMEDURATION);
                                 fixtureDelayFrames[fixtureKey] = delayFrames;
                                 maxDelayFrames = std::max(delayFrames, maxDelayFrames);
                             }
                         } else {
-                            qWarning() << Q_FUNC_INFO << fixtureDelayQuery.executedQuery() << fixtureDelayQuery.lastError().text();
+                            qWarning() << Q_FUNC_INFO << fixtureDelayQuery->executedQuery() << fixtureDelayQuery->lastError().text();
                         }
                         if ((maxFadeFrames + maxDelayFrames) > 0) {
                             cuelistFadeFrames[cuelistKey] = standardFadeFrames;
@@ -157,7 +172,7 @@ void DmxEngine::generateDmx() {
                         }
                     }
                 } else {
-                    qWarning() << Q_FUNC_INFO << transitionQuery.executedQuery() << transitionQuery.lastError().text();
+                    qWarning() << Q_FUNC_INFO << transitionQuery->executedQuery() << transitionQuery->lastError().text();
                 }
             } else if (oldCuelistRemainingTransitionFrames.value(cuelistKey, 0) > 0) {
                 cuelistRemainingTransitionFrames[cuelistKey] = (oldCuelistRemainingTransitionFrames.value(cuelistKey) - 1);
@@ -292,75 +307,74 @@ void DmxEngine::generateDmx() {
     QHash<int, int> mwdGroupCues;
     QHash<int, int> mwdGroupCueDifference;
     QHash<int, int> mwdGroupPriorities;
-    QSqlQuery mwdCuelistQuery;
-    if (mwdCuelistQuery.exec("SELECT key, priority, currentcue_key FROM cuelists WHERE movewhiledark = 1 AND currentcue_key IS NOT NULL ORDER BY sortkey")) {
-        while (mwdCuelistQuery.next()) {
-            const int cuelistKey = mwdCuelistQuery.value(0).toInt();
-            const int cuelistPriority = mwdCuelistQuery.value(1).toInt();
-            const int cuelistCurrentCueKey = mwdCuelistQuery.value(2).toInt();
-
-            QSqlQuery cuesQuery;
-            cuesQuery.prepare("SELECT key FROM cues WHERE cuelist_key = :cuelist AND sortkey > (SELECT sortkey FROM cues WHERE key = :currentcue) LIMIT 10");
-            cuesQuery.bindValue(":cuelist", cuelistKey);
-            cuesQuery.bindValue(":currentcue", cuelistCurrentCueKey);
-            if (cuesQuery.exec()) {
-                while (cuesQuery.next()) {
-                    const int cueKey = cuesQuery.value(0).toInt();
-                    const int cueDifference = cuesQuery.at() + 1;
+    PreparedQuery mwdCuelistQuery("SELECT key, priority, currentcue_key FROM cuelists WHERE movewhiledark = 1 AND currentcue_key IS NOT NULL ORDER BY sortkey");
+    if (mwdCuelistQuery->exec()) {
+        while (mwdCuelistQuery->next()) {
+            const int cuelistKey = mwdCuelistQuery->value(0).toInt();
+            const int cuelistPriority = mwdCuelistQuery->value(1).toInt();
+            const int cuelistCurrentCueKey = mwdCuelistQuery->value(2).toInt();
+
+            PreparedQuery cuesQuery("SELECT key FROM cues WHERE cuelist_key = :cuelist AND sortkey > (SELECT sortkey FROM cues WHERE key = :currentcue) LIMIT 10");
+            cuesQuery->bindValue(":cuelist", cuelistKey);
+            cuesQuery->bindValue(":currentcue", cuelistCurrentCueKey);
+            if (cuesQuery->exec()) {
+                while (cuesQuery->next()) {
+                    const int cueKey = cuesQuery->value(0).toInt();
+                    const int cueDifference = cuesQuery->at() + 1;
 
                     for (const int groupKey : groupKeys) {
                         if (!mwdGroupCueDifference.contains(groupKey) || (mwdGroupCueDifference.value(groupKey) > cueDifference) || ((mwdGroupCueDifference.value(groupKey) >= cueDifference) && (cuelistPriority >= mwdGroupPriorities.value(groupKey)))) {
                             const QStringList tables = {"cue_group_intensities", "cue_group_colors", "cue_group_positions", "cue_group_raws", "cue_group_effects"};
                             for (QString table : tables) {
-                                QSqlQuery cueValueQuery;
-                                cueValueQuery.prepare("SELECT valueitem_key FROM " + table + " WHERE item_key = :cue AND foreignitem_key = :group LIMIT 1");
-                                cueValueQuery.bindValue(":cue", cueKey);
-                                cueValueQuery.bindValue(":group", groupKey);
-                                if (cueValueQuery.exec()) {
-                                    if (cueValueQuery.next()) {
+                                PreparedQuery cueValueQuery("SELECT valueitem_key FROM " + table + " WHERE item_key = :cue AND foreignitem_key = :group LIMIT 1");
+                                cueValueQuery->bindValue(":cue", cueKey);
+                                cueValueQuery->bindValue(":group", groupKey);
+                                if (cueValueQuery->exec()) {
+                                    if (cueValueQuery->next()) {
                                         mwdGroupCues[groupKey] = cueKey;
                                         mwdGroupCueDifference[groupKey] = cueDifference;
                                         mwdGroupPriorities[groupKey] = cuelistPriority;
                                         break;
                                     }
                                 } else {
-                                    qWarning() << cueValueQuery.executedQuery() << cueValueQuery.lastError().text();
+                                    qWarning() << cueValueQuery->executedQuery() << cueValueQuery->lastError().text();
                                 }
                             }
                         }
                     }
                 }
             } else {
-                qWarning() << cuesQuery.executedQuery() << cuesQuery.lastError().text();
+                qWarning() << cuesQuery->executedQuery() << cuesQuery->lastError().text();
             }
         }
     } else {
-        qWarning() << mwdCuelistQuery.executedQuery() << mwdCuelistQuery.lastError().text();
+        qWarning() << mwdCuelistQuery->executedQuery() << mwdCuelistQuery->lastError().text();
     }
 
     QSet<int> currentFixtureKeys;
-    QSqlQuery currentFixtureQuery;
-    if (currentFixtureQuery.exec("SELECT key FROM currentfixtures")) {
-        while (currentFixtureQuery.next()) {
-            currentFixtureKeys.insert(currentFixtureQuery.value(0).toInt());
+    PreparedQuery currentFixtureQuery("SELECT key FROM currentfixtures");
+    if (currentFixtureQuery->exec()) {
+        while (currentFixtureQuery->next()) {
+            currentFixtureKeys.insert(currentFixtureQuery->value(0).toInt());
         }
     } else {
-        qWarning() << Q_FUNC_INFO << currentFixtureQuery.executedQuery() << currentFixtureQuery.lastError().text();
+        qWarning() << Q_FUNC_INFO << currentFixtureQuery->executedQuery() << currentFixtureQuery->lastError().text();
     }
 
-    QSqlQuery fixtureQuery;
-    if (!fixtureQuery.exec("SELECT key, universe, address, xposition, yposition, CONCAT(id, ' ', label) FROM fixtures")) {
-        qWarning() << Q_FUNC_INFO << fixtureQuery.executedQuery() << fixtureQuery.lastError().text();
+    PreparedQuery fixtureQuery("SELECT key, universe, address, xposition, yposition, CONCAT(id, ' ', label) FROM fixtures");
+    if (!fixtureQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << fixtureQuery->executedQuery() << fixtureQuery->lastError().text();
         return;
     }
     QHash<int, Preview2d::PreviewData> previewFixtures;
     QHash<int, QByteArray> dmxUniverses;
+    QHash<int, int> dmxUniverseSlots;
     QHash<int, float> lastFrameFixturePan = fixturePan;
     fixturePan.clear();
-    while (fixtureQuery.next()) {
-        const int fixtureKey = fixtureQuery.value(0).toInt();
-        const int universe = fixtureQuery.value(1).toInt();
-        const int address = fixtureQuery.value(2).toInt();
+    while (fixtureQuery->next()) {
+        const int fixtureKey = fixtureQuery->value(0).toInt();
+        const int universe = fixtureQuery->value(1).toInt();
+        const int address = fixtureQuery->value(2).toInt();
 
         if (!fixtureIntensities.contains(fixtureKey) && !fixtureColors.contains(fixtureKey) && !fixturePositions.contains(fixtureKey) && !fixtureChannelRaws.contains(fixtureKey)) {
             int fixtureCue = -1;
@@ -433,9 +447,9 @@ void DmxEngine::generateDmx() {
         float focus = position.focus;
 
         Preview2d::PreviewData previewFixture;
-        previewFixture.xPosition = fixtureQuery.value(3).toFloat();
-        previewFixture.yPosition = fixtureQuery.value(4).toFloat();
-        previewFixture.label = fixtureQuery.value(5).toString();
+        previewFixture.xPosition = fixtureQuery->value(3).toFloat();
+        previewFixture.yPosition = fixtureQuery->value(4).toFloat();
+        previewFixture.label = fixtureQuery->value(5).toString();
         previewFixture.color = QColor((red / 100) * (dimmer / 100) * 255, (green / 100) * (dimmer / 100) * 255, (blue / 100) * (dimmer / 100) * 255);
         previewFixture.pan = panAngle;
         previewFixture.tilt = tiltAngle;
@@ -443,21 +457,21 @@ void DmxEngine::generateDmx() {
         previewFixtures[fixtureKey] = previewFixture;
 
         if (address > 0) {
-            QSqlQuery modelQuery;
-            modelQuery.prepare("SELECT models.channels, models.panrange, models.tiltrange, models.minzoom, models.maxzoom, fixtures.rotation, fixtures.invertpan FROM fixtures, models WHERE fixtures.key = :key AND fixtures.model_key = models.key");
-            modelQuery.bindValue(":key", fixtureKey);
-            if (modelQuery.exec()) {
-                if (modelQuery.next()) {
-                    const QString channels = modelQuery.value(0).toString();
-                    const float panRange = modelQuery.value(1).toFloat();
-                    const float tiltRange = modelQuery.value(2).toFloat();
-                    const float minZoom = modelQuery.value(3).toFloat();
-                    const float maxZoom = modelQuery.value(4).toFloat();
-                    const float rotation = modelQuery.value(5).toFloat();
-                    const bool invertPan = (modelQuery.value(6).toInt() == 1);
+            PreparedQuery modelQuery("SELECT models.channels, models.panrange, models.tiltrange, models.minzoom, models.maxzoom, fixtures.rotation, fixtures.invertpan FROM fixtures, models WHERE fixtures.key = :key AND fixtures.model_key = models.key");
+            modelQuery->bindValue(":key", fixtureKey);
+            if (modelQuery->exec()) {
+                if (modelQuery->next()) {
+                    const QString channels = modelQuery->value(0).toString();
+                    const float panRange = modelQuery->value(1).toFloat();
+                    const float tiltRange = modelQuery->value(2).toFloat();
+                    const float minZoom = modelQuery->value(3).toFloat();
+                    const float maxZoom = modelQuery->value(4).toFloat();
+                    const float rotation = modelQuery->value(5).toFloat();
+                    const bool invertPan = (modelQuery->value(6).toInt() == 1);
                     if (!dmxUniverses.contains(universe)) {
                         dmxUniverses[universe] = QByteArray(512, 0);
                     }
+                    dmxUniverseSlots[universe] = std::max(dmxUniverseSlots.value(universe, 0), std::min((address + (int)channels.size() - 1), 512));
                     if (!channels.contains('D')) {
                         red *= (dimmer / 100);
                         green *= (dimmer / 100);
@@ -547,140 +561,74 @@ void DmxEngine::generateDmx() {
                         const int dmxChannel = address + channel - 1;
                         if (dmxChannel <= 512) {
                             dmxUniverses[universe][dmxChannel - 1] = fixtureChannelRaws.value(fixtureKey).value(channel);
+                            dmxUniverseSlots[universe] = std::max(dmxUniverseSlots.value(universe, 0), dmxChannel);
                         }
                     }
                 }
             } else {
-                qWarning() << Q_FUNC_INFO << modelQuery.executedQuery() << modelQuery.lastError().text();
+                qWarning() << Q_FUNC_INFO << modelQuery->executedQuery() << modelQuery->lastError().text();
             }
         }
     }
+    for (const int universe : dmxUniverseSlots.keys()) {
+        dmxUniverses[universe].truncate(dmxUniverseSlots.value(universe));
+    }
     emit sendUniverses(dmxUniverses);
     emit updatePreviewFixtures(previewFixtures);
     if (!skipFadeButton->isChecked()) {
-        QSqlQuery cuelistQuery;
-        if (cuelistQuery.exec("SELECT key FROM cuelists WHERE currentcue_key IS NOT NULL")) {
-            while (cuelistQuery.next()) {
-                const int cuelistKey = cuelistQuery.value(0).toInt();
+        PreparedQuery cuelistQuery("SELECT key FROM cuelists WHERE currentcue_key IS NOT NULL");
+        if (cuelistQuery->exec()) {
+            while (cuelistQuery->next()) {
+                const int cuelistKey = cuelistQuery->value(0).toInt();
                 if (cuelistRemainingTransitionFrames.value(cuelistKey, 0) <= 0) {
-                    QSqlQuery followQuery;
-                    followQuery.prepare("SELECT key, follow FROM cues WHERE cuelist_key = :cuelist AND sortkey = (SELECT MIN(sortkey) FROM cues WHERE cuelist_key = :cuelist AND sortkey > (SELECT cues.sortkey FROM cues, cuelists WHERE cuelists.key = :cuelist AND cuelists.currentcue_key = cues.key))");
-                    followQuery.bindValue(":cuelist", cuelistKey);
-                    if (followQuery.exec()) {
-                        if (followQuery.next() && (followQuery.value(1).toInt() == 1)) {
-                            const int followCueKey = followQuery.value(0).toInt();
-                            QSqlQuery cueUpdateQuery;
-                            cueUpdateQuery.prepare("UPDATE cuelists SET currentcue_key = :cue WHERE key = :cuelist");
-                            cueUpdateQuery.bindValue(":cuelist", cuelistKey);
-                            cueUpdateQuery.bindValue(":cue", followCueKey);
-                            if (!cueUpdateQuery.exec()) {
-                                qWarning() << Q_FUNC_INFO << cueUpdateQuery.executedQuery() << cueUpdateQuery.lastError().text();
+                    PreparedQuery followQuery("SELECT key, follow FROM cues WHERE cuelist_key = :cuelist AND sortkey = (SELECT MIN(sortkey) FROM cues WHERE cuelist_key = :cuelist AND sortkey > (SELECT cues.sortkey FROM cues, cuelists WHERE cuelists.key = :cuelist AND cuelists.currentcue_key = cues.key))");
+                    followQuery->bindValue(":cuelist", cuelistKey);
+                    if (followQuery->exec()) {
+                        if (followQuery->next() && (followQuery->value(1).toInt() == 1)) {
+                            const int followCueKey = followQuery->value(0).toInt();
+                            PreparedQuery cueUpdateQuery("UPDATE cuelists SET currentcue_key = :cue WHERE key = :cuelist");
+                            cueUpdateQuery->bindValue(":cuelist", cuelistKey);
+                            cueUpdateQuery->bindValue(":cue", followCueKey);
+                            if (!cueUpdateQuery->exec()) {
+                                qWarning() << Q_FUNC_INFO << cueUpdateQuery->executedQuery() << cueUpdateQuery->lastError().text();
                             }
                             emit dbChanged();
                         }
                     } else {
-                        qWarning() << Q_FUNC_INFO << followQuery.executedQuery() << followQuery.lastError().text();
+                        qWarning() << Q_FUNC_INFO << followQuery->executedQuery() << followQuery->lastError().text();
                     }
                 }
             }
         } else {
-            qWarning() << Q_FUNC_INFO << cuelistQuery.executedQuery() << cuelistQuery.lastError().text();
+            qWarning() << Q_FUNC_INFO << cuelistQuery->executedQuery() << cuelistQuery->lastError().text();
         }
     }
 }
 
 void DmxEngine::renderCue(const int cueKey, const QList<int> groupKeys, const QHash<int, QSet<int>> groupFixtureKeys, QHash<int, QHash<int, int>> oldGroupEffectFrames, QHash<int, float>* fixtureIntensities, QHash<int, ColorData>* fixtureColors, QHash<int, PositionData>* fixturePositions, QHash<int, QHash<int, RawChannelData>>* fixtureRaws) {
     for (const int groupKey : groupKeys) {
-        QList<int> rawKeys;
-        QSqlQuery intensityQuery;
-        intensityQuery.prepare("SELECT valueitem_key FROM cue_group_intensities WHERE item_key = :cue AND foreignitem_key = :group");
-        intensityQuery.bindValue(":group", groupKey);
-        intensityQuery.bindValue(":cue", cueKey);
-        if (intensityQuery.exec()) {
-            while (intensityQuery.next()) {
-                const int intensityKey = intensityQuery.value(0).toInt();
-                for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
-                    const float dimmer = getFixtureIntensity(fixtureKey, intensityKey);
-                    if (dimmer >= fixtureIntensities->value(fixtureKey, 0)) {
-                        (*fixtureIntensities)[fixtureKey] = dimmer;
-                    }
-                }
-                QSqlQuery rawsQuery;
-                rawsQuery.prepare("SELECT intensity_raws.valueitem_key FROM intensity_raws, raws WHERE intensity_raws.item_key = :intensity AND intensity_raws.valueitem_key = raws.key ORDER BY raws.sortkey");
-                rawsQuery.bindValue(":intensity", intensityKey);
-                if (rawsQuery.exec()) {
-                    while (rawsQuery.next()) {
-                        rawKeys.append(rawsQuery.value(0).toInt());
-                    }
-                } else {
-                    qWarning() << Q_FUNC_INFO << rawsQuery.executedQuery() << rawsQuery.lastError().text();
-                }
-            }
-        } else {
-            qWarning() << Q_FUNC_INFO << intensityQuery.executedQuery() << intensityQuery.lastError().text();
-        }
-        QSqlQuery colorQuery;
-        colorQuery.prepare("SELECT valueitem_key FROM cue_group_colors WHERE item_key = :cue AND foreignitem_key = :group");
-        colorQuery.bindValue(":group", groupKey);
-        colorQuery.bindValue(":cue", cueKey);
-        if (colorQuery.exec()) {
-            while (colorQuery.next()) {
-                const int colorKey = colorQuery.value(0).toInt();
-                for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
-                    (*fixtureColors)[fixtureKey] = getFixtureColor(fixtureKey, colorKey);
-                }
-                QSqlQuery rawsQuery;
-                rawsQuery.prepare("SELECT color_raws.valueitem_key FROM color_raws, raws WHERE color_raws.item_key = :color AND color_raws.valueitem_key = raws.key ORDER BY raws.sortkey");
-                rawsQuery.bindValue(":color", colorKey);
-                if (rawsQuery.exec()) {
-                    while (rawsQuery.next()) {
-                        rawKeys.append(rawsQuery.value(0).toInt());
-                    }
-                } else {
-                    qWarning() << Q_FUNC_INFO << rawsQuery.executedQuery() << rawsQuery.lastError().text();
+        const EngineCache::CueGroup cueGroup = cache->getCueGroup(cueKey, groupKey);
+        for (const int intensityKey : cueGroup.intensityKeys) {
+            for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
+                const float dimmer = getFixtureIntensity(fixtureKey, intensityKey);
+                if (dimmer >= fixtureIntensities->value(fixtureKey, 0)) {
+                    (*fixtureIntensities)[fixtureKey] = dimmer;
                 }
             }
-        } else {
-            qWarning() << Q_FUNC_INFO << colorQuery.executedQuery() << colorQuery.lastError().text();
         }
-        QSqlQuery positionQuery;
-        positionQuery.prepare("SELECT valueitem_key FROM cue_group_positions WHERE item_key = :cue AND foreignitem_key = :group");
-        positionQuery.bindValue(":group", groupKey);
-        positionQuery.bindValue(":cue", cueKey);
-        if (positionQuery.exec()) {
-            while (positionQuery.next()) {
-                const int positionKey = positionQuery.value(0).toInt();
-                for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
-                    (*fixturePositions)[fixtureKey] = getFixturePosition(fixtureKey, positionKey);
-                }
-                QSqlQuery rawsQuery;
-                rawsQuery.prepare("SELECT position_raws.valueitem_key FROM position_raws, raws WHERE position_raws.item_key = :position AND position_raws.valueitem_key = raws.key ORDER BY raws.sortkey");
-                rawsQuery.bindValue(":position", positionKey);
-                if (rawsQuery.exec()) {
-                    while (rawsQuery.next()) {
-                        rawKeys.append(rawsQuery.value(0).toInt());
-                    }
-                } else {
-                    qWarning() << Q_FUNC_INFO << rawsQuery.executedQuery() << rawsQuery.lastError().text();
-                }
+        for (const int colorKey : cueGroup.colorKeys) {
+            for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
+                (*fixtureColors)[fixtureKey] = getFixtureColor(fixtureKey, colorKey);
             }
-        } else {
-            qWarning() << Q_FUNC_INFO << positionQuery.executedQuery() << positionQuery.lastError().text();
         }
-        QSqlQuery rawQuery;
-        rawQuery.prepare("SELECT cue_group_raws.valueitem_key FROM cue_group_raws, raws WHERE cue_group_raws.item_key = :cue AND cue_group_raws.foreignitem_key = :group AND cue_group_raws.valueitem_key = raws.key ORDER BY raws.sortkey");
-        rawQuery.bindValue(":group", groupKey);
-        rawQuery.bindValue(":cue", cueKey);
-        if (rawQuery.exec()) {
-            while (rawQuery.next()) {
-                rawKeys.append(rawQuery.value(0).toInt());
+        for (const int positionKey : cueGroup.positionKeys) {
+            for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
+                (*fixturePositions)[fixtureKey] = getFixturePosition(fixtureKey, positionKey);
             }
-        } else {
-            qWarning() << Q_FUNC_INFO << rawQuery.executedQuery() << rawQuery.lastError().text();
         }
-        if (!rawKeys.isEmpty()) {
+        if (!cueGroup.rawKeys.isEmpty()) {
             for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
-                const QHash<int, RawChannelData> raws = getFixtureRaws(fixtureKey, rawKeys);
+                const QHash<int, RawChannelData> raws = getFixtureRaws(fixtureKey, cueGroup.rawKeys);
                 if (fixtureRaws->contains(fixtureKey)) {
                     for (const int channel : raws.keys()) {
                         (*fixtureRaws)[fixtureKey][channel] = raws.value(channel);
@@ -690,103 +638,54 @@ void DmxEngine::renderCue(const int cueKey, const QList<int> groupKeys, const QH
                 }
             }
         }
-        QSqlQuery effectQuery;
-        effectQuery.prepare("SELECT cue_group_effects.valueitem_key FROM cue_group_effects, effects WHERE cue_group_effects.item_key = :cue AND cue_group_effects.foreignitem_key = :group AND cue_group_effects.valueitem_key = effects.key ORDER BY effects.sortkey");
-        effectQuery.bindValue(":group", groupKey);
-        effectQuery.bindValue(":cue", cueKey);
-        if (effectQuery.exec()) {
-            QList<int> effectKeys;
-            while (effectQuery.next()) {
-                const int effectKey = effectQuery.value(0).toInt();
-                effectKeys.append(effectKey);
-                if (!groupEffectFrames.contains(groupKey)) {
-                    groupEffectFrames[groupKey] = QHash<int, int>();
-                }
-                if (oldGroupEffectFrames.value(groupKey).contains(effectKey)) {
-                    groupEffectFrames[groupKey][effectKey] = oldGroupEffectFrames.value(groupKey).value(effectKey) + 1;
-                } else {
-                    groupEffectFrames[groupKey][effectKey] = 1;
-                }
+        for (const int effectKey : cueGroup.effectKeys) {
+            if (!groupEffectFrames.contains(groupKey)) {
+                groupEffectFrames[groupKey] = QHash<int, int>();
             }
-            for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
-                bool intensityInformation = false;
-                float intensity = 0;
-                bool colorInformation = false;
-                ColorData color;
-                bool positionInformation = false;
-                PositionData position;
-                QHash<int, RawChannelData> raws;
-                getFixtureEffects(fixtureKey, effectKeys, groupEffectFrames.value(groupKey), &intensityInformation, &intensity, &colorInformation, &color, &positionInformation, &position, &raws);
-                if (intensityInformation && (intensity > fixtureIntensities->value(fixtureKey, 0))) {
-                    (*fixtureIntensities)[fixtureKey] = intensity;
-                }
-                if (colorInformation) {
-                    (*fixtureColors)[fixtureKey] = color;
-                }
-                if (positionInformation) {
-                    (*fixturePositions)[fixtureKey] = position;
-                }
-                if (!raws.isEmpty()) {
-                    if (fixtureRaws->contains(fixtureKey)) {
-                        for (const int channel : raws.keys()) {
-                            (*fixtureRaws)[fixtureKey][channel] = raws.value(channel);
-                        }
-                    } else {
-                        (*fixtureRaws)[fixtureKey] = raws;
+            if (oldGroupEffectFrames.value(groupKey).contains(effectKey)) {
+                groupEffectFrames[groupKey][effectKey] = oldGroupEffectFrames.value(groupKey).value(effectKey) + 1;
+            } else {
+                groupEffectFrames[groupKey][effectKey] = 1;
+            }
+        }
+        for (const int fixtureKey : groupFixtureKeys.value(groupKey)) {
+            bool intensityInformation = false;
+            float intensity = 0;
+            bool colorInformation = false;
+            ColorData color;
+            bool positionInformation = false;
+            PositionData position;
+            QHash<int, RawChannelData> raws;
+            getFixtureEffects(fixtureKey, cueGroup.effectKeys, groupEffectFrames.value(groupKey), &intensityInformation, &intensity, &colorInformation, &color, &positionInformation, &position, &raws);
+            if (intensityInformation && (intensity > fixtureIntensities->value(fixtureKey, 0))) {
+                (*fixtureIntensities)[fixtureKey] = intensity;
+            }
+            if (colorInformation) {
+                (*fixtureColors)[fixtureKey] = color;
+            }
+            if (positionInformation) {
+                (*fixturePositions)[fixtureKey] = position;
+            }
+            if (!raws.isEmpty()) {
+                if (fixtureRaws->contains(fixtureKey)) {
+                    for (const int channel : raws.keys()) {
+                        (*fixtureRaws)[fixtureKey][channel] = raws.value(channel);
                     }
+                } else {
+                    (*fixtureRaws)[fixtureKey] = raws;
                 }
             }
-        } else {
-            qWarning() << Q_FUNC_INFO << effectQuery.executedQuery() << effectQuery.lastError().text();
         }
     }
 }
 
-float DmxEngine::getFixtureValue(const int fixtureKey, const int itemKey, const QString itemTable, const QString itemTableAttribute, const QString modelExceptionTable, const QString fixtureExceptionTable) {
-    QSqlQuery fixtureExceptionQuery;
-    fixtureExceptionQuery.prepare("SELECT value FROM " + fixtureExceptionTable + " WHERE item_key = :item AND foreignitem_key = :fixture");
-    fixtureExceptionQuery.bindValue(":item", itemKey);
-    fixtureExceptionQuery.bindValue(":fixture", fixtureKey);
-    if (fixtureExceptionQuery.exec()) {
-        if (fixtureExceptionQuery.next()) {
-            return fixtureExceptionQuery.value(0).toFloat();
-        }
-    } else {
-        qWarning() << Q_FUNC_INFO << fixtureExceptionQuery.executedQuery() << fixtureExceptionQuery.lastError().text();
-    }
-    QSqlQuery modelExceptionQuery;
-    modelExceptionQuery.prepare("SELECT " + modelExceptionTable + ".value FROM " + modelExceptionTable + ", fixtures WHERE " + modelExceptionTable + ".item_key = :item AND " + modelExceptionTable + ".foreignitem_key = fixtures.model_key AND fixtures.key = :fixture");
-    modelExceptionQuery.bindValue(":item", itemKey);
-    modelExceptionQuery.bindValue(":fixture", fixtureKey);
-    if (modelExceptionQuery.exec()) {
-        if (modelExceptionQuery.next()) {
-            return modelExceptionQuery.value(0).toFloat();
-        }
-    } else {
-        qWarning() << Q_FUNC_INFO << modelExceptionQuery.executedQuery() << modelExceptionQuery.lastError().text();
-    }
-    QSqlQuery itemQuery;
-    itemQuery.prepare("SELECT " + itemTableAttribute + " FROM " + itemTable + " WHERE key = :item");
-    itemQuery.bindValue(":item", itemKey);
-    if (itemQuery.exec()) {
-        if (itemQuery.next()) {
-            return itemQuery.value(0).toFloat();
-        } else {
-            qWarning() << Q_FUNC_INFO << itemQuery.executedQuery() << itemTable + " Item with key " + QString::number(itemKey) + " should exist but wasn't found!";
-        }
-    } else {
-        qWarning() << Q_FUNC_INFO << itemQuery.executedQuery() << itemQuery.lastError().text();
-    }
-    return 0;
-}
-
 float DmxEngine::getFixtureIntensity(const int fixtureKey, const int intensityKey) {
-    return getFixtureValue(fixtureKey, intensityKey, "intensities", "dimmer", "intensity_model_dimmer", "intensity_fixture_dimmer");
+    return cache->getFixtureValue(fixtureKey, intensityKey, "intensities", "dimmer", "intensity_model_dimmer", "intensity_fixture_dimmer");
 }
 
 DmxEngine::ColorData DmxEngine::getFixtureColor(const int fixtureKey, const int colorKey) {
-    const float hue = getFixtureValue(fixtureKey, colorKey, "colors", "hue", "color_model_hue", "color_fixture_hue");
-    const float saturation = getFixtureValue(fixtureKey, colorKey, "colors", "saturation", "color_model_saturation", "color_fixture_saturation");
+    const float hue = cache->getFixtureValue(fixtureKey, colorKey, "colors", "hue", "color_model_hue", "color_fixture_hue");
+    const float saturation = cache->getFixtureValue(fixtureKey, colorKey, "colors", "saturation", "color_model_saturation", "color_fixture_saturation");
     ColorData color;
     const float h = (hue / 60);
     const int i = (int)h;
@@ -819,86 +718,28 @@ DmxEngine::ColorData DmxEngine::getFixtureColor(const int fixtureKey, const int
         color.green = p;
         color.blue = q;
     }
-    color.quality = getFixtureValue(fixtureKey, colorKey, "colors", "quality", "color_model_quality", "color_fixture_quality");
+    color.quality = cache->getFixtureValue(fixtureKey, colorKey, "colors", "quality", "color_model_quality", "color_fixture_quality");
     return color;
 }
 
 DmxEngine::PositionData DmxEngine::getFixturePosition(const int fixtureKey, const int positionKey) {
     PositionData position;
-    position.pan = getFixtureValue(fixtureKey, positionKey, "positions", "pan", "position_model_pan", "position_fixture_pan");
-    position.tilt = getFixtureValue(fixtureKey, positionKey, "positions", "tilt", "position_model_tilt", "position_fixture_tilt");
-    position.zoom = getFixtureValue(fixtureKey, positionKey, "positions", "zoom", "position_model_zoom", "position_fixture_zoom");
-    position.focus = getFixtureValue(fixtureKey, positionKey, "positions", "focus", "position_model_focus", "position_fixture_focus");
+    position.pan = cache->getFixtureValue(fixtureKey, positionKey, "positions", "pan", "position_model_pan", "position_fixture_pan");
+    position.tilt = cache->getFixtureValue(fixtureKey, positionKey, "positions", "tilt", "position_model_tilt", "position_fixture_tilt");
+    position.zoom = cache->getFixtureValue(fixtureKey, positionKey, "positions", "zoom", "position_model_zoom", "position_fixture_zoom");
+    position.focus = cache->getFixtureValue(fixtureKey, positionKey, "positions", "focus", "position_model_focus", "position_fixture_focus");
     return position;
 }
 
 QHash<int, DmxEngine::RawChannelData> DmxEngine::getFixtureRaws(const int fixtureKey, const QList<int> rawKeys) {
     QHash<int, RawChannelData> channels;
     for (const int rawKey : rawKeys) {
-        bool fading = false;
-        bool moveWhileDark = false;
-        QSqlQuery rawAttributesQuery;
-        rawAttributesQuery.prepare("SELECT fade, movewhiledark FROM raws WHERE key = :raw");
-        rawAttributesQuery.bindValue(":raw", rawKey);
-        if (rawAttributesQuery.exec()) {
-            if (rawAttributesQuery.next()) {
-                fading = (rawAttributesQuery.value(0).toInt() == 1);
-                moveWhileDark = (rawAttributesQuery.value(1).toInt() == 1);
-            } else {
-                qWarning() << Q_FUNC_INFO << rawAttributesQuery.executedQuery() << "Raw with key " + QString::number(rawKey) + " should exist but wasn't found!";
-            }
-        } else {
-            qWarning() << Q_FUNC_INFO << rawAttributesQuery.executedQuery() << rawAttributesQuery.lastError().text();
-        }
-        QSqlQuery itemQuery;
-        itemQuery.prepare("SELECT key, value FROM raw_channel_values WHERE item_key = :raw");
-        itemQuery.bindValue(":raw", rawKey);
-        if (itemQuery.exec()) {
-            while (itemQuery.next()) {
-                const int channel = itemQuery.value(0).toInt();
-                if (!channels.contains(channel)) {
-                    channels[channel] = RawChannelData();
-                }
-                channels[channel].value = itemQuery.value(1).toUInt();
-                channels[channel].fading = fading;
-                channels[channel].moveWhileDark = moveWhileDark;
-            }
-        } else {
-            qWarning() << Q_FUNC_INFO << itemQuery.executedQuery() << itemQuery.lastError().text();
-        }
-        QSqlQuery modelExceptionQuery;
-        modelExceptionQuery.prepare("SELECT raw_model_channel_values.key, raw_model_channel_values.value FROM raw_model_channel_values, fixtures WHERE raw_model_channel_values.item_key = :raw AND raw_model_channel_values.foreignitem_key = fixtures.model_key AND fixtures.key = :fixture");
-        modelExceptionQuery.bindValue(":raw", rawKey);
-        modelExceptionQuery.bindValue(":fixture", fixtureKey);
-        if (modelExceptionQuery.exec()) {
-            while (modelExceptionQuery.next()) {
-                const int channel = modelExceptionQuery.value(0).toInt();
-                if (!channels.contains(channel)) {
-                    channels[channel] = RawChannelData();
-                }
-                channels[channel].value = (uint8_t)modelExceptionQuery.value(1).toUInt();
-                channels[channel].fading = fading;
-                channels[channel].moveWhileDark = moveWhileDark;
-            }
-        } else {
-            qWarning() << Q_FUNC_INFO << modelExceptionQuery.executedQuery() << modelExceptionQuery.lastError().text();
-        }
-        QSqlQuery fixtureExceptionQuery;
-        fixtureExceptionQuery.prepare("SELECT key, value FROM raw_fixture_channel_values WHERE item_key = :raw AND foreignitem_key = :fixture");
-        fixtureExceptionQuery.bindValue(":raw", rawKey);
-        fixtureExceptionQuery.bindValue(":fixture", fixtureKey);
-        if (fixtureExceptionQuery.exec()) {
-            while (fixtureExceptionQuery.next()) {
-                const int channel = fixtureExceptionQuery.value(0).toInt();
-                if (!channels.contains(channel)) {
-                    channels[channel] = RawChannelData();
-                }
-                channels[channel].value = (uint8_t)fixtureExceptionQuery.value(1).toUInt();
-                channels[channel].fading = fading;
-                channels[channel].moveWhileDark = moveWhileDark;
-            }
-        } else {
-            qWarning() << Q_FUNC_INFO << fixtureExceptionQuery.executedQuery() << fixtureExceptionQuery.lastError().text();
+        const EngineCache::Raw raw = cache->getFixtureRaw(fixtureKey, rawKey);
+        for (QHash<int, uint8_t>::const_iterator channelValue = raw.channelValues.constBegin(); channelValue != raw.channelValues.constEnd(); channelValue++) {
+            RawChannelData& channel = channels[channelValue.key()];
+            channel.value = channelValue.value();
+            channel.fading = raw.fading;
+            channel.moveWhileDark = raw.moveWhileDark;
         }
     }
     return channels;
@@ -906,242 +747,135 @@ QHash<int, DmxEngine::RawChannelData> DmxEngine::getFixtureRaws(const int fixtur
 
 void DmxEngine::getFixtureEffects(const int fixtureKey, const QList<int> effectKeys, const QHash<int, int> effectFrames, bool* intensityInformation, float* dimmer, bool* colorInformation, ColorData* color, bool* positionInformation, PositionData* position, QHash<int, RawChannelData>* raws) {
     for (const int effectKey : effectKeys) {
-        QSqlQuery effectAttributesQuery;
-        effectAttributesQuery.prepare("SELECT steps, hold, fade, phase, sinefade FROM effects WHERE key = :effect");
-        effectAttributesQuery.bindValue(":effect", effectKey);
-        if (effectAttributesQuery.exec()) {
-            if (effectAttributesQuery.next()) {
-                const int stepAmount = effectAttributesQuery.value(0).toInt();
-                const int standardHoldFrames = (effectAttributesQuery.value(1).toFloat() * 1000 / FRAMEDURATION);
-                const int standardFadeFrames = (effectAttributesQuery.value(2).toFloat() * 1000 / FRAMEDURATION);
-                float phase = effectAttributesQuery.value(3).toFloat();
-                const bool sineFade = (effectAttributesQuery.value(4).toInt() == 1);
-                QHash<int, int> stepHoldFrames;
-                QSqlQuery stepHoldQuery;
-                stepHoldQuery.prepare("SELECT key, value FROM effect_step_hold WHERE item_key = :effect");
-                stepHoldQuery.bindValue(":effect", effectKey);
-                if (stepHoldQuery.exec()) {
-                    while (stepHoldQuery.next()) {
-                        const int step = stepHoldQuery.value(0).toInt();
-                        if (step <= stepAmount) {
-                            stepHoldFrames[step] = (stepHoldQuery.value(1).toFloat() * 1000 / FRAMEDURATION);
-                        }
-                    }
-                } else {
-                    qWarning() << Q_FUNC_INFO << stepHoldQuery.executedQuery() << stepHoldQuery.lastError().text();
+        const EngineCache::Effect effect = cache->getEffect(effectKey);
+        if (effect.exists && (effect.totalFrames > 0)) {
+            const int stepAmount = effect.stepAmount;
+            const int standardHoldFrames = effect.standardHoldFrames;
+            const int standardFadeFrames = effect.standardFadeFrames;
+            const QHash<int, int>& stepHoldFrames = effect.stepHoldFrames;
+            const QHash<int, int>& stepFadeFrames = effect.stepFadeFrames;
+            const QHash<int, int>& stepIntensityKeys = effect.stepIntensityKeys;
+            const QHash<int, int>& stepColorKeys = effect.stepColorKeys;
+            const QHash<int, int>& stepPositionKeys = effect.stepPositionKeys;
+            const QHash<int, QList<int>>& stepRawKeys = effect.stepRawKeys;
+            const int totalFrames = effect.totalFrames;
+            const float phase = cache->getEffectPhase(effectKey, fixtureKey);
+            int frames = (int)(effectFrames.value(effectKey, 0) + (phase / 360) * totalFrames) % totalFrames;
+            int currentStep = 1;
+            float fade = 1;
+            for (int step = 1; step <= stepAmount; step++) {
+                if ((frames > 0) && (stepFadeFrames.value(step, standardFadeFrames) > 0)) {
+                    currentStep = step;
+                    fade = 1 - (float)frames / (float)stepFadeFrames.value(step, standardFadeFrames);
+                }
+                frames -= stepFadeFrames.value(step, standardFadeFrames);
+                if (frames > 0) {
+                    currentStep = step;
+                    fade = 0;
+                }
+                frames -= stepHoldFrames.value(step, standardHoldFrames);
+            }
+            int lastStep = currentStep - 1;
+            if (lastStep < 1) {
+                lastStep = stepAmount;
+            }
+            if (effect.sineFade) {
+                fade = std::cos(M_PI * (1 - fade)) / 2 + 0.5;
+            }
+            if (!stepIntensityKeys.isEmpty()) {
+                (*intensityInformation) = true;
+                float currentDimmer = 0;
+                if (stepIntensityKeys.contains(currentStep)) {
+                    currentDimmer = getFixtureIntensity(fixtureKey, stepIntensityKeys.value(currentStep));
                 }
-                QHash<int, int> stepFadeFrames;
-                QSqlQuery stepFadeQuery;
-                stepFadeQuery.prepare("SELECT key, value FROM effect_step_fade WHERE item_key = :effect");
-                stepFadeQuery.bindValue(":effect", effectKey);
-                if (stepFadeQuery.exec()) {
-                    while (stepFadeQuery.next()) {
-                        const int step = stepFadeQuery.value(0).toInt();
-                        if (step <= stepAmount) {
-                            stepFadeFrames[step] = (stepFadeQuery.value(1).toFloat() * 1000 / FRAMEDURATION);
-                        }
+                if (fade > 0) {
+                    float lastDimmer = 0;
+                    if (stepIntensityKeys.contains(lastStep)) {
+                        lastDimmer = getFixtureIntensity(fixtureKey, stepIntensityKeys.value(lastStep));
                     }
-                } else {
-                    qWarning() << Q_FUNC_INFO << stepFadeQuery.executedQuery() << stepFadeQuery.lastError().text();
+                    currentDimmer += (lastDimmer - currentDimmer) * fade;
                 }
-                int totalFrames = 0;
-                for (int step = 1; step <= stepAmount; step++) {
-                    totalFrames += stepHoldFrames.value(step, standardHoldFrames);
-                    totalFrames += stepFadeFrames.value(step, standardFadeFrames);
+                if (currentDimmer >= (*dimmer)) {
+                    (*dimmer) = currentDimmer;
                 }
-                if (totalFrames > 0) {
-                    QSqlQuery fixturePhaseQuery;
-                    fixturePhaseQuery.prepare("SELECT value FROM effect_fixture_phase WHERE item_key = :effect AND foreignitem_key = :fixture");
-                    fixturePhaseQuery.bindValue(":effect", effectKey);
-                    fixturePhaseQuery.bindValue(":fixture", fixtureKey);
-                    if (fixturePhaseQuery.exec()) {
-                        if (fixturePhaseQuery.next()) {
-                            phase = fixturePhaseQuery.value(0).toFloat();
-                        }
-                    } else {
-                        qWarning() << Q_FUNC_INFO << fixturePhaseQuery.executedQuery() << fixturePhaseQuery.lastError().text();
-                    }
-                    QHash<int, int> stepIntensityKeys;
-                    QSqlQuery intensityStepQuery;
-                    intensityStepQuery.prepare("SELECT key, valueitem_key FROM effect_step_intensities WHERE item_key = :effect");
-                    intensityStepQuery.bindValue(":effect", effectKey);
-                    if (intensityStepQuery.exec()) {
-                        while (intensityStepQuery.next()) {
-                            const int step = intensityStepQuery.value(0).toInt();
-                            if (step <= stepAmount) {
-                                stepIntensityKeys[step] = intensityStepQuery.value(1).toInt();
-                            }
-                        }
-                    } else {
-                        qWarning() << Q_FUNC_INFO << intensityStepQuery.executedQuery() << intensityStepQuery.lastError().text();
-                    }
-                    QHash<int, int> stepColorKeys;
-                    QSqlQuery colorStepQuery;
-                    colorStepQuery.prepare("SELECT key, valueitem_key FROM effect_step_colors WHERE item_key = :effect");
-                    colorStepQuery.bindValue(":effect", effectKey);
-                    if (colorStepQuery.exec()) {
-                        while (colorStepQuery.next()) {
-                            const int step = colorStepQuery.value(0).toInt();
-                            if (step <= stepAmount) {
-                                stepColorKeys[step] = colorStepQuery.value(1).toInt();
-                            }
-                        }
-                    } else {
-                        qWarning() << Q_FUNC_INFO << colorStepQuery.executedQuery() << colorStepQuery.lastError().text();
-                    }
-                    QHash<int, int> stepPositionKeys;
-                    QSqlQuery positionStepQuery;
-                    positionStepQuery.prepare("SELECT key, valueitem_key FROM effect_step_positions WHERE item_key = :effect");
-                    positionStepQuery.bindValue(":effect", effectKey);
-                    if (positionStepQuery.exec()) {
-                        while (positionStepQuery.next()) {
-                            const int step = positionStepQuery.value(0).toInt();
-                            if (step <= stepAmount) {
-                                stepPositionKeys[step] = positionStepQuery.value(1).toInt();
-                            }
-                        }
-                    } else {
-                        qWarning() << Q_FUNC_INFO << positionStepQuery.executedQuery() << positionStepQuery.lastError().text();
-                    }
-                    QHash<int, QList<int>> stepRawKeys;
-                    QSqlQuery rawStepQuery;
-                    rawStepQuery.prepare("SELECT effect_step_raws.key, effect_step_raws.valueitem_key FROM effect_step_raws, raws WHERE effect_step_raws.item_key = :effect AND effect_step_raws.valueitem_key = raws.key ORDER BY raws.sortkey");
-                    rawStepQuery.bindValue(":effect", effectKey);
-                    if (rawStepQuery.exec()) {
-                        while (rawStepQuery.next()) {
-                            const int step = rawStepQuery.value(0).toInt();
-                            if (step <= stepAmount) {
-                                if (!stepRawKeys.contains(step)) {
-                                    stepRawKeys[step] = QList<int>();
-                                }
-                                stepRawKeys[step].append(rawStepQuery.value(1).toInt());
-                            }
-                        }
-                    } else {
-                        qWarning() << Q_FUNC_INFO << rawStepQuery.executedQuery() << rawStepQuery.lastError().text();
-                    }
-                    int frames = (int)(effectFrames.value(effectKey, 0) + (phase / 360) * totalFrames) % totalFrames;
-                    int currentStep = 1;
-                    float fade = 1;
-                    for (int step = 1; step <= stepAmount; step++) {
-                        if ((frames > 0) && (stepFadeFrames.value(step, standardFadeFrames) > 0)) {
-                            currentStep = step;
-                            fade = 1 - (float)frames / (float)stepFadeFrames.value(step, standardFadeFrames);
-                        }
-                        frames -= stepFadeFrames.value(step, standardFadeFrames);
-                        if (frames > 0) {
-                            currentStep = step;
-                            fade = 0;
+            }
+            if (!stepColorKeys.isEmpty()) {
+                (*colorInformation) = true;
+                ColorData currentColor;
+                if (stepColorKeys.contains(currentStep)) {
+                    currentColor = getFixtureColor(fixtureKey, stepColorKeys.value(currentStep));
+                }
+                if (fade > 0) {
+                    ColorData lastColor;
+                    if (stepColorKeys.contains(lastStep)) {
+                        lastColor = getFixtureColor(fixtureKey, stepColorKeys.value(lastStep));
+                    }
+                    currentColor.red += (lastColor.red - currentColor.red) * fade;
+                    currentColor.green += (lastColor.green - currentColor.green) * fade;
+                    currentColor.blue += (lastColor.blue - currentColor.blue) * fade;
+                    currentColor.quality += (lastColor.quality - currentColor.quality) * fade;
+                }
+                (*color) = currentColor;
+            }
+            if (!stepPositionKeys.isEmpty()) {
+                (*positionInformation) = true;
+                PositionData currentPosition;
+                if (stepPositionKeys.contains(currentStep)) {
+                    currentPosition = getFixturePosition(fixtureKey, stepPositionKeys.value(currentStep));
+                }
+                if (fade > 0) {
+                    PositionData lastPosition;
+                    if (stepPositionKeys.contains(lastStep)) {
+                        lastPosition = getFixturePosition(fixtureKey, stepPositionKeys.value(lastStep));
+                    }
+                    if (std::abs(currentPosition.pan - lastPosition.pan) > 180) {
+                        if (lastPosition.pan > currentPosition.pan) {
+                            currentPosition.pan += 360;
+                        } else {
+                            lastPosition.pan += 360;
                         }
-                        frames -= stepHoldFrames.value(step, standardHoldFrames);
-                    }
-                    int lastStep = currentStep - 1;
-                    if (lastStep < 1) {
-                        lastStep = stepAmount;
                     }
-                    if (sineFade) {
-                        fade = std::cos(M_PI * (1 - fade)) / 2 + 0.5;
+                    currentPosition.pan += (lastPosition.pan - currentPosition.pan) * fade;
+                    while (currentPosition.pan >= 360) {
+                        currentPosition.pan -= 360;
                     }
-                    if (!stepIntensityKeys.isEmpty()) {
-                        (*intensityInformation) = true;
-                        float currentDimmer = 0;
-                        if (stepIntensityKeys.contains(currentStep)) {
-                            currentDimmer = getFixtureIntensity(fixtureKey, stepIntensityKeys.value(currentStep));
-                        }
-                        if (fade > 0) {
-                            float lastDimmer = 0;
-                            if (stepIntensityKeys.contains(lastStep)) {
-                                lastDimmer = getFixtureIntensity(fixtureKey, stepIntensityKeys.value(lastStep));
+                    currentPosition.tilt += (lastPosition.tilt - currentPosition.tilt) * fade;
+                    currentPosition.zoom += (lastPosition.zoom - currentPosition.zoom) * fade;
+                    currentPosition.focus += (lastPosition.focus - currentPosition.focus) * fade;
+                }
+                (*position) = currentPosition;
+            }
+            if (!stepRawKeys.isEmpty()) {
+                QHash<int, RawChannelData> currentRaws;
+                QHash<int, RawChannelData> lastRaws;
+                for (int step = 1; step <= stepAmount; step++) {
+                    if (stepRawKeys.contains(step)) {
+                        const QHash<int, RawChannelData> stepRaws = getFixtureRaws(fixtureKey, stepRawKeys.value(step));
+                        for (const int channel : stepRaws.keys()) {
+                            if (step == currentStep) {
+                                currentRaws[channel] = stepRaws.value(channel);
+                            } else if (!currentRaws.contains(channel)) {
+                                currentRaws[channel] = RawChannelData();
                             }
-                            currentDimmer += (lastDimmer - currentDimmer) * fade;
                         }
-                        if (currentDimmer >= (*dimmer)) {
-                            (*dimmer) = currentDimmer;
+                        if (step == lastStep) {
+                            lastRaws = stepRaws;
                         }
                     }
-                    if (!stepColorKeys.isEmpty()) {
-                        (*colorInformation) = true;
-                        ColorData currentColor;
-                        if (stepColorKeys.contains(currentStep)) {
-                            currentColor = getFixtureColor(fixtureKey, stepColorKeys.value(currentStep));
-                        }
-                        if (fade > 0) {
-                            ColorData lastColor;
-                            if (stepColorKeys.contains(lastStep)) {
-                                lastColor = getFixtureColor(fixtureKey, stepColorKeys.value(lastStep));
-                            }
-                            currentColor.red += (lastColor.red - currentColor.red) * fade;
-                            currentColor.green += (lastColor.green - currentColor.green) * fade;
-                            currentColor.blue += (lastColor.blue - currentColor.blue) * fade;
-                            currentColor.quality += (lastColor.quality - currentColor.quality) * fade;
-                        }
-                        (*color) = currentColor;
-                    }
-                    if (!stepPositionKeys.isEmpty()) {
-                        (*positionInformation) = true;
-                        PositionData currentPosition;
-                        if (stepPositionKeys.contains(currentStep)) {
-                            currentPosition = getFixturePosition(fixtureKey, stepPositionKeys.value(currentStep));
-                        }
-                        if (fade > 0) {
-                            PositionData lastPosition;
-                            if (stepPositionKeys.contains(lastStep)) {
-                                lastPosition = getFixturePosition(fixtureKey, stepPositionKeys.value(lastStep));
-                            }
-                            if (std::abs(currentPosition.pan - lastPosition.pan) > 180) {
-                                if (lastPosition.pan > currentPosition.pan) {
-                                    currentPosition.pan += 360;
-                                } else {
-                                    lastPosition.pan += 360;
-                                }
-                            }
-                            currentPosition.pan += (lastPosition.pan - currentPosition.pan) * fade;
-                            while (currentPosition.pan >= 360) {
-                                currentPosition.pan -= 360;
-                            }
-                            currentPosition.tilt += (lastPosition.tilt - currentPosition.tilt) * fade;
-                            currentPosition.zoom += (lastPosition.zoom - currentPosition.zoom) * fade;
-                            currentPosition.focus += (lastPosition.focus - currentPosition.focus) * fade;
-                        }
-                        (*position) = currentPosition;
-                    }
-                    if (!stepRawKeys.isEmpty()) {
-                        QHash<int, RawChannelData> currentRaws;
-                        QHash<int, RawChannelData> lastRaws;
-                        for (int step = 1; step <= stepAmount; step++) {
-                            if (stepRawKeys.contains(step)) {
-                                const QHash<int, RawChannelData> stepRaws = getFixtureRaws(fixtureKey, stepRawKeys.value(step));
-                                for (const int channel : stepRaws.keys()) {
-                                    if (step == currentStep) {
-                                        currentRaws[channel] = stepRaws.value(channel);
-                                    } else if (!currentRaws.contains(channel)) {
-                                        currentRaws[channel] = RawChannelData();
-                                    }
-                                }
-                                if (step == lastStep) {
-                                    lastRaws = stepRaws;
-                                }
-                            }
-                        }
-                        if (fade > 0) {
-                            for (const int channel : currentRaws.keys()) {
-                                if (currentRaws.value(channel).fading) {
-                                    RawChannelData channelData = currentRaws.value(channel);
-                                    channelData.value += (lastRaws.value(channel, RawChannelData()).value - currentRaws.value(channel, RawChannelData()).value) * fade;
-                                    currentRaws[channel] = channelData;
-                                }
-                            }
-                        }
-                        for (const int channel : currentRaws.keys()) {
-                            (*raws)[channel] = currentRaws.value(channel);
+                }
+                if (fade > 0) {
+                    for (const int channel : currentRaws.keys()) {
+                        if (currentRaws.value(channel).fading) {
+                            RawChannelData channelData = currentRaws.value(channel);
+                            channelData.value += (lastRaws.value(channel, RawChannelData()).value - currentRaws.value(channel, RawChannelData()).value) * fade;
+                            currentRaws[channel] = channelData;
                         }
                     }
                 }
-            } else {
-                qWarning() << Q_FUNC_INFO << effectAttributesQuery.executedQuery() << "Effect with key " + QString::number(effectKey) + " should exist but wasn't found!";
+                for (const int channel : currentRaws.keys()) {
+                    (*raws)[channel] = currentRaws.value(channel);
+                }
             }
-        } else {
-            qWarning() << Q_FUNC_INFO << effectAttributesQuery.executedQuery() << effectAttributesQuery.lastError().text();
         }
     }
 }
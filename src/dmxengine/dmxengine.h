@@ -12,12 +12,18 @@
 #include <QtWidgets>
 #include <QtSql>
 
+#include "database/databasenotifier.h"
+#include "database/preparedquery.h"
+#include "dmxengine/enginecache.h"
 #include "preview2d/preview2d.h"
 
 class DmxEngine : public QWidget {
     Q_OBJECT
 public:
     DmxEngine(QWidget* parent = nullptr);
+    void setDatabaseNotifier(DatabaseNotifier* notifier);
+    EngineCache::Statistics takeCacheStatistics();
+    EngineCache* getCache() const;
 private:
     struct ColorData {
         float red = 100;
@@ -48,7 +54,8 @@ private:
     PositionData getFixturePosition(int fixtureKey, int positionKey);
     QHash<int, RawChannelData> getFixtureRaws(int fixtureKey, QList<int> rawKeys);
     void getFixtureEffects(int fixtureKey, QList<int> effectKeys, QHash<int, int> effectFrames, bool* intensityInformation, float* intensity, bool* colorInformation, ColorData* color, bool* PositionInformation, PositionData* position, QHash<int, RawChannelData>* raws);
-    float getFixtureValue(int fixtureKey, int itemKey, QString itemTable, QString itemTableAttribute, QString modelExceptionTable, QString fixtureExceptionTable);
+    EngineCache* cache;
+    DatabaseNotifier* databaseNotifier = nullptr;
     QSettings* settings;
     QPushButton* highlightButton;
     QPushButton* soloButton;
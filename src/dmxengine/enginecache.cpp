@@ -0,0 +1,599 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "enginecache.h"
+
+QDataStream& operator<<(QDataStream& stream, const EngineCache::CueGroup& cueGroup) {
+    return stream << cueGroup.intensityKeys << cueGroup.colorKeys << cueGroup.positionKeys << cueGroup.rawKeys << cueGroup.effectKeys;
+}
+
+QDataStream& operator>>(QDataStream& stream, EngineCache::CueGroup& cueGroup) {
+    return stream >> cueGroup.intensityKeys >> cueGroup.colorKeys >> cueGroup.positionKeys >> cueGroup.rawKeys >> cueGroup.effectKeys;
+}
+
+QDataStream& operator<<(QDataStream& stream, const EngineCache::Effect& effect) {
+    stream << effect.exists << effect.stepAmount << effect.standardHoldFrames << effect.standardFadeFrames << effect.phase << effect.sineFade << effect.totalFrames;
+    return stream << effect.stepHoldFrames << effect.stepFadeFrames << effect.stepIntensityKeys << effect.stepColorKeys << effect.stepPositionKeys << effect.stepRawKeys;
+}
+
+QDataStream& operator>>(QDataStream& stream, EngineCache::Effect& effect) {
+    stream >> effect.exists >> effect.stepAmount >> effect.standardHoldFrames >> effect.standardFadeFrames >> effect.phase >> effect.sineFade >> effect.totalFrames;
+    return stream >> effect.stepHoldFrames >> effect.stepFadeFrames >> effect.stepIntensityKeys >> effect.stepColorKeys >> effect.stepPositionKeys >> effect.stepRawKeys;
+}
+
+QDataStream& operator<<(QDataStream& stream, const EngineCache::Raw& raw) {
+    return stream << raw.fading << raw.moveWhileDark << raw.channelValues;
+}
+
+QDataStream& operator>>(QDataStream& stream, EngineCache::Raw& raw) {
+    return stream >> raw.fading >> raw.moveWhileDark >> raw.channelValues;
+}
+
+EngineCache::EngineCache(const int frameDuration, QObject* parent) : QObject(parent) {
+    FRAMEDURATION = frameDuration;
+}
+
+void EngineCache::setDatabaseNotifier(DatabaseNotifier* notifier) {
+    // Without change notifications every value has to be read from the database again
+    enabled = notifier->isActive();
+    connect(notifier, &DatabaseNotifier::transactionCommitted, this, &EngineCache::invalidate);
+}
+
+EngineCache::CueGroup EngineCache::getCueGroup(const int cueKey, const int groupKey) {
+    if (enabled) {
+        const QHash<int, QHash<int, CueGroup>>::const_iterator cue = cueGroups.constFind(cueKey);
+        if (cue != cueGroups.constEnd()) {
+            const QHash<int, CueGroup>::const_iterator group = cue->constFind(groupKey);
+            if (group != cue->constEnd()) {
+                statistics.hits++;
+                return *group;
+            }
+        }
+    }
+    statistics.misses++;
+    const CueGroup cueGroup = compileCueGroup(cueKey, groupKey);
+    if (enabled) {
+        cueGroups[cueKey][groupKey] = cueGroup;
+    }
+    return cueGroup;
+}
+
+EngineCache::Effect EngineCache::getEffect(const int effectKey) {
+    if (enabled) {
+        const QHash<int, Effect>::const_iterator effect = effects.constFind(effectKey);
+        if (effect != effects.constEnd()) {
+            statistics.hits++;
+            return *effect;
+        }
+    }
+    statistics.misses++;
+    const Effect effect = compileEffect(effectKey);
+    if (enabled) {
+        effects[effectKey] = effect;
+    }
+    return effect;
+}
+
+float EngineCache::getEffectPhase(const int effectKey, const int fixtureKey) {
+    if (enabled) {
+        const QHash<int, QHash<int, float>>::const_iterator effect = effectPhases.constFind(effectKey);
+        if (effect != effectPhases.constEnd()) {
+            const QHash<int, float>::const_iterator phase = effect->constFind(fixtureKey);
+            if (phase != effect->constEnd()) {
+                statistics.hits++;
+                return *phase;
+            }
+        }
+    }
+    statistics.misses++;
+    float phase = getEffect(effectKey).phase;
+    PreparedQuery fixturePhaseQuery("SELECT rowid, value FROM effect_fixture_phase WHERE item_key = :effect AND foreignitem_key = :fixture");
+    fixturePhaseQuery->bindValue(":effect", effectKey);
+    fixturePhaseQuery->bindValue(":fixture", fixtureKey);
+    if (fixturePhaseQuery->exec()) {
+        if (fixturePhaseQuery->next()) {
+            addRow("effect_fixture_phase", fixturePhaseQuery->value(0).toLongLong(), effectKey);
+            phase = fixturePhaseQuery->value(1).toFloat();
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << fixturePhaseQuery->executedQuery() << fixturePhaseQuery->lastError().text();
+    }
+    if (enabled) {
+        effectPhases[effectKey][fixtureKey] = phase;
+    }
+    return phase;
+}
+
+float EngineCache::getFixtureValue(const int fixtureKey, const int itemKey, const QString& itemTable, const QString& itemTableAttribute, const QString& modelExceptionTable, const QString& fixtureExceptionTable) {
+    if (enabled) {
+        const QHash<QString, QHash<int, QHash<int, QHash<QString, float>>>>::const_iterator items = fixtureValues.constFind(itemTable);
+        if (items != fixtureValues.constEnd()) {
+            const QHash<int, QHash<int, QHash<QString, float>>>::const_iterator fixtures = items->constFind(itemKey);
+            if (fixtures != items->constEnd()) {
+                const QHash<int, QHash<QString, float>>::const_iterator attributes = fixtures->constFind(fixtureKey);
+                if (attributes != fixtures->constEnd()) {
+                    const QHash<QString, float>::const_iterator value = attributes->constFind(itemTableAttribute);
+                    if (value != attributes->constEnd()) {
+                        statistics.hits++;
+                        return *value;
+                    }
+                }
+            }
+        }
+    }
+    statistics.misses++;
+    float value = 0;
+    bool found = false;
+    PreparedQuery fixtureExceptionQuery("SELECT rowid, value FROM " + fixtureExceptionTable + " WHERE item_key = :item AND foreignitem_key = :fixture");
+    fixtureExceptionQuery->bindValue(":item", itemKey);
+    fixtureExceptionQuery->bindValue(":fixture", fixtureKey);
+    if (fixtureExceptionQuery->exec()) {
+        if (fixtureExceptionQuery->next()) {
+            addRow(fixtureExceptionTable, fixtureExceptionQuery->value(0).toLongLong(), itemKey);
+            value = fixtureExceptionQuery->value(1).toFloat();
+            found = true;
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << fixtureExceptionQuery->executedQuery() << fixtureExceptionQuery->lastError().text();
+    }
+    if (!found) {
+        PreparedQuery modelExceptionQuery("SELECT " + modelExceptionTable + ".rowid, " + modelExceptionTable + ".value FROM " + modelExceptionTable + ", fixtures WHERE " + modelExceptionTable + ".item_key = :item AND " + modelExceptionTable + ".foreignitem_key = fixtures.model_key AND fixtures.key = :fixture");
+        modelExceptionQuery->bindValue(":item", itemKey);
+        modelExceptionQuery->bindValue(":fixture", fixtureKey);
+        if (modelExceptionQuery->exec()) {
+            if (modelExceptionQuery->next()) {
+                addRow(modelExceptionTable, modelExceptionQuery->value(0).toLongLong(), itemKey);
+                value = modelExceptionQuery->value(1).toFloat();
+                found = true;
+            }
+        } else {
+            qWarning() << Q_FUNC_INFO << modelExceptionQuery->executedQuery() << modelExceptionQuery->lastError().text();
+        }
+    }
+    if (!found) {
+        PreparedQuery itemQuery("SELECT " + itemTableAttribute + " FROM " + itemTable + " WHERE key = :item");
+        itemQuery->bindValue(":item", itemKey);
+        if (itemQuery->exec()) {
+            if (itemQuery->next()) {
+                value = itemQuery->value(0).toFloat();
+            } else {
+                qWarning() << Q_FUNC_INFO << itemQuery->executedQuery() << itemTable + " Item with key " + QString::number(itemKey) + " should exist but wasn't found!";
+            }
+        } else {
+            qWarning() << Q_FUNC_INFO << itemQuery->executedQuery() << itemQuery->lastError().text();
+        }
+    }
+    if (enabled) {
+        fixtureValues[itemTable][itemKey][fixtureKey][itemTableAttribute] = value;
+    }
+    return value;
+}
+
+EngineCache::Raw EngineCache::getFixtureRaw(const int fixtureKey, const int rawKey) {
+    if (enabled) {
+        const QHash<int, QHash<int, Raw>>::const_iterator raw = fixtureRaws.constFind(rawKey);
+        if (raw != fixtureRaws.constEnd()) {
+            const QHash<int, Raw>::const_iterator fixture = raw->constFind(fixtureKey);
+            if (fixture != raw->constEnd()) {
+                statistics.hits++;
+                return *fixture;
+            }
+        }
+    }
+    statistics.misses++;
+    Raw raw;
+    PreparedQuery rawAttributesQuery("SELECT fade, movewhiledark FROM raws WHERE key = :raw");
+    rawAttributesQuery->bindValue(":raw", rawKey);
+    if (rawAttributesQuery->exec()) {
+        if (rawAttributesQuery->next()) {
+            raw.fading = (rawAttributesQuery->value(0).toInt() == 1);
+            raw.moveWhileDark = (rawAttributesQuery->value(1).toInt() == 1);
+        } else {
+            qWarning() << Q_FUNC_INFO << rawAttributesQuery->executedQuery() << "Raw with key " + QString::number(rawKey) + " should exist but wasn't found!";
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << rawAttributesQuery->executedQuery() << rawAttributesQuery->lastError().text();
+    }
+    PreparedQuery itemQuery("SELECT rowid, key, value FROM raw_channel_values WHERE item_key = :raw");
+    itemQuery->bindValue(":raw", rawKey);
+    if (itemQuery->exec()) {
+        while (itemQuery->next()) {
+            addRow("raw_channel_values", itemQuery->value(0).toLongLong(), rawKey);
+            raw.channelValues[itemQuery->value(1).toInt()] = (uint8_t)itemQuery->value(2).toUInt();
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << itemQuery->executedQuery() << itemQuery->lastError().text();
+    }
+    PreparedQuery modelExceptionQuery("SELECT raw_model_channel_values.rowid, raw_model_channel_values.key, raw_model_channel_values.value FROM raw_model_channel_values, fixtures WHERE raw_model_channel_values.item_key = :raw AND raw_model_channel_values.foreignitem_key = fixtures.model_key AND fixtures.key = :fixture");
+    modelExceptionQuery->bindValue(":raw", rawKey);
+    modelExceptionQuery->bindValue(":fixture", fixtureKey);
+    if (modelExceptionQuery->exec()) {
+        while (modelExceptionQuery->next()) {
+            addRow("raw_model_channel_values", modelExceptionQuery->value(0).toLongLong(), rawKey);
+            raw.channelValues[modelExceptionQuery->value(1).toInt()] = (uint8_t)modelExceptionQuery->value(2).toUInt();
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << modelExceptionQuery->executedQuery() << modelExceptionQuery->lastError().text();
+    }
+    PreparedQuery fixtureExceptionQuery("SELECT rowid, key, value FROM raw_fixture_channel_values WHERE item_key = :raw AND foreignitem_key = :fixture");
+    fixtureExceptionQuery->bindValue(":raw", rawKey);
+    fixtureExceptionQuery->bindValue(":fixture", fixtureKey);
+    if (fixtureExceptionQuery->exec()) {
+        while (fixtureExceptionQuery->next()) {
+            addRow("raw_fixture_channel_values", fixtureExceptionQuery->value(0).toLongLong(), rawKey);
+            raw.channelValues[fixtureExceptionQuery->value(1).toInt()] = (uint8_t)fixtureExceptionQuery->value(2).toUInt();
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << fixtureExceptionQuery->executedQuery() << fixtureExceptionQuery->lastError().text();
+    }
+    if (enabled) {
+        fixtureRaws[rawKey][fixtureKey] = raw;
+    }
+    return raw;
+}
+
+EngineCache::Statistics EngineCache::takeStatistics() {
+    const Statistics result = statistics;
+    statistics = Statistics();
+    return result;
+}
+
+EngineCache::CueGroup EngineCache::compileCueGroup(const int cueKey, const int groupKey) {
+    CueGroup cueGroup;
+    const QList<std::tuple<QString, QString, QString, QList<int>*>> attributes = {
+        {"cue_group_intensities", "intensities", "intensity_raws", &cueGroup.intensityKeys},
+        {"cue_group_colors", "colors", "color_raws", &cueGroup.colorKeys},
+        {"cue_group_positions", "positions", "position_raws", &cueGroup.positionKeys},
+    };
+    for (const auto& [valueTable, itemTable, rawTable, itemKeys] : attributes) {
+        PreparedQuery itemQuery("SELECT rowid, valueitem_key FROM " + valueTable + " WHERE item_key = :cue AND foreignitem_key = :group");
+        itemQuery->bindValue(":group", groupKey);
+        itemQuery->bindValue(":cue", cueKey);
+        if (!itemQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << itemQuery->executedQuery() << itemQuery->lastError().text();
+            continue;
+        }
+        while (itemQuery->next()) {
+            addRow(valueTable, itemQuery->value(0).toLongLong(), cueKey);
+            const int itemKey = itemQuery->value(1).toInt();
+            itemKeys->append(itemKey);
+            addDependency(itemTable, itemKey, cueKey);
+            PreparedQuery rawsQuery("SELECT " + rawTable + ".rowid, " + rawTable + ".valueitem_key FROM " + rawTable + ", raws WHERE " + rawTable + ".item_key = :item AND " + rawTable + ".valueitem_key = raws.key ORDER BY raws.sortkey");
+            rawsQuery->bindValue(":item", itemKey);
+            if (rawsQuery->exec()) {
+                while (rawsQuery->next()) {
+                    addRow(rawTable, rawsQuery->value(0).toLongLong(), itemKey);
+                    const int rawKey = rawsQuery->value(1).toInt();
+                    cueGroup.rawKeys.append(rawKey);
+                    addDependency("raws", rawKey, cueKey);
+                }
+            } else {
+                qWarning() << Q_FUNC_INFO << rawsQuery->executedQuery() << rawsQuery->lastError().text();
+            }
+        }
+    }
+    PreparedQuery rawQuery("SELECT cue_group_raws.rowid, cue_group_raws.valueitem_key FROM cue_group_raws, raws WHERE cue_group_raws.item_key = :cue AND cue_group_raws.foreignitem_key = :group AND cue_group_raws.valueitem_key = raws.key ORDER BY raws.sortkey");
+    rawQuery->bindValue(":group", groupKey);
+    rawQuery->bindValue(":cue", cueKey);
+    if (rawQuery->exec()) {
+        while (rawQuery->next()) {
+            addRow("cue_group_raws", rawQuery->value(0).toLongLong(), cueKey);
+            const int rawKey = rawQuery->value(1).toInt();
+            cueGroup.rawKeys.append(rawKey);
+            addDependency("raws", rawKey, cueKey);
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << rawQuery->executedQuery() << rawQuery->lastError().text();
+    }
+    PreparedQuery effectQuery("SELECT cue_group_effects.rowid, cue_group_effects.valueitem_key FROM cue_group_effects, effects WHERE cue_group_effects.item_key = :cue AND cue_group_effects.foreignitem_key = :group AND cue_group_effects.valueitem_key = effects.key ORDER BY effects.sortkey");
+    effectQuery->bindValue(":group", groupKey);
+    effectQuery->bindValue(":cue", cueKey);
+    if (effectQuery->exec()) {
+        while (effectQuery->next()) {
+            addRow("cue_group_effects", effectQuery->value(0).toLongLong(), cueKey);
+            const int effectKey = effectQuery->value(1).toInt();
+            cueGroup.effectKeys.append(effectKey);
+            addDependency("effects", effectKey, cueKey);
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << effectQuery->executedQuery() << effectQuery->lastError().text();
+    }
+    return cueGroup;
+}
+
+EngineCache::Effect EngineCache::compileEffect(const int effectKey) {
+    Effect effect;
+    PreparedQuery effectAttributesQuery("SELECT steps, hold, fade, phase, sinefade FROM effects WHERE key = :effect");
+    effectAttributesQuery->bindValue(":effect", effectKey);
+    if (!effectAttributesQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << effectAttributesQuery->executedQuery() << effectAttributesQuery->lastError().text();
+        return effect;
+    }
+    if (!effectAttributesQuery->next()) {
+        qWarning() << Q_FUNC_INFO << effectAttributesQuery->executedQuery() << "Effect with key " + QString::number(effectKey) + " should exist but wasn't found!";
+        return effect;
+    }
+    effect.exists = true;
+    effect.stepAmount = effectAttributesQuery->value(0).toInt();
+    effect.standardHoldFrames = (effectAttributesQuery->value(1).toFloat() * 1000 / FRAMEDURATION);
+    effect.standardFadeFrames = (effectAttributesQuery->value(2).toFloat() * 1000 / FRAMEDURATION);
+    effect.phase = effectAttributesQuery->value(3).toFloat();
+    effect.sineFade = (effectAttributesQuery->value(4).toInt() == 1);
+    const QList<std::tuple<QString, QHash<int, int>*>> stepTimes = {
+        {"effect_step_hold", &effect.stepHoldFrames},
+        {"effect_step_fade", &effect.stepFadeFrames},
+    };
+    for (const auto& [table, stepFrames] : stepTimes) {
+        PreparedQuery stepQuery("SELECT rowid, key, value FROM " + table + " WHERE item_key = :effect");
+        stepQuery->bindValue(":effect", effectKey);
+        if (!stepQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << stepQuery->executedQuery() << stepQuery->lastError().text();
+            continue;
+        }
+        while (stepQuery->next()) {
+            addRow(table, stepQuery->value(0).toLongLong(), effectKey);
+            const int step = stepQuery->value(1).toInt();
+            if (step <= effect.stepAmount) {
+                (*stepFrames)[step] = (stepQuery->value(2).toFloat() * 1000 / FRAMEDURATION);
+            }
+        }
+    }
+    for (int step = 1; step <= effect.stepAmount; step++) {
+        effect.totalFrames += effect.stepHoldFrames.value(step, effect.standardHoldFrames);
+        effect.totalFrames += effect.stepFadeFrames.value(step, effect.standardFadeFrames);
+    }
+    const QList<std::tuple<QString, QHash<int, int>*>> stepItems = {
+        {"effect_step_intensities", &effect.stepIntensityKeys},
+        {"effect_step_colors", &effect.stepColorKeys},
+        {"effect_step_positions", &effect.stepPositionKeys},
+    };
+    for (const auto& [table, stepKeys] : stepItems) {
+        PreparedQuery stepQuery("SELECT rowid, key, valueitem_key FROM " + table + " WHERE item_key = :effect");
+        stepQuery->bindValue(":effect", effectKey);
+        if (!stepQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << stepQuery->executedQuery() << stepQuery->lastError().text();
+            continue;
+        }
+        while (stepQuery->next()) {
+            addRow(table, stepQuery->value(0).toLongLong(), effectKey);
+            const int step = stepQuery->value(1).toInt();
+            if (step <= effect.stepAmount) {
+                (*stepKeys)[step] = stepQuery->value(2).toInt();
+            }
+        }
+    }
+    PreparedQuery rawStepQuery("SELECT effect_step_raws.rowid, effect_step_raws.key, effect_step_raws.valueitem_key FROM effect_step_raws, raws WHERE effect_step_raws.item_key = :effect AND effect_step_raws.valueitem_key = raws.key ORDER BY raws.sortkey");
+    rawStepQuery->bindValue(":effect", effectKey);
+    if (rawStepQuery->exec()) {
+        while (rawStepQuery->next()) {
+            addRow("effect_step_raws", rawStepQuery->value(0).toLongLong(), effectKey);
+            const int step = rawStepQuery->value(1).toInt();
+            const int rawKey = rawStepQuery->value(2).toInt();
+            if (enabled) {
+                rawEffects[rawKey].insert(effectKey);
+            }
+            if (step <= effect.stepAmount) {
+                effect.stepRawKeys[step].append(rawKey);
+            }
+        }
+    } else {
+        qWarning() << Q_FUNC_INFO << rawStepQuery->executedQuery() << rawStepQuery->lastError().text();
+    }
+    return effect;
+}
+
+void EngineCache::invalidate(const QList<DatabaseNotifier::Change>& changes) {
+    if (!enabled) {
+        return;
+    }
+    for (const DatabaseNotifier::Change& change : changes) {
+        const QString& table = change.table;
+        const qint64 rowId = change.rowId;
+        // Item tables use their key as rowid
+        if ((table == "intensities") || (table == "colors") || (table == "positions")) {
+            fixtureValues[table].remove(rowId);
+        } else if (table == "raws") {
+            // The sortkey of a raw decides the order of the raw channels
+            fixtureRaws.remove(rowId);
+            invalidateCues(table, rowId);
+            for (const int effectKey : rawEffects.take(rowId)) {
+                invalidateEffect(effectKey);
+            }
+        } else if (table == "effects") {
+            invalidateEffect(rowId);
+            invalidateCues(table, rowId);
+        } else if (table == "fixtures") {
+            invalidateFixture(rowId);
+        } else if (table == "cues") {
+            cueGroups.remove(rowId);
+        } else if (table.startsWith("cue_group_")) {
+            invalidateRow(table, change.operation, rowId, [this] (const int cueKey) { cueGroups.remove(cueKey); });
+        } else if ((table == "intensity_raws") || (table == "color_raws") || (table == "position_raws")) {
+            const QString itemTable = (table == "intensity_raws") ? "intensities" : (table == "color_raws") ? "colors" : "positions";
+            invalidateRow(table, change.operation, rowId, [this, itemTable] (const int itemKey) { invalidateCues(itemTable, itemKey); });
+        } else if (table.startsWith("effect_step_")) {
+            invalidateRow(table, change.operation, rowId, [this] (const int effectKey) { invalidateEffect(effectKey); });
+        } else if (table == "effect_fixture_phase") {
+            invalidateRow(table, change.operation, rowId, [this] (const int effectKey) { effectPhases.remove(effectKey); });
+        } else if (table.startsWith("raw_") && table.endsWith("channel_values")) {
+            invalidateRow(table, change.operation, rowId, [this] (const int rawKey) { fixtureRaws.remove(rawKey); });
+        } else if (table.contains("_model_") || table.contains("_fixture_")) {
+            QString itemTable;
+            if (table.startsWith("intensity_")) {
+                itemTable = "intensities";
+            } else if (table.startsWith("color_")) {
+                itemTable = "colors";
+            } else if (table.startsWith("position_")) {
+                itemTable = "positions";
+            } else {
+                continue;
+            }
+            invalidateRow(table, change.operation, rowId, [this, itemTable] (const int itemKey) { fixtureValues[itemTable].remove(itemKey); });
+        }
+    }
+}
+
+void EngineCache::invalidateRow(const QString& table, const DatabaseNotifier::Operation operation, const qint64 rowId, const std::function<void(int)>& invalidateItem) {
+    statistics.invalidations++;
+    // A deleted row can't be read anymore, so its item is only known if the row was loaded before
+    QHash<qint64, int>& items = rowItems[table];
+    const QHash<qint64, int>::iterator loadedItem = items.find(rowId);
+    int oldItemKey = -1;
+    if (loadedItem != items.end()) {
+        oldItemKey = loadedItem.value();
+        items.erase(loadedItem);
+        invalidateItem(oldItemKey);
+    }
+    if (operation == DatabaseNotifier::Delete) {
+        return;
+    }
+    PreparedQuery itemQuery("SELECT item_key FROM " + table + " WHERE rowid = :row");
+    itemQuery->bindValue(":row", rowId);
+    if (!itemQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << itemQuery->executedQuery() << itemQuery->lastError().text();
+        return;
+    }
+    if (itemQuery->next() && (itemQuery->value(0).toInt() != oldItemKey)) {
+        invalidateItem(itemQuery->value(0).toInt());
+    }
+}
+
+void EngineCache::invalidateCues(const QString& itemTable, const int itemKey) {
+    for (const int cueKey : itemCues[itemTable].take(itemKey)) {
+        cueGroups.remove(cueKey);
+    }
+}
+
+void EngineCache::invalidateEffect(const int effectKey) {
+    effects.remove(effectKey);
+    effectPhases.remove(effectKey);
+}
+
+void EngineCache::invalidateFixture(const int fixtureKey) {
+    statistics.invalidations++;
+    for (QHash<int, QHash<int, QHash<QString, float>>>& items : fixtureValues) {
+        for (QHash<int, QHash<QString, float>>& fixtures : items) {
+            fixtures.remove(fixtureKey);
+        }
+    }
+    for (QHash<int, Raw>& fixtures : fixtureRaws) {
+        fixtures.remove(fixtureKey);
+    }
+    for (QHash<int, float>& fixtures : effectPhases) {
+        fixtures.remove(fixtureKey);
+    }
+}
+
+void EngineCache::addDependency(const QString& itemTable, const int itemKey, const int cueKey) {
+    if (enabled) {
+        itemCues[itemTable][itemKey].insert(cueKey);
+    }
+}
+
+void EngineCache::addRow(const QString& table, const qint64 rowId, const int itemKey) {
+    if (enabled) {
+        rowItems[table][rowId] = itemKey;
+    }
+}
+
+bool EngineCache::isSnapshotValid(const QString& snapshotFileName, const QString& fileName, const QString& fileVersion) {
+    QFile snapshotFile(snapshotFileName);
+    if (!snapshotFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    // Changes that aren't merged into the file yet make the snapshot outdated
+    if (QFileInfo(fileName + "-wal").size() > 0) {
+        return false;
+    }
+    QDataStream stream(&snapshotFile);
+    SnapshotHeader header;
+    if (!readSnapshotHeader(stream, &header)) {
+        return false;
+    }
+    const SnapshotHeader fileHeader = getSnapshotHeader(fileName, fileVersion);
+    return (header.fileVersion == fileHeader.fileVersion) && (header.fileSize == fileHeader.fileSize) && (header.fileModified == fileHeader.fileModified);
+}
+
+bool EngineCache::loadSnapshot(const QString& snapshotFileName) {
+    if (!enabled) {
+        return false;
+    }
+    QFile snapshotFile(snapshotFileName);
+    if (!snapshotFile.open(QIODevice::ReadOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << snapshotFileName << snapshotFile.errorString();
+        return false;
+    }
+    uchar* data = snapshotFile.map(0, snapshotFile.size());
+    if (data == nullptr) {
+        qWarning() << Q_FUNC_INFO << "Failed to map" << snapshotFileName << snapshotFile.errorString();
+        return false;
+    }
+    const QByteArray snapshot = QByteArray::fromRawData(reinterpret_cast<const char*>(data), snapshotFile.size());
+    QDataStream stream(snapshot);
+    SnapshotHeader header;
+    bool success = readSnapshotHeader(stream, &header);
+    if (success) {
+        stream >> cueGroups >> effects >> effectPhases >> fixtureValues >> fixtureRaws >> itemCues >> rawEffects >> rowItems;
+        success = (stream.status() == QDataStream::Ok);
+    }
+    snapshotFile.unmap(data);
+    if (!success) {
+        qWarning() << Q_FUNC_INFO << "Failed to read" << snapshotFileName;
+        cueGroups.clear();
+        effects.clear();
+        effectPhases.clear();
+        fixtureValues.clear();
+        fixtureRaws.clear();
+        itemCues.clear();
+        rawEffects.clear();
+        rowItems.clear();
+    }
+    return success;
+}
+
+bool EngineCache::saveSnapshot(const QString& snapshotFileName, const QString& fileName, const QString& fileVersion) {
+    if (!enabled) {
+        return false;
+    }
+    QSaveFile snapshotFile(snapshotFileName);
+    if (!snapshotFile.open(QIODevice::WriteOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << snapshotFileName << snapshotFile.errorString();
+        return false;
+    }
+    QDataStream stream(&snapshotFile);
+    stream.setVersion(QDataStream::Qt_6_0);
+    const SnapshotHeader header = getSnapshotHeader(fileName, fileVersion);
+    stream << header.magic << header.version << header.fileVersion << header.fileSize << header.fileModified;
+    stream << cueGroups << effects << effectPhases << fixtureValues << fixtureRaws << itemCues << rawEffects << rowItems;
+    if ((stream.status() != QDataStream::Ok) || !snapshotFile.commit()) {
+        qWarning() << Q_FUNC_INFO << "Failed to write" << snapshotFileName << snapshotFile.errorString();
+        return false;
+    }
+    return true;
+}
+
+EngineCache::SnapshotHeader EngineCache::getSnapshotHeader(const QString& fileName, const QString& fileVersion) {
+    const QFileInfo fileInfo(fileName);
+    SnapshotHeader header;
+    header.magic = SNAPSHOTMAGIC;
+    header.version = SNAPSHOTVERSION;
+    header.fileVersion = fileVersion;
+    header.fileSize = fileInfo.size();
+    header.fileModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    return header;
+}
+
+bool EngineCache::readSnapshotHeader(QDataStream& stream, SnapshotHeader* header) {
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream >> header->magic >> header->version;
+    if ((stream.status() != QDataStream::Ok) || (header->magic != SNAPSHOTMAGIC) || (header->version != SNAPSHOTVERSION)) {
+        return false;
+    }
+    stream >> header->fileVersion >> header->fileSize >> header->fileModified;
+    return (stream.status() == QDataStream::Ok);
+}
@@ -0,0 +1,99 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINECACHE_H
+#define ENGINECACHE_H
+
+#include <QtCore>
+#include <QtSql>
+
+#include "database/databasenotifier.h"
+#include "database/preparedquery.h"
+
+// Keeps the compiled cues, effects and fixture values of the engine and invalidates only the entries that depend on a changed row
+class EngineCache : public QObject {
+    Q_OBJECT
+public:
+    struct CueGroup {
+        QList<int> intensityKeys;
+        QList<int> colorKeys;
+        QList<int> positionKeys;
+        QList<int> rawKeys;
+        QList<int> effectKeys;
+    };
+    struct Effect {
+        bool exists = false;
+        int stepAmount = 0;
+        int standardHoldFrames = 0;
+        int standardFadeFrames = 0;
+        float phase = 0;
+        bool sineFade = false;
+        int totalFrames = 0;
+        QHash<int, int> stepHoldFrames;
+        QHash<int, int> stepFadeFrames;
+        QHash<int, int> stepIntensityKeys;
+        QHash<int, int> stepColorKeys;
+        QHash<int, int> stepPositionKeys;
+        QHash<int, QList<int>> stepRawKeys;
+    };
+    struct Raw {
+        bool fading = false;
+        bool moveWhileDark = false;
+        QHash<int, uint8_t> channelValues;
+    };
+    struct Statistics {
+        int hits = 0;
+        int misses = 0;
+        int invalidations = 0;
+    };
+    EngineCache(int frameDuration, QObject* parent = nullptr);
+    void setDatabaseNotifier(DatabaseNotifier* notifier);
+    CueGroup getCueGroup(int cueKey, int groupKey);
+    Effect getEffect(int effectKey);
+    float getEffectPhase(int effectKey, int fixtureKey);
+    float getFixtureValue(int fixtureKey, int itemKey, const QString& itemTable, const QString& itemTableAttribute, const QString& modelExceptionTable, const QString& fixtureExceptionTable);
+    Raw getFixtureRaw(int fixtureKey, int rawKey);
+    Statistics takeStatistics();
+    static bool isSnapshotValid(const QString& snapshotFileName, const QString& fileName, const QString& fileVersion);
+    bool loadSnapshot(const QString& snapshotFileName);
+    bool saveSnapshot(const QString& snapshotFileName, const QString& fileName, const QString& fileVersion);
+private:
+    struct SnapshotHeader {
+        quint32 magic = 0;
+        quint32 version = 0;
+        QString fileVersion;
+        qint64 fileSize = 0;
+        qint64 fileModified = 0;
+    };
+    static SnapshotHeader getSnapshotHeader(const QString& fileName, const QString& fileVersion);
+    static bool readSnapshotHeader(QDataStream& stream, SnapshotHeader* header);
+    const static quint32 SNAPSHOTMAGIC = 0x5a464543; // "ZFEC"
+    const static quint32 SNAPSHOTVERSION = 1;
+    void invalidate(const QList<DatabaseNotifier::Change>& changes);
+    void invalidateRow(const QString& table, DatabaseNotifier::Operation operation, qint64 rowId, const std::function<void(int)>& invalidateItem);
+    void invalidateCues(const QString& itemTable, int itemKey);
+    void invalidateEffect(int effectKey);
+    void invalidateFixture(int fixtureKey);
+    void addDependency(const QString& itemTable, int itemKey, int cueKey);
+    void addRow(const QString& table, qint64 rowId, int itemKey);
+    CueGroup compileCueGroup(int cueKey, int groupKey);
+    Effect compileEffect(int effectKey);
+    bool enabled = false;
+    int FRAMEDURATION;
+    QHash<int, QHash<int, CueGroup>> cueGroups; // cue -> group -> items
+    QHash<int, Effect> effects;
+    QHash<int, QHash<int, float>> effectPhases; // effect -> fixture -> phase
+    QHash<QString, QHash<int, QHash<int, QHash<QString, float>>>> fixtureValues; // item table -> item -> fixture -> attribute -> value
+    QHash<int, QHash<int, Raw>> fixtureRaws; // raw -> fixture -> channel values
+    QHash<QString, QHash<int, QSet<int>>> itemCues; // item table -> item -> cues that use it
+    QHash<int, QSet<int>> rawEffects; // raw -> effects that use it
+    QHash<QString, QHash<qint64, int>> rowItems; // value table -> rowid -> item_key of the loaded rows
+    Statistics statistics;
+};
+
+#endif // ENGINECACHE_H
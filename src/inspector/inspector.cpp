@@ -82,101 +82,95 @@ void Inspector::loadItems(const QString itemName, const QStringList ids) {
         titleLabel->setText(title);
         model->setTable(table);
         if (!ids.isEmpty()) {
-            QSqlQuery keyQuery;
-            keyQuery.prepare("SELECT key FROM " + table + " WHERE id = :id");
-            keyQuery.bindValue(":id", ids.last());
-            if (keyQuery.exec()) {
-                if (keyQuery.next()) {
-                    const int key = keyQuery.value(0).toInt();
-                    infos.append(QString(AttributeIds::id) + " ID: " + ids.last());
-                    infos.append(QString(AttributeIds::label) + " Label: " + getTextAttribute(table, "label", key));
-                    if (table == "models") {
-                        infos.append(QString(AttributeIds::modelChannels) + " Channels: " + getTextAttribute(table, "channels", key));
-                        infos.append(QString(AttributeIds::modelPanRange) + " Pan Range: " + getNumberAttribute(table, "panrange", key, "°"));
-                        infos.append(QString(AttributeIds::modelTiltRange) + " Tilt Range: " + getNumberAttribute(table, "tiltrange", key, "°"));
-                        infos.append(QString(AttributeIds::modelMinZoom) + " Minimal Zoom: " + getNumberAttribute(table, "minzoom", key, "°"));
-                        infos.append(QString(AttributeIds::modelMaxZoom) + " Maximal Zoom: " + getNumberAttribute(table, "maxzoom", key, "°"));
-                    } else if (table == "fixtures") {
-                        infos.append(QString(AttributeIds::fixtureModel) + " Model: " + getItemAttribute(table, "model_key", key, "models"));
-                        infos.append(QString(AttributeIds::fixtureUniverse) + " Universe: " + getNumberAttribute(table, "universe", key, ""));
-                        infos.append(QString(AttributeIds::fixtureAddress) + " Address: " + getNumberAttribute(table, "address", key, ""));
-                        infos.append(QString(AttributeIds::fixtureXPosition) + " X Position: " + getNumberAttribute(table, "xposition", key, ""));
-                        infos.append(QString(AttributeIds::fixtureYPosition) + " Y Position: " + getNumberAttribute(table, "yposition", key, ""));
-                        infos.append(QString(AttributeIds::fixtureRotation) + " Rotation: " + getNumberAttribute(table, "rotation", key, "°"));
-                        infos.append(QString(AttributeIds::fixtureInvertPan) + " Invert Pan: " + getBoolAttribute(table, "invertPan", key));
-                    } else if (table == "groups") {
-                        infos.append(QString(AttributeIds::groupFixtures) + " Fixtures: " + getItemListAttribute("fixtures", "group_fixtures", key));
-                    } else if (table == "intensities") {
-                        infos.append(QString(AttributeIds::intensityDimmer) + " Dimmer: " + getNumberAttribute(table, "dimmer", key, "%"));
-                        infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "intensity_model_dimmer", "%", key));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "intensity_fixture_dimmer", "%", key));
-                        infos.append(QString(AttributeIds::intensityRaws) + " Raws: " + getItemListAttribute("raws", "intensity_raws", key));
-                    } else if (table == "colors") {
-                        infos.append(QString(AttributeIds::colorHue) + " Hue: " + getNumberAttribute(table, "hue", key, "°"));
-                        infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "color_model_hue", "°", key));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "color_fixture_hue", "°", key));
-                        infos.append(QString(AttributeIds::colorSaturation) + " Saturation: " + getNumberAttribute(table, "saturation", key, "%"));
-                        infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "color_model_saturation", "%", key));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "color_fixture_saturation", "%", key));
-                        infos.append(QString(AttributeIds::colorQuality) + " Quality: " + getNumberAttribute(table, "quality", key, "%"));
-                        infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "color_model_quality", "%", key));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "color_fixture_quality", "%", key));
-                        infos.append(QString(AttributeIds::colorRaws) + " Raws: " + getItemListAttribute("raws", "color_raws", key));
-                    } else if (table == "positions") {
-                        infos.append(QString(AttributeIds::positionPan) + " Pan: " + getNumberAttribute(table, "pan", key, "°"));
-                        infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "position_model_pan", "°", key));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "position_fixture_pan", "°", key));
-                        infos.append(QString(AttributeIds::positionTilt) + " Tilt: " + getNumberAttribute(table, "tilt", key, "°"));
-                        infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "position_model_tilt", "°", key));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "position_fixture_tilt", "°", key));
-                        infos.append(QString(AttributeIds::positionZoom) + " Zoom: " + getNumberAttribute(table, "zoom", key, "°"));
-                        infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "position_model_zoom", "°", key));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "position_fixture_zoom", "°", key));
-                        infos.append(QString(AttributeIds::positionFocus) + " Focus: " + getNumberAttribute(table, "focus", key, "%"));
-                        infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "position_model_focus", "%", key));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "position_fixture_focus", "%", key));
-                        infos.append(QString(AttributeIds::positionRaws) + " Raws: " + getItemListAttribute("raws", "position_raws", key));
-                    } else if (table == "raws") {
-                        infos.append(QString(AttributeIds::rawChannelValues) + " Channel Values: " + getIntegerSpecificNumberAttribute("raw_channel_values", key, ""));
-                        infos.append("   Model Exceptions: " + getItemAndIntegerSpecificNumberAttribute("models", "raw_model_channel_values", key, ""));
-                        infos.append("   Fixture Exceptions: " + getItemAndIntegerSpecificNumberAttribute("fixtures", "raw_fixture_channel_values", key, ""));
-                        infos.append(QString(AttributeIds::rawMoveWhileDark) + " Move while Dark: " + getBoolAttribute(table, "movewhiledark", key));
-                        infos.append(QString(AttributeIds::rawFade) + " Fade: " + getBoolAttribute(table, "fade", key));
-                    } else if (table == "effects") {
-                        infos.append(QString(AttributeIds::effectSteps) + " Steps: " + getNumberAttribute(table, "steps", key, ""));
-                        infos.append(QString(AttributeIds::effectIntensities) + " Intensities: " + getIntegerSpecificItemListAttribute("intensities", "effect_step_intensities", key));
-                        infos.append(QString(AttributeIds::effectColors) + " Colors: " + getIntegerSpecificItemListAttribute("colors", "effect_step_colors", key));
-                        infos.append(QString(AttributeIds::effectPositions) + " Positions: " + getIntegerSpecificItemListAttribute("positions", "effect_step_positions", key));
-                        infos.append(QString(AttributeIds::effectRaws) + " Raws: " + getIntegerSpecificItemListAttribute("raws", "effect_step_raws", key));
-                        infos.append(QString(AttributeIds::effectHold) + " Hold: " + getNumberAttribute(table, "hold", key, "s"));
-                        infos.append("   Step Exceptions: " + getIntegerSpecificNumberAttribute("effect_step_hold", key, "s"));
-                        infos.append(QString(AttributeIds::effectFade) + " Fade: " + getNumberAttribute(table, "fade", key, "s"));
-                        infos.append("   Step Exceptions: " + getIntegerSpecificNumberAttribute("effect_step_fade", key, "s"));
-                        infos.append(QString(AttributeIds::effectPhase) + " Phase: " + getNumberAttribute(table, "phase", key, "°"));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "effect_fixture_phase", "°", key));
-                        infos.append(QString(AttributeIds::effectSineFade) + " Sine Fade: " + getBoolAttribute(table, "sinefade", key));
-                    } else if (table == "cuelists") {
-                        infos.append(QString(AttributeIds::cuelistPriority) + " Priority: " + getNumberAttribute(table, "priority", key, ""));
-                        infos.append(QString(AttributeIds::cuelistMoveWhileDark) + " Move while Dark: " + getBoolAttribute(table, "movewhiledark", key));
-                    } else if (table == "currentcuelist_cues") {
-                        infos.append(QString(AttributeIds::cueIntensities) + " Intensities: " + getItemSpecificItemListAttribute("groups", "intensities", "cue_group_intensities", key));
-                        infos.append(QString(AttributeIds::cueColors) + " Colors: " + getItemSpecificItemListAttribute("groups", "colors", "cue_group_colors", key));
-                        infos.append(QString(AttributeIds::cuePositions) + " Positions: " + getItemSpecificItemListAttribute("groups", "positions", "cue_group_positions", key));
-                        infos.append(QString(AttributeIds::cueRaws) + " Raws: " + getItemSpecificItemListAttribute("groups", "raws", "cue_group_raws", key));
-                        infos.append(QString(AttributeIds::cueEffects) + " Effects: " + getItemSpecificItemListAttribute("groups", "effects", "cue_group_effects", key));
-                        infos.append(QString(AttributeIds::cueBlock) + " Block: " + getBoolAttribute(table, "block", key));
-                        infos.append(QString(AttributeIds::cueFade) + " Fade: " + getNumberAttribute(table, "fade", key, "s"));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "cue_fixture_fade", "s", key));
-                        infos.append(QString(AttributeIds::cueDelay) + " Delay: " + getNumberAttribute(table, "delay", key, "s"));
-                        infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "cue_fixture_delay", "s", key));
-                        infos.append(QString(AttributeIds::cueFollow) + " Follow: " + getBoolAttribute(table, "follow", key));
-                        infos.append(QString(AttributeIds::cueSineFade) + " Sine Fade: " + getBoolAttribute(table, "sinefade", key));
-                    } else {
-                        Q_ASSERT(false);
-                    }
+            bool keyLoaded = false;
+            const int key = ItemIndex::getKey(table, ids.last(), &keyLoaded);
+            if (keyLoaded && (key >= 0)) {
+                infos.append(QString(AttributeIds::id) + " ID: " + ids.last());
+                infos.append(QString(AttributeIds::label) + " Label: " + getTextAttribute(table, "label", key));
+                if (table == "models") {
+                    infos.append(QString(AttributeIds::modelChannels) + " Channels: " + getTextAttribute(table, "channels", key));
+                    infos.append(QString(AttributeIds::modelPanRange) + " Pan Range: " + getNumberAttribute(table, "panrange", key, "°"));
+                    infos.append(QString(AttributeIds::modelTiltRange) + " Tilt Range: " + getNumberAttribute(table, "tiltrange", key, "°"));
+                    infos.append(QString(AttributeIds::modelMinZoom) + " Minimal Zoom: " + getNumberAttribute(table, "minzoom", key, "°"));
+                    infos.append(QString(AttributeIds::modelMaxZoom) + " Maximal Zoom: " + getNumberAttribute(table, "maxzoom", key, "°"));
+                } else if (table == "fixtures") {
+                    infos.append(QString(AttributeIds::fixtureModel) + " Model: " + getItemAttribute(table, "model_key", key, "models"));
+                    infos.append(QString(AttributeIds::fixtureUniverse) + " Universe: " + getNumberAttribute(table, "universe", key, ""));
+                    infos.append(QString(AttributeIds::fixtureAddress) + " Address: " + getNumberAttribute(table, "address", key, ""));
+                    infos.append(QString(AttributeIds::fixtureXPosition) + " X Position: " + getNumberAttribute(table, "xposition", key, ""));
+                    infos.append(QString(AttributeIds::fixtureYPosition) + " Y Position: " + getNumberAttribute(table, "yposition", key, ""));
+                    infos.append(QString(AttributeIds::fixtureRotation) + " Rotation: " + getNumberAttribute(table, "rotation", key, "°"));
+                    infos.append(QString(AttributeIds::fixtureInvertPan) + " Invert Pan: " + getBoolAttribute(table, "invertPan", key));
+                } else if (table == "groups") {
+                    infos.append(QString(AttributeIds::groupFixtures) + " Fixtures: " + getItemListAttribute("fixtures", "group_fixtures", key));
+                } else if (table == "intensities") {
+                    infos.append(QString(AttributeIds::intensityDimmer) + " Dimmer: " + getNumberAttribute(table, "dimmer", key, "%"));
+                    infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "intensity_model_dimmer", "%", key));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "intensity_fixture_dimmer", "%", key));
+                    infos.append(QString(AttributeIds::intensityRaws) + " Raws: " + getItemListAttribute("raws", "intensity_raws", key));
+                } else if (table == "colors") {
+                    infos.append(QString(AttributeIds::colorHue) + " Hue: " + getNumberAttribute(table, "hue", key, "°"));
+                    infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "color_model_hue", "°", key));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "color_fixture_hue", "°", key));
+                    infos.append(QString(AttributeIds::colorSaturation) + " Saturation: " + getNumberAttribute(table, "saturation", key, "%"));
+                    infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "color_model_saturation", "%", key));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "color_fixture_saturation", "%", key));
+                    infos.append(QString(AttributeIds::colorQuality) + " Quality: " + getNumberAttribute(table, "quality", key, "%"));
+                    infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "color_model_quality", "%", key));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "color_fixture_quality", "%", key));
+                    infos.append(QString(AttributeIds::colorRaws) + " Raws: " + getItemListAttribute("raws", "color_raws", key));
+                } else if (table == "positions") {
+                    infos.append(QString(AttributeIds::positionPan) + " Pan: " + getNumberAttribute(table, "pan", key, "°"));
+                    infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "position_model_pan", "°", key));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "position_fixture_pan", "°", key));
+                    infos.append(QString(AttributeIds::positionTilt) + " Tilt: " + getNumberAttribute(table, "tilt", key, "°"));
+                    infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "position_model_tilt", "°", key));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "position_fixture_tilt", "°", key));
+                    infos.append(QString(AttributeIds::positionZoom) + " Zoom: " + getNumberAttribute(table, "zoom", key, "°"));
+                    infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "position_model_zoom", "°", key));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "position_fixture_zoom", "°", key));
+                    infos.append(QString(AttributeIds::positionFocus) + " Focus: " + getNumberAttribute(table, "focus", key, "%"));
+                    infos.append("   Model Exceptions: " + getItemSpecificNumberAttribute("models", "position_model_focus", "%", key));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "position_fixture_focus", "%", key));
+                    infos.append(QString(AttributeIds::positionRaws) + " Raws: " + getItemListAttribute("raws", "position_raws", key));
+                } else if (table == "raws") {
+                    infos.append(QString(AttributeIds::rawChannelValues) + " Channel Values: " + getIntegerSpecificNumberAttribute("raw_channel_values", key, ""));
+                    infos.append("   Model Exceptions: " + getItemAndIntegerSpecificNumberAttribute("models", "raw_model_channel_values", key, ""));
+                    infos.append("   Fixture Exceptions: " + getItemAndIntegerSpecificNumberAttribute("fixtures", "raw_fixture_channel_values", key, ""));
+                    infos.append(QString(AttributeIds::rawMoveWhileDark) + " Move while Dark: " + getBoolAttribute(table, "movewhiledark", key));
+                    infos.append(QString(AttributeIds::rawFade) + " Fade: " + getBoolAttribute(table, "fade", key));
+                } else if (table == "effects") {
+                    infos.append(QString(AttributeIds::effectSteps) + " Steps: " + getNumberAttribute(table, "steps", key, ""));
+                    infos.append(QString(AttributeIds::effectIntensities) + " Intensities: " + getIntegerSpecificItemListAttribute("intensities", "effect_step_intensities", key));
+                    infos.append(QString(AttributeIds::effectColors) + " Colors: " + getIntegerSpecificItemListAttribute("colors", "effect_step_colors", key));
+                    infos.append(QString(AttributeIds::effectPositions) + " Positions: " + getIntegerSpecificItemListAttribute("positions", "effect_step_positions", key));
+                    infos.append(QString(AttributeIds::effectRaws) + " Raws: " + getIntegerSpecificItemListAttribute("raws", "effect_step_raws", key));
+                    infos.append(QString(AttributeIds::effectHold) + " Hold: " + getNumberAttribute(table, "hold", key, "s"));
+                    infos.append("   Step Exceptions: " + getIntegerSpecificNumberAttribute("effect_step_hold", key, "s"));
+                    infos.append(QString(AttributeIds::effectFade) + " Fade: " + getNumberAttribute(table, "fade", key, "s"));
+                    infos.append("   Step Exceptions: " + getIntegerSpecificNumberAttribute("effect_step_fade", key, "s"));
+                    infos.append(QString(AttributeIds::effectPhase) + " Phase: " + getNumberAttribute(table, "phase", key, "°"));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "effect_fixture_phase", "°", key));
+                    infos.append(QString(AttributeIds::effectSineFade) + " Sine Fade: " + getBoolAttribute(table, "sinefade", key));
+                } else if (table == "cuelists") {
+                    infos.append(QString(AttributeIds::cuelistPriority) + " Priority: " + getNumberAttribute(table, "priority", key, ""));
+                    infos.append(QString(AttributeIds::cuelistMoveWhileDark) + " Move while Dark: " + getBoolAttribute(table, "movewhiledark", key));
+                } else if (table == "currentcuelist_cues") {
+                    infos.append(QString(AttributeIds::cueIntensities) + " Intensities: " + getItemSpecificItemListAttribute("groups", "intensities", "cue_group_intensities", key));
+                    infos.append(QString(AttributeIds::cueColors) + " Colors: " + getItemSpecificItemListAttribute("groups", "colors", "cue_group_colors", key));
+                    infos.append(QString(AttributeIds::cuePositions) + " Positions: " + getItemSpecificItemListAttribute("groups", "positions", "cue_group_positions", key));
+                    infos.append(QString(AttributeIds::cueRaws) + " Raws: " + getItemSpecificItemListAttribute("groups", "raws", "cue_group_raws", key));
+                    infos.append(QString(AttributeIds::cueEffects) + " Effects: " + getItemSpecificItemListAttribute("groups", "effects", "cue_group_effects", key));
+                    infos.append(QString(AttributeIds::cueBlock) + " Block: " + getBoolAttribute(table, "block", key));
+                    infos.append(QString(AttributeIds::cueFade) + " Fade: " + getNumberAttribute(table, "fade", key, "s"));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "cue_fixture_fade", "s", key));
+                    infos.append(QString(AttributeIds::cueDelay) + " Delay: " + getNumberAttribute(table, "delay", key, "s"));
+                    infos.append("   Fixture Exceptions: " + getItemSpecificNumberAttribute("fixtures", "cue_fixture_delay", "s", key));
+                    infos.append(QString(AttributeIds::cueFollow) + " Follow: " + getBoolAttribute(table, "follow", key));
+                    infos.append(QString(AttributeIds::cueSineFade) + " Sine Fade: " + getBoolAttribute(table, "sinefade", key));
+                } else {
+                    Q_ASSERT(false);
                 }
-            } else {
-                qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
             }
         }
     }
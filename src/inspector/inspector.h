@@ -13,6 +13,7 @@
 #include <QtSql>
 
 #include "constants.h"
+#include "database/itemindex.h"
 #include "itemtablemodel.h"
 
 class Inspector : public QWidget {
@@ -35,15 +35,10 @@ QModelIndex ItemTableModel::getLastSelectedRowIndex() {
     if (ids.isEmpty()) {
         return QModelIndex();
     }
-    QSqlQuery sortkeyQuery;
-    sortkeyQuery.prepare("SELECT sortkey FROM " + table + " WHERE id = :id");
-    sortkeyQuery.bindValue(":id", ids.last());
-    if (!sortkeyQuery.exec()) {
+    bool rowLoaded = false;
+    const int row = ItemIndex::getRow(table, ids.last(), &rowLoaded);
+    if (!rowLoaded || (row < 0)) {
         return QModelIndex();
     }
-    if (!sortkeyQuery.next()) {
-        return QModelIndex();
-    }
-    const int row = sortkeyQuery.value(0).toInt() - 1;
     return index(row, 0);
 }
@@ -11,6 +11,8 @@
 
 #include <QtSql>
 
+#include "database/itemindex.h"
+
 class ItemTableModel : public QSqlQueryModel {
     Q_OBJECT
 public:
@@ -9,11 +9,20 @@
 #include <QtWidgets>
 #include <QtSql>
 
+#include "database/databasenotifier.h"
+#include "database/databaseprofile.h"
+#include "database/itemindex.h"
+#include "database/memorydatabase.h"
+#include "database/preparedquery.h"
+#include "database/queryplancheck.h"
+#include "dmxengine/enginecache.h"
 #include "mainwindow/mainwindow.h"
+#include "terminal/terminal.h"
+#include "terminal/idselection.h"
 
 int main(int argc, char *argv[]) {
     const QString VERSION = "1.0.1";
-    const QString FILEVERSION = "1.0.0";
+    const QString FILEVERSION = "1.2.0";
     const QString COPYRIGHT = "Copyright (c) 2025 Arne Bersch (zoeglfrex-dmx@web.de)";
 
     qInfo() << "Zöglfrex " + VERSION;
@@ -22,6 +31,14 @@ int main(int argc, char *argv[]) {
     qInfo("Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.");
     qInfo("You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.");
 
+    // Scripts run without the window, so they don't need a display
+    for (int argument = 1; argument < argc; argument++) {
+        const QByteArray option = argv[argument];
+        if ((option == "--script") || option.startsWith("--script=")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+            break;
+        }
+    }
     QApplication app(argc, argv);
     app.setApplicationName("Zöglfrex");
     app.setApplicationVersion(VERSION);
@@ -31,6 +48,13 @@ int main(int argc, char *argv[]) {
     parser.addHelpOption();
     parser.addVersionOption();
     parser.addPositionalArgument("file", "The .zfr file to create or open");
+    QSettings settings("Zoeglfrex");
+    QCommandLineOption databaseProfileOption("database-profile", "The SQLite settings to open the file with (" + DatabaseProfile::getNames().join(", ") + ")", "profile", settings.value("database/profile", DatabaseProfile::getDefaultName()).toString());
+    parser.addOption(databaseProfileOption);
+    QCommandLineOption inMemoryOption("in-memory", "Work on a copy of the file in memory and save it to disk in the background");
+    parser.addOption(inMemoryOption);
+    QCommandLineOption scriptOption("script", "Execute the terminal commands of a script file and quit without opening the window", "script");
+    parser.addOption(scriptOption);
     parser.process(app);
     if (parser.positionalArguments().length() < 1) {
         qFatal("Can't open Zöglfrex because no file name was provided.");
@@ -40,21 +64,78 @@ int main(int argc, char *argv[]) {
         qFatal("Can't open Zöglfrex because too many arguments were given.");
         return 1;
     }
+    const QString databaseProfile = parser.value(databaseProfileOption);
+    if (!DatabaseProfile::contains(databaseProfile)) {
+        qFatal() << "Can't open Zöglfrex because the database profile" << databaseProfile << "doesn't exist.";
+        return 1;
+    }
     QString fileName = QFileInfo(parser.positionalArguments().first()).absoluteFilePath();
     if (!fileName.endsWith(".zfr")) {
         qFatal("Can't open files because Zöglfrex files have to end with .zfr");
         return 1;
     }
     const bool fileExists = QFile(fileName).exists();
+    // The engine cache is only valid for the file it was saved with, so it's checked before anything changes the file
+    const QString engineCacheFileName = fileName + ".cache";
+    const bool engineCacheValid = fileExists && EngineCache::isSnapshotValid(engineCacheFileName, fileName, FILEVERSION);
+    bool inMemory = parser.isSet(inMemoryOption) || settings.value("database/inmemory", false).toBool();
     QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
-    db.setDatabaseName(fileName);
+    if (inMemory && !MemoryDatabase::isAvailable(db)) {
+        qWarning() << "Can't work in memory because Zöglfrex was built without access to the SQLite library of Qt's driver, opening the file on disk instead.";
+        inMemory = false;
+    }
+    db.setDatabaseName(inMemory ? ":memory:" : fileName);
     if (!db.open()) {
         qFatal() << "Failed to establish a database connection." << db.lastError().text();
         return 1;
     }
+    if (inMemory) {
+        if (fileExists && !MemoryDatabase::load(db, fileName)) {
+            qFatal() << "Failed to load" << fileName << "into memory.";
+            return 1;
+        }
+    } else if (!DatabaseProfile::apply(db, databaseProfile)) {
+        qFatal() << "Failed to apply the database profile" << databaseProfile;
+        return 1;
+    }
+
+    // Every migration upgrades a file from the previous file version to its version in one transaction
+    const QString FIRSTFILEVERSION = "1.0.0";
+    QList<QPair<QString, QStringList>> migrations;
+    auto createIndex = [] (const QString table, const QString column) {
+        return "CREATE INDEX IF NOT EXISTS " + table + "_" + column + "_index ON " + table + " (" + column + ")";
+    };
+    QStringList reverseIndexQueries;
+    for (const QString table : {"intensity_model_dimmer", "intensity_fixture_dimmer", "color_model_hue", "color_fixture_hue", "color_model_saturation", "color_fixture_saturation", "color_model_quality", "color_fixture_quality", "position_model_pan", "position_fixture_pan", "position_model_tilt", "position_fixture_tilt", "position_model_zoom", "position_fixture_zoom", "position_model_focus", "position_fixture_focus", "effect_fixture_phase", "cue_fixture_fade", "cue_fixture_delay", "raw_model_channel_values", "raw_fixture_channel_values"}) {
+        reverseIndexQueries.append(createIndex(table, "foreignitem_key"));
+    }
+    for (const QString table : {"group_fixtures", "intensity_raws", "color_raws", "position_raws", "effect_step_intensities", "effect_step_colors", "effect_step_positions", "effect_step_raws"}) {
+        reverseIndexQueries.append(createIndex(table, "valueitem_key"));
+    }
+    for (const QString table : {"cue_group_intensities", "cue_group_colors", "cue_group_positions", "cue_group_raws", "cue_group_effects"}) {
+        reverseIndexQueries.append(createIndex(table, "foreignitem_key"));
+        reverseIndexQueries.append(createIndex(table, "valueitem_key"));
+    }
+    reverseIndexQueries.append(createIndex("fixtures", "model_key"));
+    reverseIndexQueries.append(createIndex("cuelists", "currentcue_key"));
+    reverseIndexQueries.append(createIndex("cuelists", "lastcue_key"));
+    migrations.append({"1.1.0", reverseIndexQueries});
+    QStringList sortIdQueries;
+    const QStringList itemTables = {"models", "fixtures", "groups", "intensities", "colors", "positions", "raws", "effects", "cuelists", "cues"};
+    for (const QString table : itemTables) {
+        sortIdQueries.append("ALTER TABLE " + table + " ADD COLUMN sortid TEXT");
+        if (table == "cues") {
+            sortIdQueries.append("CREATE INDEX IF NOT EXISTS cues_sortid_index ON cues (cuelist_key, sortid)");
+        } else {
+            sortIdQueries.append(createIndex(table, "sortid"));
+        }
+    }
+    migrations.append({"1.2.0", sortIdQueries});
+    Q_ASSERT(migrations.last().first == FILEVERSION);
 
     QStringList queries;
     queries.append("PRAGMA foreign_keys = ON");
+    QString fileVersion = FIRSTFILEVERSION;
     if (fileExists) {
         QSqlQuery versionQuery;
         if (!versionQuery.exec("SELECT version FROM about")) {
@@ -66,10 +147,30 @@ int main(int argc, char *argv[]) {
             qFatal("Failed because no version was found in this Zöglfrex file.");
             return 1;
         }
-        if (versionQuery.value(0).toString() != FILEVERSION) {
-            qFatal() << "Can't load this Zöglfrex file because its file version (" << versionQuery.value(0).toString() << ") isn't compatible with this version of Zöglfrex (" << VERSION << ")";
+        fileVersion = versionQuery.value(0).toString();
+        QStringList fileVersions = {FIRSTFILEVERSION};
+        for (const QPair<QString, QStringList> migration : migrations) {
+            fileVersions.append(migration.first);
+        }
+        if (!fileVersions.contains(fileVersion)) {
+            qFatal() << "Can't load this Zöglfrex file because its file version (" << fileVersion << ") isn't compatible with this version of Zöglfrex (" << VERSION << ")";
             return 1;
         }
+        if (fileVersion != FILEVERSION) {
+            const QString backupFileName = fileName.chopped(4) + "_" + fileVersion + ".zfr";
+            if (QFile(backupFileName).exists()) {
+                qWarning() << "Didn't create a backup before upgrading because" << backupFileName << "already exists.";
+            } else {
+                QSqlQuery backupQuery;
+                if (!backupQuery.exec("VACUUM INTO '" + QString(backupFileName).replace("'", "''") + "'")) {
+                    qWarning() << Q_FUNC_INFO << backupQuery.executedQuery() << backupQuery.lastError().text();
+                    qFatal() << "Failed to create a backup before upgrading the Zöglfrex file.";
+                    return 1;
+                }
+                qInfo() << "Created Backup" << backupFileName;
+            }
+            qInfo() << "Upgrading File from version" << fileVersion << "to" << FILEVERSION;
+        }
         queries.append("UPDATE currentitems SET cue_key = NULL"); // Reset Blind
     } else {
         qInfo() << "Created File" << fileName;
@@ -157,18 +258,8 @@ int main(int argc, char *argv[]) {
         queries.append("CREATE TRIGGER resetcue_trigger AFTER UPDATE OF cuelist_key ON currentitems BEGIN UPDATE currentitems SET cue_key = NULL; END");
         queries.append("CREATE TRIGGER createcues_trigger AFTER INSERT ON cues BEGIN UPDATE cues SET cuelist_key = (SELECT cuelist_key FROM currentitems) WHERE id = NEW.id AND cuelist_key IS NULL; END");
         queries.append("CREATE TABLE about (version TEXT PRIMARY KEY)");
-        queries.append("INSERT INTO about (version) VALUES ('" + FILEVERSION + "')");
-    }
-    queries.append("CREATE INDEX IF NOT EXISTS models_sortkey_index ON models (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS fixtures_sortkey_index ON fixtures (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS groups_sortkey_index ON groups (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS intensities_sortkey_index ON intensities (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS colors_sortkey_index ON colors (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS positions_sortkey_index ON positions (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS raws_sortkey_index ON raws (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS effects_sortkey_index ON effects (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS cuelists_sortkey_index ON cuelists (sortkey)");
-    queries.append("CREATE INDEX IF NOT EXISTS cues_sortkey_index ON cues (cuelist_key, sortkey)");
+        queries.append("INSERT INTO about (version) VALUES ('" + FIRSTFILEVERSION + "')");
+    }
     for (QString queryText : queries) {
         QSqlQuery query;
         if (!query.exec(queryText)) {
@@ -177,6 +268,126 @@ int main(int argc, char *argv[]) {
             return 1;
         }
     }
+    // Items from before file version 1.2.0 don't have a sort ID yet
+    auto setSortIds = [itemTables] {
+        for (const QString table : itemTables) {
+            QSqlQuery sortIdQuery;
+            if (!sortIdQuery.exec("SELECT key, id FROM " + table + " WHERE sortid IS NULL")) {
+                qWarning() << Q_FUNC_INFO << sortIdQuery.executedQuery() << sortIdQuery.lastError().text();
+                return false;
+            }
+            QVariantList keys;
+            QVariantList sortIds;
+            while (sortIdQuery.next()) {
+                keys.append(sortIdQuery.value(0));
+                sortIds.append(IdSelection::getSortId(sortIdQuery.value(1).toString()));
+            }
+            if (!keys.isEmpty()) {
+                QSqlQuery updateQuery;
+                updateQuery.prepare("UPDATE " + table + " SET sortid = :sortid WHERE key = :key");
+                updateQuery.bindValue(":key", keys);
+                updateQuery.bindValue(":sortid", sortIds);
+                if (!updateQuery.execBatch()) {
+                    qWarning() << Q_FUNC_INFO << updateQuery.executedQuery() << updateQuery.lastError().text();
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    bool migrate = (fileVersion == FIRSTFILEVERSION);
+    for (const QPair<QString, QStringList> migration : migrations) {
+        if (migrate) {
+            if (!db.transaction()) {
+                qWarning() << Q_FUNC_INFO << "Failed to begin a transaction:" << db.lastError().text();
+                qFatal() << "Failed to upgrade the Zöglfrex file to version" << migration.first;
+                return 1;
+            }
+            QStringList migrationQueries = migration.second;
+            migrationQueries.append("UPDATE about SET version = '" + migration.first + "'");
+            bool migrated = true;
+            for (QString queryText : migrationQueries) {
+                QSqlQuery query;
+                if (migrated && !query.exec(queryText)) {
+                    qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+                    migrated = false;
+                }
+            }
+            if (migrated && (migration.first == "1.2.0") && !setSortIds()) {
+                migrated = false;
+            }
+            if (migrated && !db.commit()) {
+                qWarning() << Q_FUNC_INFO << "Failed to commit the transaction:" << db.lastError().text();
+                migrated = false;
+            }
+            if (!migrated) {
+                db.rollback();
+                qFatal() << "Failed to upgrade the Zöglfrex file to version" << migration.first;
+                return 1;
+            }
+        }
+        migrate = migrate || (migration.first == fileVersion);
+    }
+    QStringList sortkeyIndexQueries;
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS models_sortkey_index ON models (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS fixtures_sortkey_index ON fixtures (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS groups_sortkey_index ON groups (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS intensities_sortkey_index ON intensities (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS colors_sortkey_index ON colors (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS positions_sortkey_index ON positions (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS raws_sortkey_index ON raws (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS effects_sortkey_index ON effects (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS cuelists_sortkey_index ON cuelists (sortkey)");
+    sortkeyIndexQueries.append("CREATE INDEX IF NOT EXISTS cues_sortkey_index ON cues (cuelist_key, sortkey)");
+    for (QString queryText : sortkeyIndexQueries) {
+        QSqlQuery query;
+        if (!query.exec(queryText)) {
+            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+            qFatal() << "Failed to create or modify table.";
+            return 1;
+        }
+    }
+    // Started after the migrations, which make the engine cache invalid anyway, but before recovered edits are replayed
+    DatabaseNotifier* databaseNotifier = new DatabaseNotifier();
+    if (!databaseNotifier->start()) {
+        qWarning() << "Failed to watch the database for changes, all views will be reloaded after every change.";
+    }
+    ItemIndex::setDatabaseNotifier(databaseNotifier);
+    const int recoveredEdits = MemoryDatabase::replayJournals(db, fileName);
+    if (recoveredEdits > 0) {
+        qInfo() << "Recovered" << recoveredEdits << "edits that weren't saved to the file.";
+    }
+    MemoryDatabase* memoryDatabase = nullptr;
+    if (inMemory) {
+        memoryDatabase = new MemoryDatabase(db, fileName);
+        if (!memoryDatabase->start()) {
+            qFatal() << "Failed to save" << fileName;
+            return 1;
+        }
+    } else {
+        MemoryDatabase::removeJournals(fileName);
+    }
+#ifdef QT_DEBUG
+    if (!QueryPlanCheck::check(db)) {
+        qWarning() << "Some queries don't use an index.";
+    }
+#endif
+
+    if (parser.isSet(scriptOption)) {
+        Terminal* terminal = new Terminal();
+        const bool scriptSucceeded = terminal->executeScript(parser.value(scriptOption));
+        delete terminal;
+        databaseNotifier->publish();
+        delete databaseNotifier;
+        PreparedQuery::clear();
+        if (memoryDatabase != nullptr) {
+            memoryDatabase->close();
+            delete memoryDatabase;
+        } else {
+            db.close();
+        }
+        return scriptSucceeded ? 0 : 1;
+    }
 
     QFile styleSheet = QFile(":/resources/style.qss");
     if (!styleSheet.open(QFile::ReadOnly | QFile::Text)) {
@@ -186,7 +397,28 @@ int main(int argc, char *argv[]) {
     QTextStream styleSheetStream = QTextStream(&styleSheet);
     app.setStyleSheet(styleSheetStream.readAll());
 
-    MainWindow window(VERSION, COPYRIGHT);
+    MainWindow window(VERSION, COPYRIGHT, databaseNotifier);
     window.setWindowTitle("Zöglfrex - " + fileName);
-    return app.exec();
+    EngineCache* engineCache = window.getEngineCache();
+    if (engineCacheValid && engineCache->loadSnapshot(engineCacheFileName)) {
+        qInfo() << "Loaded Engine Cache" << engineCacheFileName;
+    }
+    if (memoryDatabase != nullptr) {
+        QObject::connect(memoryDatabase, &MemoryDatabase::checkpointWritten, engineCache, [=] {
+            databaseNotifier->publish();
+            engineCache->saveSnapshot(engineCacheFileName, fileName, FILEVERSION);
+        });
+    }
+    const int result = app.exec();
+    databaseNotifier->publish();
+    delete databaseNotifier;
+    PreparedQuery::clear();
+    if (memoryDatabase != nullptr) {
+        memoryDatabase->close();
+        delete memoryDatabase;
+    } else {
+        db.close();
+    }
+    engineCache->saveSnapshot(engineCacheFileName, fileName, FILEVERSION);
+    return result;
 }
@@ -8,25 +8,83 @@
 
 #include "mainwindow.h"
 
-MainWindow::MainWindow(QString version, QString copyright, QWidget *parent) : QMainWindow(parent) {
+MainWindow::MainWindow(QString version, QString copyright, DatabaseNotifier* notifier, QWidget *parent) : QMainWindow(parent) {
     VERSION = version;
     COPYRIGHT = copyright;
+    databaseNotifier = notifier;
 
     resize(1200, 800);
 
-    connect(dmxEngine, &DmxEngine::sendUniverses, sacnServer, &SacnServer::sendUniverses);
+    connect(dmxEngine, &DmxEngine::sendUniverses, outputThread, &OutputThread::queueUniverses, Qt::DirectConnection);
+    connect(outputThread, &OutputThread::statisticsChanged, statisticsWindow, &StatisticsWindow::setValue);
+    connect(sacnServer, &SacnServer::statisticsChanged, statisticsWindow, &StatisticsWindow::setValue);
+    connect(artNetServer, &ArtNetServer::statisticsChanged, statisticsWindow, &StatisticsWindow::setValue);
+    connect(outputSettings, &OutputSettings::statisticsChanged, statisticsWindow, &StatisticsWindow::setValue);
+    QTimer* databaseStatisticsTimer = new QTimer(this);
+    connect(databaseStatisticsTimer, &QTimer::timeout, this, [this] {
+        const PreparedQuery::Statistics statistics = PreparedQuery::takeStatistics();
+        statisticsWindow->setValue("Database Statements", QString::number(statistics.statements));
+        statisticsWindow->setValue("Database Prepares", QString::number(statistics.prepares) + " / s");
+        statisticsWindow->setValue("Database Prepare Time", QString::number(statistics.prepareTime / 1000000.0, 'f', 3) + " ms / s");
+        statisticsWindow->setValue("Database Statement Reuses", QString::number(statistics.reuses) + " / s");
+        const EngineCache::Statistics cacheStatistics = dmxEngine->takeCacheStatistics();
+        statisticsWindow->setValue("Engine Cache Hits", QString::number(cacheStatistics.hits) + " / s");
+        statisticsWindow->setValue("Engine Cache Misses", QString::number(cacheStatistics.misses) + " / s");
+        statisticsWindow->setValue("Engine Cache Invalidations", QString::number(cacheStatistics.invalidations) + " / s");
+        const MemoryDatabase::Statistics memoryStatistics = MemoryDatabase::takeStatistics();
+        if (memoryStatistics.active) {
+            statisticsWindow->setValue("Database Checkpoints", QString::number(memoryStatistics.checkpoints) + " (" + QString::number(memoryStatistics.failedCheckpoints) + " failed)");
+            statisticsWindow->setValue("Database Checkpoint Snapshot Time", QString::number(memoryStatistics.snapshotTime / 1000000.0, 'f', 3) + " ms");
+            statisticsWindow->setValue("Database Checkpoint Write Time", QString::number(memoryStatistics.writeTime / 1000000.0, 'f', 3) + " ms");
+            statisticsWindow->setValue("Database Size", QString::number(memoryStatistics.size / 1024) + " KiB");
+            statisticsWindow->setValue("Database Journal Entries", QString::number(memoryStatistics.journalEntries) + " / s");
+        }
+    });
+    databaseStatisticsTimer->start(1000);
+    connect(outputSettings, &OutputSettings::universeRatesChanged, outputThread, &OutputThread::setUniverseRates, Qt::DirectConnection);
+    outputSettings->loadUniverseRates();
+    outputThread->addBackend(sacnServer->getOutput());
+    outputThread->addBackend(artNetServer->getOutput());
+    outputThread->addBackend(outputSettings->getSharedMemoryOutput());
+    outputThread->setInput(sacnServer->getInput());
+    outputThread->start(QThread::TimeCriticalPriority);
     connect(dmxEngine, &DmxEngine::updatePreviewFixtures, preview2d, &Preview2d::setFixtures);
-    connect(dmxEngine, &DmxEngine::dbChanged, this, &MainWindow::reload);
-    connect(cuelistView, &CuelistView::dbChanged, this, &MainWindow::reload);
-    connect(terminal, &Terminal::dbChanged, this, &MainWindow::reload);
     connect(terminal, &Terminal::itemChanged, inspector, &Inspector::loadItems);
-    connect(playbackMonitor, &PlaybackMonitor::dbChanged, this, &MainWindow::reload);
-    connect(controlPanel, &ControlPanel::dbChanged, this, &MainWindow::reload);
-    reload();
+    dmxEngine->setDatabaseNotifier(databaseNotifier);
+    if (databaseNotifier->isActive()) {
+        const QStringList itemTables = {"models", "fixtures", "groups", "intensities", "colors", "positions", "raws", "effects", "cuelists", "cues", "currentitems"};
+        databaseNotifier->subscribe(itemTables + QStringList({"group_fixtures", "cue_group_intensities", "cue_group_colors", "cue_group_positions", "cue_group_raws", "cue_group_effects"}), cuelistView, [this] { cuelistView->reload(); });
+        databaseNotifier->subscribe(itemTables, terminal, [this] { terminal->reload(); });
+        databaseNotifier->subscribe({"cuelists", "cues"}, playbackMonitor, [this] { playbackMonitor->reload(); });
+        controlPanel->subscribe(databaseNotifier);
+        // Changed views are reloaded right after a change and not only with the next frame of the engine
+        connect(dmxEngine, &DmxEngine::dbChanged, databaseNotifier, &DatabaseNotifier::schedulePublish);
+        connect(cuelistView, &CuelistView::dbChanged, databaseNotifier, &DatabaseNotifier::schedulePublish);
+        connect(terminal, &Terminal::dbChanged, databaseNotifier, &DatabaseNotifier::schedulePublish);
+        connect(playbackMonitor, &PlaybackMonitor::dbChanged, databaseNotifier, &DatabaseNotifier::schedulePublish);
+        connect(controlPanel, &ControlPanel::dbChanged, databaseNotifier, &DatabaseNotifier::schedulePublish);
+    } else {
+        connect(dmxEngine, &DmxEngine::dbChanged, this, &MainWindow::reload);
+        connect(cuelistView, &CuelistView::dbChanged, this, &MainWindow::reload);
+        connect(terminal, &Terminal::dbChanged, this, &MainWindow::reload);
+        connect(playbackMonitor, &PlaybackMonitor::dbChanged, this, &MainWindow::reload);
+        connect(controlPanel, &ControlPanel::dbChanged, this, &MainWindow::reload);
+    }
+    // Load the views after the engine has sent its first frame
+    connect(dmxEngine, &DmxEngine::sendUniverses, this, [this] { QTimer::singleShot(0, this, &MainWindow::reload); }, Qt::SingleShotConnection);
 
     new QShortcut(Qt::CTRL | Qt::Key_Q, this, [this] { close(); }, Qt::ApplicationShortcut);
 
     QMenu* fileMenu = menuBar()->addMenu("File");
+    QAction* scriptAction = new QAction("Execute Script");
+    fileMenu->addAction(scriptAction);
+    connect(scriptAction, &QAction::triggered, this, [this] {
+        const QString fileName = QFileDialog::getOpenFileName(this, "Execute Script", QString(), "Terminal Scripts (*.txt);;All Files (*)");
+        if (!fileName.isEmpty()) {
+            terminal->executeScript(fileName);
+        }
+    });
+    fileMenu->addSeparator();
     QAction* quitAction = new QAction("Quit (CTRL+Q)");
     fileMenu->addAction(quitAction);
     connect(quitAction, &QAction::triggered, this, &MainWindow::close);
@@ -44,6 +102,15 @@ MainWindow::MainWindow(QString version, QString copyright, QWidget *parent) : QM
     QAction* sacnSettingsAction = new QAction("sACN Settings");
     outputMenu->addAction(sacnSettingsAction);
     connect(sacnSettingsAction, &QAction::triggered, sacnServer, &SacnServer::show);
+    QAction* artNetSettingsAction = new QAction("Art-Net Settings");
+    outputMenu->addAction(artNetSettingsAction);
+    connect(artNetSettingsAction, &QAction::triggered, artNetServer, &ArtNetServer::show);
+    QAction* outputSettingsAction = new QAction("Output Settings");
+    outputMenu->addAction(outputSettingsAction);
+    connect(outputSettingsAction, &QAction::triggered, outputSettings, &OutputSettings::show);
+    QAction* statisticsAction = new QAction("Engine Statistics");
+    outputMenu->addAction(statisticsAction);
+    connect(statisticsAction, &QAction::triggered, statisticsWindow, &StatisticsWindow::show);
 
     QMenu* helpMenu = menuBar()->addMenu("Help");
     QAction* aboutAction = new QAction("About Zöglfrex");
@@ -90,6 +157,10 @@ void MainWindow::reload() {
     controlPanel->reload();
 }
 
+EngineCache* MainWindow::getEngineCache() const {
+    return dmxEngine->getCache();
+}
+
 void MainWindow::about() {
     AboutWindow about(VERSION, COPYRIGHT);
     about.exec();
@@ -13,19 +13,26 @@
 #include <QtSql>
 
 #include "aboutwindow/aboutwindow.h"
+#include "database/databasenotifier.h"
+#include "database/memorydatabase.h"
+#include "artnetserver/artnetserver.h"
 #include "dmxengine/dmxengine.h"
+#include "outputthread/outputthread.h"
+#include "outputsettings/outputsettings.h"
 #include "preview2d/preview2d.h"
 #include "cuelistview/cuelistview.h"
 #include "terminal/terminal.h"
 #include "inspector/inspector.h"
 #include "playbackmonitor/playbackmonitor.h"
 #include "sacnserver/sacnserver.h"
+#include "statisticswindow/statisticswindow.h"
 #include "controlpanel/controlpanel.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
 public:
-    MainWindow(QString version, QString copyright, QWidget *parent = nullptr);
+    MainWindow(QString version, QString copyright, DatabaseNotifier* notifier, QWidget *parent = nullptr);
+    EngineCache* getEngineCache() const;
 public slots:
     void reload();
 private:
@@ -33,13 +40,18 @@ private:
     QString COPYRIGHT;
     void about();
     void closeEvent(QCloseEvent *event) override;
+    DatabaseNotifier* databaseNotifier;
     DmxEngine* dmxEngine = new DmxEngine(this);
+    OutputThread* outputThread = new OutputThread(this);
     Preview2d* preview2d = new Preview2d(this);
     CuelistView* cuelistView = new CuelistView(this);
     Terminal* terminal = new Terminal(this);
     Inspector* inspector = new Inspector(this);
     PlaybackMonitor* playbackMonitor = new PlaybackMonitor(this);
     SacnServer* sacnServer = new SacnServer(this);
+    ArtNetServer* artNetServer = new ArtNetServer(this);
+    OutputSettings* outputSettings = new OutputSettings(this);
+    StatisticsWindow* statisticsWindow = new StatisticsWindow(this);
     ControlPanel* controlPanel = new ControlPanel(this);
 };
 
@@ -0,0 +1,202 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "outputbackend.h"
+
+#include <ctime>
+
+OutputBackend::OutputBackend(const QString backendName, const quint16 backendPort, QObject* parent) : FrameOutput(parent), name(backendName), port(backendPort) {
+    queuedPackets.reserve(1024);
+    statisticsTimer.start();
+}
+
+void OutputBackend::setInterfaces(const QList<Interface> interfaces) {
+    QMutexLocker locker(&configurationMutex);
+    configuration.interfaces = interfaces;
+    configuration.interfacesChanged = true;
+    configurationChanged.store(true, std::memory_order_release);
+}
+
+void OutputBackend::setUnicastDestinations(const QHash<int, QList<quint32>> destinations) {
+    QMutexLocker locker(&configurationMutex);
+    configuration.unicastDestinations = destinations;
+    configurationChanged.store(true, std::memory_order_release);
+}
+
+void OutputBackend::loadUnicastDestinations(const QTableWidget* const tableWidget, QSettings* const settings, const QString settingsKey, const int maxUniverse) {
+    // The table has one row per universe with its addresses, the rows are saved as they are
+    QHash<int, QList<quint32>> destinations;
+    settings->beginWriteArray(settingsKey);
+    for (int row = 0; row < tableWidget->rowCount(); row++) {
+        const QTableWidgetItem* universeItem = tableWidget->item(row, 0);
+        const QTableWidgetItem* addressesItem = tableWidget->item(row, 1);
+        const QString universeText = (universeItem == nullptr) ? QString() : universeItem->text();
+        const QString addressesText = (addressesItem == nullptr) ? QString() : addressesItem->text();
+        settings->setArrayIndex(row);
+        settings->setValue("universe", universeText);
+        settings->setValue("addresses", addressesText);
+        bool ok = false;
+        const int universe = universeText.toInt(&ok);
+        if (!ok || (universe < 1) || (universe > maxUniverse)) {
+            continue;
+        }
+        for (const QString addressText : addressesText.split(QRegularExpression("[,;\\s]+"), Qt::SkipEmptyParts)) {
+            const QHostAddress address(addressText);
+            if (address.protocol() == QAbstractSocket::IPv4Protocol) {
+                destinations[universe].append(address.toIPv4Address());
+            } else {
+                qWarning() << Q_FUNC_INFO << name << "Invalid unicast address" << addressText;
+            }
+        }
+    }
+    settings->endArray();
+    setUnicastDestinations(destinations);
+}
+
+void OutputBackend::setConfigurationChanged() {
+    configurationChanged.store(true, std::memory_order_release);
+}
+
+void OutputBackend::loadInterfaces(const QList<Interface> interfaces) {
+    for (const InterfaceOutput& output : outputs) {
+        delete output.sender;
+    }
+    outputs.clear();
+    for (const Interface& interface : interfaces) {
+        InterfaceOutput output;
+        output.interface = interface;
+        output.sender = new DatagramSender();
+        if (!output.sender->bind(interface.networkInterface, interface.address.ip())) {
+            qWarning() << Q_FUNC_INFO << name << interface.networkInterface.name() << output.sender->errorString();
+        }
+        outputs.append(output);
+    }
+}
+
+void OutputBackend::sendFrame(const DmxFrame& frame) {
+    if (configurationChanged.load(std::memory_order_acquire)) {
+        QMutexLocker locker(&configurationMutex);
+        configurationChanged.store(false, std::memory_order_release);
+        unicastDestinations = configuration.unicastDestinations;
+        if (configuration.interfacesChanged) {
+            configuration.interfacesChanged = false;
+            loadInterfaces(configuration.interfaces);
+        }
+        applyConfiguration();
+    }
+    if (outputs.isEmpty()) {
+        return;
+    }
+    QElapsedTimer encodeTimer;
+    encodeTimer.start();
+    const qint64 cpuStartTime = getThreadCpuTime();
+    queuedPackets.clear();
+    queueFrame(frame);
+    const qint64 encodeTime = encodeTimer.nsecsElapsed();
+    for (int output = 0; output < outputs.length(); output++) {
+        sendInterface(&outputs[output]);
+    }
+    updateStatistics(encodeTime, getThreadCpuTime() - cpuStartTime);
+}
+
+void OutputBackend::close() {
+    loadInterfaces(QList<Interface>());
+}
+
+void OutputBackend::sendInterface(InterfaceOutput* output) {
+    if (!output->sender->isBound()) {
+        return;
+    }
+    QElapsedTimer sendTimer;
+    sendTimer.start();
+    prepareInterface(output->interface);
+    const QSet<int>& universes = output->interface.universes;
+    for (const QueuedPacket& queuedPacket : queuedPackets) {
+        if (!queuedPacket.allInterfaces && !universes.isEmpty() && !universes.contains(queuedPacket.universe)) {
+            continue;
+        }
+        if (queuedPacket.address != 0) {
+            output->sender->queueDatagram(queuedPacket.data, queuedPacket.size, queuedPacket.address, port);
+            continue;
+        }
+        const QHash<int, QList<quint32>>::const_iterator destinations = unicastDestinations.constFind(queuedPacket.universe);
+        if (destinations != unicastDestinations.constEnd()) {
+            for (const quint32 address : destinations.value()) {
+                output->sender->queueDatagram(queuedPacket.data, queuedPacket.size, address, port);
+            }
+        } else {
+            output->sender->queueDatagram(queuedPacket.data, queuedPacket.size, getDefaultDestination(queuedPacket.universe, output->interface.address), port);
+        }
+    }
+    const int sendCalls = output->sender->getSendCalls();
+    const int packets = output->sender->flush();
+    const qint64 sendTime = sendTimer.nsecsElapsed();
+    output->statisticsPackets += std::max(packets, 0);
+    output->statisticsSendCalls += output->sender->getSendCalls() - sendCalls;
+    output->statisticsSendTime += sendTime;
+    output->statisticsMaxSendTime = std::max(sendTime, output->statisticsMaxSendTime);
+}
+
+void OutputBackend::prepareInterface(const Interface& interface) {
+    Q_UNUSED(interface);
+}
+
+QByteArray* OutputBackend::getDataPacket(const int universe) {
+    QHash<int, QByteArray>::iterator packet = dataPackets.find(universe);
+    if (packet == dataPackets.end()) {
+        packet = dataPackets.insert(universe, createDataPacket(universe));
+    }
+    return &packet.value();
+}
+
+void OutputBackend::queuePacket(const QByteArray& packet, const int universe, const bool allInterfaces) {
+    queuedPackets.append({packet.constData(), (int)packet.size(), universe, 0, allInterfaces});
+}
+
+void OutputBackend::queueDatagram(const QByteArray& packet, const quint32 address) {
+    queuedPackets.append({packet.constData(), (int)packet.size(), 0, address, true});
+}
+
+void OutputBackend::updateStatistics(const qint64 encodeTime, const qint64 cpuTime) {
+    statisticsFrames++;
+    statisticsEncodeTime += encodeTime;
+    statisticsCpuTime += cpuTime;
+    const qint64 elapsedTime = statisticsTimer.nsecsElapsed();
+    if (elapsedTime < 1000000000) {
+        return;
+    }
+    const float seconds = elapsedTime / 1000000000.0;
+    emit statisticsChanged(name + " Frames", QString::number(statisticsFrames / seconds, 'f', 1) + " / s");
+    emit statisticsChanged(name + " Encode Time", QString::number(statisticsEncodeTime / 1000000.0 / statisticsFrames, 'f', 3) + " ms");
+    emit statisticsChanged(name + " CPU Usage", QString::number(100.0 * statisticsCpuTime / elapsedTime, 'f', 2) + " %");
+    for (int outputIndex = 0; outputIndex < outputs.length(); outputIndex++) {
+        InterfaceOutput* output = &outputs[outputIndex];
+        const QString outputName = name + " " + output->interface.networkInterface.name() + " (" + output->interface.address.ip().toString() + ")";
+        emit statisticsChanged(outputName + " Packets", QString::number(output->statisticsPackets / seconds, 'f', 0) + " / s");
+        emit statisticsChanged(outputName + " Send Calls", QString::number(output->statisticsSendCalls / seconds, 'f', 0) + " / s");
+        emit statisticsChanged(outputName + " Send Time", QString::number(output->statisticsSendTime / 1000000.0 / statisticsFrames, 'f', 3) + " ms (max " + QString::number(output->statisticsMaxSendTime / 1000000.0, 'f', 3) + " ms)");
+        output->statisticsPackets = 0;
+        output->statisticsSendCalls = 0;
+        output->statisticsSendTime = 0;
+        output->statisticsMaxSendTime = 0;
+    }
+    statisticsFrames = 0;
+    statisticsEncodeTime = 0;
+    statisticsCpuTime = 0;
+    statisticsTimer.restart();
+}
+
+qint64 OutputBackend::getThreadCpuTime() {
+#ifdef Q_OS_LINUX
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return ((qint64)time.tv_sec * 1000000000 + time.tv_nsec);
+#else
+    return ((qint64)std::clock() * 1000000000 / CLOCKS_PER_SEC);
+#endif
+}
@@ -0,0 +1,86 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef OUTPUTBACKEND_H
+#define OUTPUTBACKEND_H
+
+#include <QtNetwork>
+#include <QtWidgets>
+
+#include "datagramsender/datagramsender.h"
+#include "outputthread/dmxframe.h"
+#include "outputthread/frameoutput.h"
+
+class OutputBackend : public FrameOutput {
+    Q_OBJECT
+public:
+    struct Interface {
+        QNetworkInterface networkInterface;
+        QNetworkAddressEntry address;
+        int priority = 100;
+        QSet<int> universes; // all universes if empty
+    };
+    OutputBackend(QString name, quint16 port, QObject* parent = nullptr);
+    void setInterfaces(QList<Interface> interfaces);
+    void setUnicastDestinations(QHash<int, QList<quint32>> destinations);
+    void loadUnicastDestinations(const QTableWidget* tableWidget, QSettings* settings, QString settingsKey, int maxUniverse);
+    void sendFrame(const DmxFrame& frame) override;
+    void close() override;
+    virtual bool supportsSync() const = 0;
+protected:
+    virtual void applyConfiguration() = 0; // called with configurationMutex locked
+    virtual void queueFrame(const DmxFrame& frame) = 0;
+    virtual void prepareInterface(const Interface& interface);
+    virtual QByteArray createDataPacket(int universe) = 0;
+    virtual quint32 getDefaultDestination(int universe, const QNetworkAddressEntry& address) const = 0;
+    QByteArray* getDataPacket(int universe);
+    // Queued packets are sent on every interface and must not be resized before the frame is sent
+    void queuePacket(const QByteArray& packet, int universe, bool allInterfaces = false);
+    void queueDatagram(const QByteArray& packet, quint32 address);
+    void setConfigurationChanged();
+    QMutex configurationMutex;
+private:
+    struct Configuration {
+        QList<Interface> interfaces;
+        bool interfacesChanged = false;
+        QHash<int, QList<quint32>> unicastDestinations;
+    };
+    struct InterfaceOutput {
+        Interface interface;
+        DatagramSender* sender;
+        int statisticsPackets = 0;
+        int statisticsSendCalls = 0;
+        qint64 statisticsSendTime = 0;
+        qint64 statisticsMaxSendTime = 0;
+    };
+    struct QueuedPacket {
+        const char* data;
+        int size;
+        int universe;
+        quint32 address;
+        bool allInterfaces;
+    };
+    void loadInterfaces(QList<Interface> interfaces);
+    void sendInterface(InterfaceOutput* output);
+    void updateStatistics(qint64 encodeTime, qint64 cpuTime);
+    static qint64 getThreadCpuTime();
+    const QString name;
+    const quint16 port;
+    Configuration configuration;
+    std::atomic<bool> configurationChanged = false;
+    QList<InterfaceOutput> outputs;
+    QList<QueuedPacket> queuedPackets;
+    QHash<int, QList<quint32>> unicastDestinations;
+    QHash<int, QByteArray> dataPackets;
+    QElapsedTimer statisticsTimer;
+    int statisticsFrames = 0;
+    qint64 statisticsEncodeTime = 0;
+    qint64 statisticsCpuTime = 0;
+};
+
+#endif // OUTPUTBACKEND_H
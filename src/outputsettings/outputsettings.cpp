@@ -0,0 +1,102 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "outputsettings.h"
+
+OutputSettings::OutputSettings(QWidget* parent) : QWidget(parent, Qt::Window) {
+    settings = new QSettings("Zoeglfrex");
+    QGridLayout* layout = new QGridLayout();
+    setLayout(layout);
+    setWindowTitle("Zöglfrex Output Settings");
+
+    QLabel* ratesLabel = new QLabel("Universe Refresh Rates");
+    layout->addWidget(ratesLabel, 0, 0);
+    ratesTableWidget = new QTableWidget(0, 2);
+    ratesTableWidget->setHorizontalHeaderLabels({"Universe", "Refresh Rate (Hz)"});
+    ratesTableWidget->verticalHeader()->hide();
+    ratesTableWidget->horizontalHeader()->setStretchLastSection(true);
+    const int rateUniverses = settings->beginReadArray("output/rates");
+    for (int row = 0; row < rateUniverses; row++) {
+        settings->setArrayIndex(row);
+        ratesTableWidget->insertRow(row);
+        ratesTableWidget->setItem(row, 0, new QTableWidgetItem(settings->value("universe").toString()));
+        ratesTableWidget->setItem(row, 1, new QTableWidgetItem(settings->value("rate").toString()));
+    }
+    settings->endArray();
+    connect(ratesTableWidget, &QTableWidget::itemChanged, this, &OutputSettings::loadUniverseRates);
+    layout->addWidget(ratesTableWidget, 0, 1);
+
+    QPushButton* addRateButton = new QPushButton("Add Universe");
+    connect(addRateButton, &QPushButton::clicked, this, [this] {
+        const int row = ratesTableWidget->rowCount();
+        ratesTableWidget->insertRow(row);
+        ratesTableWidget->setItem(row, 0, new QTableWidgetItem());
+        ratesTableWidget->setItem(row, 1, new QTableWidgetItem());
+        ratesTableWidget->editItem(ratesTableWidget->item(row, 0));
+    });
+    layout->addWidget(addRateButton, 1, 0);
+    QPushButton* removeRateButton = new QPushButton("Remove Universe");
+    connect(removeRateButton, &QPushButton::clicked, this, [this] {
+        ratesTableWidget->removeRow(ratesTableWidget->currentRow());
+        loadUniverseRates();
+    });
+    layout->addWidget(removeRateButton, 1, 1);
+
+    sharedMemoryOutput = new SharedMemoryOutput(this);
+    connect(sharedMemoryOutput, &SharedMemoryOutput::statisticsChanged, this, &OutputSettings::statisticsChanged);
+    sharedMemoryCheckBox = new QCheckBox("Shared Memory Output");
+    sharedMemoryCheckBox->setChecked(settings->value("output/sharedmemory", false).toBool());
+    connect(sharedMemoryCheckBox, &QCheckBox::toggled, this, &OutputSettings::loadSharedMemory);
+    layout->addWidget(sharedMemoryCheckBox, 2, 0);
+    sharedMemoryNameLineEdit = new QLineEdit(settings->value("output/sharedmemoryname", "/zoeglfrex-dmx").toString());
+    connect(sharedMemoryNameLineEdit, &QLineEdit::editingFinished, this, &OutputSettings::loadSharedMemory);
+    layout->addWidget(sharedMemoryNameLineEdit, 2, 1);
+    loadSharedMemory();
+}
+
+void OutputSettings::loadSharedMemory() {
+    QString name = sharedMemoryNameLineEdit->text().trimmed();
+    if (!name.startsWith("/")) {
+        name.prepend("/");
+    }
+    if ((name.length() < 2) || name.mid(1).contains("/")) {
+        qWarning() << Q_FUNC_INFO << "Invalid shared memory name" << name;
+        name = "/zoeglfrex-dmx";
+    }
+    sharedMemoryNameLineEdit->setText(name);
+    settings->setValue("output/sharedmemory", sharedMemoryCheckBox->isChecked());
+    settings->setValue("output/sharedmemoryname", name);
+    sharedMemoryOutput->setName(sharedMemoryCheckBox->isChecked() ? name : QString());
+}
+
+SharedMemoryOutput* OutputSettings::getSharedMemoryOutput() const {
+    return sharedMemoryOutput;
+}
+
+void OutputSettings::loadUniverseRates() {
+    QHash<int, int> rates;
+    settings->beginWriteArray("output/rates");
+    for (int row = 0; row < ratesTableWidget->rowCount(); row++) {
+        const QTableWidgetItem* universeItem = ratesTableWidget->item(row, 0);
+        const QTableWidgetItem* rateItem = ratesTableWidget->item(row, 1);
+        const QString universeText = (universeItem == nullptr) ? QString() : universeItem->text();
+        const QString rateText = (rateItem == nullptr) ? QString() : rateItem->text();
+        settings->setArrayIndex(row);
+        settings->setValue("universe", universeText);
+        settings->setValue("rate", rateText);
+        bool universeOk = false;
+        bool rateOk = false;
+        const int universe = universeText.toInt(&universeOk);
+        const int rate = rateText.toInt(&rateOk);
+        if (universeOk && rateOk && (universe >= 1) && (universe <= 63999) && (rate >= 1)) {
+            rates[universe] = rate;
+        }
+    }
+    settings->endArray();
+    emit universeRatesChanged(rates);
+}
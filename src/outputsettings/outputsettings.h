@@ -0,0 +1,35 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef OUTPUTSETTINGS_H
+#define OUTPUTSETTINGS_H
+
+#include <QtWidgets>
+
+#include "sharedmemoryoutput/sharedmemoryoutput.h"
+
+class OutputSettings : public QWidget {
+    Q_OBJECT
+public:
+    OutputSettings(QWidget* parent = nullptr);
+    SharedMemoryOutput* getSharedMemoryOutput() const;
+public slots:
+    void loadUniverseRates();
+signals:
+    void universeRatesChanged(QHash<int, int> rates);
+    void statisticsChanged(QString key, QString value);
+private:
+    void loadSharedMemory();
+    QSettings* settings;
+    QTableWidget* ratesTableWidget;
+    SharedMemoryOutput* sharedMemoryOutput;
+    QCheckBox* sharedMemoryCheckBox;
+    QLineEdit* sharedMemoryNameLineEdit;
+};
+
+#endif // OUTPUTSETTINGS_H
@@ -0,0 +1,50 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "dmxframe.h"
+
+void DmxFrame::setUniverses(const QHash<int, QByteArray> universeData) {
+    reserveUniverses(universeData.size());
+    universeCount = 0;
+    for (QHash<int, QByteArray>::const_iterator universe = universeData.constBegin(); universe != universeData.constEnd(); universe++) {
+        Q_ASSERT(universe.value().size() <= 512);
+        universes[universeCount] = universe.key();
+        data[universeCount].resize(universe.value().size());
+        memcpy(data[universeCount].data(), universe.value().constData(), universe.value().size());
+        universeCount++;
+    }
+}
+
+void DmxFrame::copy(const DmxFrame& frame) {
+    reserveUniverses(frame.universeCount);
+    number = frame.number;
+    timestamp = frame.timestamp;
+    universeCount = frame.universeCount;
+    for (int index = 0; index < universeCount; index++) {
+        universes[index] = frame.universes.at(index);
+        data[index].resize(frame.data.at(index).size());
+        memcpy(data[index].data(), frame.data.at(index).constData(), frame.data.at(index).size());
+    }
+}
+
+void DmxFrame::appendUniverse(const int universe, const QByteArray& universeData) {
+    reserveUniverses(universeCount + 1);
+    universes[universeCount] = universe;
+    data[universeCount].resize(universeData.size());
+    memcpy(data[universeCount].data(), universeData.constData(), universeData.size());
+    universeCount++;
+}
+
+void DmxFrame::reserveUniverses(const int count) {
+    while (universes.length() < count) {
+        universes.append(0);
+        QByteArray buffer;
+        buffer.reserve(512);
+        data.append(buffer);
+    }
+}
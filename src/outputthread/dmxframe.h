@@ -0,0 +1,27 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DMXFRAME_H
+#define DMXFRAME_H
+
+#include <QtCore>
+
+struct DmxFrame {
+    quint64 number = 0;
+    qint64 timestamp = 0;
+    int universeCount = 0;
+    QList<int> universes;
+    QList<QByteArray> data;
+    void setUniverses(QHash<int, QByteArray> universeData);
+    void copy(const DmxFrame& frame);
+    void appendUniverse(int universe, const QByteArray& universeData);
+private:
+    void reserveUniverses(int count);
+};
+
+#endif // DMXFRAME_H
@@ -0,0 +1,29 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMEOUTPUT_H
+#define FRAMEOUTPUT_H
+
+#include <QtCore>
+
+#include "outputthread/dmxframe.h"
+
+// Everything the output thread sends its frames to
+class FrameOutput : public QObject {
+    Q_OBJECT
+public:
+    FrameOutput(QObject* parent = nullptr) : QObject(parent) {}
+    virtual void sendFrame(const DmxFrame& frame) = 0;
+    virtual int getMaximumRate() const = 0;
+    virtual bool usesUniverseRates() const { return true; } // otherwise every frame contains all universes
+    virtual void close() {} // called on the output thread when it stops
+signals:
+    void statisticsChanged(QString key, QString value);
+};
+
+#endif // FRAMEOUTPUT_H
@@ -0,0 +1,49 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMEQUEUE_H
+#define FRAMEQUEUE_H
+
+#include <atomic>
+
+// Lock-free ring buffer for exactly one producer and one consumer thread
+template <typename T, int CAPACITY>
+class FrameQueue {
+public:
+    T* back() {
+        const int head = writeIndex.load(std::memory_order_relaxed);
+        if (((head + 1) % CAPACITY) == readIndex.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items[head];
+    }
+    void push() {
+        const int head = writeIndex.load(std::memory_order_relaxed);
+        writeIndex.store((head + 1) % CAPACITY, std::memory_order_release);
+    }
+    T* front() {
+        const int tail = readIndex.load(std::memory_order_relaxed);
+        if (tail == writeIndex.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items[tail];
+    }
+    void pop() {
+        const int tail = readIndex.load(std::memory_order_relaxed);
+        readIndex.store((tail + 1) % CAPACITY, std::memory_order_release);
+    }
+    int size() const {
+        return (writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire) + CAPACITY) % CAPACITY;
+    }
+private:
+    T items[CAPACITY];
+    alignas(64) std::atomic<int> writeIndex = 0;
+    alignas(64) std::atomic<int> readIndex = 0;
+};
+
+#endif // FRAMEQUEUE_H
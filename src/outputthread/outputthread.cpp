@@ -0,0 +1,149 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "outputthread.h"
+
+OutputThread::OutputThread(QObject* parent) : QThread(parent) {}
+
+OutputThread::~OutputThread() {
+    quit();
+    wait();
+}
+
+void OutputThread::addBackend(FrameOutput* backend) {
+    Q_ASSERT(!isRunning());
+    backends.append(backend);
+    backendTimers.append(QElapsedTimer());
+}
+
+void OutputThread::setInput(SacnInput* sacnInput) {
+    Q_ASSERT(!isRunning());
+    input = sacnInput;
+}
+
+void OutputThread::queueUniverses(const QHash<int, QByteArray> universes) {
+    DmxFrame* frame = queue.back();
+    if (frame == nullptr) {
+        droppedFrames++;
+        return;
+    }
+    frame->setUniverses(universes);
+    frame->number = frameNumber++;
+    frame->timestamp = QDateTime::currentMSecsSinceEpoch();
+    queue.push();
+}
+
+void OutputThread::setUniverseRates(const QHash<int, int> rates) {
+    QMutexLocker locker(&ratesMutex);
+    configuredUniverseRates = rates;
+    universeRatesChanged.store(true, std::memory_order_release);
+}
+
+void OutputThread::run() {
+    QTimer timer;
+    timer.setTimerType(Qt::PreciseTimer);
+    connect(&timer, &QTimer::timeout, &timer, [this] { sendFrame(); }, Qt::DirectConnection);
+    frameTimer.start();
+    statisticsTimer.start();
+    timer.start(FRAMEDURATION);
+    exec();
+    // Sockets must be closed on the thread they were created on
+    for (FrameOutput* backend : backends) {
+        backend->close();
+    }
+    if (input != nullptr) {
+        input->close();
+    }
+}
+
+void OutputThread::sendFrame() {
+    const qint64 jitter = std::abs(frameTimer.nsecsElapsed() - (qint64)FRAMEDURATION * 1000000);
+    frameTimer.restart();
+    while (queue.size() > 1) {
+        queue.pop();
+        statisticsSkippedFrames++;
+    }
+    const DmxFrame* frame = queue.front();
+    if (frame != nullptr) {
+        currentFrame.copy(*frame);
+        queue.pop();
+    }
+    const DmxFrame* outputFrame = &currentFrame;
+    if ((input != nullptr) && input->mergeFrame(currentFrame, &mergedFrame)) {
+        outputFrame = &mergedFrame;
+    }
+
+    bool universesChanged = (outputFrame->universeCount != scheduledUniverses.length());
+    for (int index = 0; !universesChanged && (index < outputFrame->universeCount); index++) {
+        universesChanged = (outputFrame->universes.at(index) != scheduledUniverses.at(index));
+    }
+    if (universesChanged || universeRatesChanged.load(std::memory_order_acquire)) {
+        scheduleUniverses(*outputFrame);
+    }
+    scheduledFrame.number = outputFrame->number;
+    scheduledFrame.timestamp = outputFrame->timestamp;
+    scheduledFrame.universeCount = 0;
+    for (int index = 0; index < outputFrame->universeCount; index++) {
+        const int universe = outputFrame->universes.at(index);
+        const int interval = universeIntervals.value(universe, 1);
+        if (((outputFrameNumber + universePhases.value(universe, 0)) % interval) == 0) {
+            scheduledFrame.appendUniverse(universe, outputFrame->data.at(index));
+        }
+    }
+    outputFrameNumber++;
+
+    for (int backend = 0; backend < backends.length(); backend++) {
+        // The timer may fire a bit early, so a tick is only skipped if it comes more than half a frame too early
+        const qint64 minimalInterval = (1000000000 / backends.at(backend)->getMaximumRate()) - ((qint64)FRAMEDURATION * 1000000 / 2);
+        if (backendTimers.at(backend).isValid() && (backendTimers.at(backend).nsecsElapsed() < minimalInterval)) {
+            continue;
+        }
+        backendTimers[backend].start();
+        backends.at(backend)->sendFrame(backends.at(backend)->usesUniverseRates() ? scheduledFrame : *outputFrame);
+    }
+
+    statisticsFrames++;
+    statisticsMaxJitter = std::max(jitter, statisticsMaxJitter);
+    const qint64 elapsedTime = statisticsTimer.nsecsElapsed();
+    if (elapsedTime >= 1000000000) {
+        const float seconds = elapsedTime / 1000000000.0;
+        emit statisticsChanged("Output Frames", QString::number(statisticsFrames / seconds, 'f', 1) + " / s");
+        emit statisticsChanged("Output Timer Jitter", QString::number(statisticsMaxJitter / 1000000.0, 'f', 3) + " ms (max)");
+        emit statisticsChanged("Output Skipped Frames", QString::number(statisticsSkippedFrames) + " / s");
+        emit statisticsChanged("Output Dropped Frames", QString::number(droppedFrames.exchange(0)) + " / s");
+        statisticsFrames = 0;
+        statisticsSkippedFrames = 0;
+        statisticsMaxJitter = 0;
+        statisticsTimer.restart();
+    }
+}
+
+void OutputThread::scheduleUniverses(const DmxFrame& frame) {
+    if (universeRatesChanged.load(std::memory_order_acquire)) {
+        QMutexLocker locker(&ratesMutex);
+        universeRatesChanged.store(false, std::memory_order_release);
+        universeRates = configuredUniverseRates;
+    }
+    scheduledUniverses.clear();
+    for (int index = 0; index < frame.universeCount; index++) {
+        scheduledUniverses.append(frame.universes.at(index));
+    }
+    QList<int> sortedUniverses = scheduledUniverses;
+    std::sort(sortedUniverses.begin(), sortedUniverses.end());
+    universeIntervals.clear();
+    universePhases.clear();
+    QHash<int, int> intervalUniverses;
+    const int frameRate = 1000 / FRAMEDURATION;
+    for (const int universe : sortedUniverses) {
+        const int rate = universeRates.value(universe, frameRate);
+        const int interval = std::max(1, (int)std::lround((float)frameRate / std::max(rate, 1)));
+        universeIntervals[universe] = interval;
+        universePhases[universe] = intervalUniverses.value(interval, 0) % interval;
+        intervalUniverses[interval]++;
+    }
+}
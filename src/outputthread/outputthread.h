@@ -0,0 +1,61 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef OUTPUTTHREAD_H
+#define OUTPUTTHREAD_H
+
+#include <QtCore>
+
+#include "outputthread/dmxframe.h"
+#include "outputthread/framequeue.h"
+#include "outputthread/frameoutput.h"
+#include "sacnserver/sacninput.h"
+
+class OutputThread : public QThread {
+    Q_OBJECT
+public:
+    OutputThread(QObject* parent = nullptr);
+    ~OutputThread();
+    void addBackend(FrameOutput* backend);
+    void setInput(SacnInput* sacnInput);
+public slots:
+    void queueUniverses(QHash<int, QByteArray> universes);
+    void setUniverseRates(QHash<int, int> rates);
+signals:
+    void statisticsChanged(QString key, QString value);
+protected:
+    void run() override;
+private:
+    void sendFrame();
+    void scheduleUniverses(const DmxFrame& frame);
+    FrameQueue<DmxFrame, 4> queue;
+    DmxFrame currentFrame;
+    DmxFrame mergedFrame;
+    DmxFrame scheduledFrame;
+    quint64 outputFrameNumber = 0;
+    QMutex ratesMutex;
+    QHash<int, int> configuredUniverseRates;
+    std::atomic<bool> universeRatesChanged = false;
+    QHash<int, int> universeRates;
+    QList<int> scheduledUniverses;
+    QHash<int, int> universeIntervals;
+    QHash<int, int> universePhases;
+    quint64 frameNumber = 0;
+    std::atomic<int> droppedFrames = 0;
+    QList<FrameOutput*> backends;
+    QList<QElapsedTimer> backendTimers;
+    SacnInput* input = nullptr;
+    QElapsedTimer frameTimer;
+    QElapsedTimer statisticsTimer;
+    int statisticsFrames = 0;
+    int statisticsSkippedFrames = 0;
+    qint64 statisticsMaxJitter = 0;
+    const int FRAMEDURATION = 25;
+};
+
+#endif // OUTPUTTHREAD_H
@@ -0,0 +1,299 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "sacninput.h"
+
+#ifdef Q_OS_LINUX
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+SacnInput::SacnInput(QObject* parent) : QObject(parent) {
+    clock.start();
+    statisticsTimer.start();
+}
+
+void SacnInput::setInterface(const QNetworkInterface networkInterface, const QNetworkAddressEntry address) {
+    QMutexLocker locker(&configurationMutex);
+    configuredConfiguration.networkInterface = networkInterface;
+    configuredConfiguration.address = address;
+    configurationChanged.store(true, std::memory_order_release);
+}
+
+void SacnInput::setUniverses(const QSet<int> universes) {
+    QMutexLocker locker(&configurationMutex);
+    configuredConfiguration.universes = universes;
+    configurationChanged.store(true, std::memory_order_release);
+}
+
+void SacnInput::setLocalPriority(const int priority) {
+    QMutexLocker locker(&configurationMutex);
+    configuredConfiguration.localPriority = priority;
+    configurationChanged.store(true, std::memory_order_release);
+}
+
+void SacnInput::setIgnoredCid(const QByteArray cid) {
+    QMutexLocker locker(&configurationMutex);
+    configuredConfiguration.ignoredCid = cid;
+    configurationChanged.store(true, std::memory_order_release);
+}
+
+bool SacnInput::mergeFrame(const DmxFrame& localFrame, DmxFrame* mergedFrame) {
+    if (configurationChanged.load(std::memory_order_acquire)) {
+        QMutexLocker locker(&configurationMutex);
+        configurationChanged.store(false, std::memory_order_release);
+        configuration = configuredConfiguration;
+        applyConfiguration();
+    }
+    if (sockets.isEmpty()) {
+        return false;
+    }
+    const qint64 time = clock.elapsed();
+    readPackets(time);
+
+    QElapsedTimer mergeTimer;
+    mergeTimer.start();
+    mergedFrame->copy(localFrame);
+    for (Universe& universe : universes) {
+        int priority = -1;
+        for (Source& source : universe.sources) {
+            if (source.active && ((time - source.lastPacketTime) > SOURCETIMEOUT)) {
+                source.active = false;
+            }
+            if (source.active) {
+                priority = std::max(source.priority, priority);
+            }
+        }
+        if (priority < 0) {
+            continue;
+        }
+        int index = -1;
+        for (int frameIndex = 0; frameIndex < mergedFrame->universeCount; frameIndex++) {
+            if (mergedFrame->universes.at(frameIndex) == universe.universe) {
+                index = frameIndex;
+            }
+        }
+        if (index < 0) {
+            mergedFrame->appendUniverse(universe.universe, QByteArray());
+            mergeUniverse(universe, priority, &mergedFrame->data[mergedFrame->universeCount - 1], false);
+        } else if (priority >= configuration.localPriority) {
+            mergeUniverse(universe, priority, &mergedFrame->data[index], (priority == configuration.localPriority));
+        }
+    }
+    statisticsMaxMergeTime = std::max(mergeTimer.nsecsElapsed(), statisticsMaxMergeTime);
+    sendStatistics();
+    return true;
+}
+
+void SacnInput::close() {
+    qDeleteAll(sockets);
+    sockets.clear();
+}
+
+void SacnInput::applyConfiguration() {
+    close();
+    universes.clear();
+    universeIndexes.clear();
+    QList<int> sortedUniverses = configuration.universes.values();
+    std::sort(sortedUniverses.begin(), sortedUniverses.end());
+    for (const int universeNumber : sortedUniverses) {
+        Universe universe;
+        universe.universe = universeNumber;
+        for (int source = 0; source < MAXSOURCES; source++) {
+            Source preallocatedSource;
+            preallocatedSource.cid = QByteArray(16, 0);
+            preallocatedSource.data.reserve(512);
+            universe.sources.append(preallocatedSource);
+        }
+        universeIndexes[universeNumber] = universes.length();
+        universes.append(universe);
+    }
+    if (!configuration.networkInterface.isValid() || sortedUniverses.isEmpty()) {
+        return;
+    }
+
+#ifdef Q_OS_LINUX
+    // Linux limits the number of multicast groups per socket (net.ipv4.igmp_max_memberships)
+    const int groupsPerSocket = 20;
+#else
+    const int groupsPerSocket = 63999;
+#endif
+    QList<QHostAddress> groups;
+    groups.append(QHostAddress("239.255.250.214"));
+    for (const int universe : sortedUniverses) {
+        groups.append(QHostAddress((239u << 24) | (255u << 16) | (quint32)universe));
+    }
+    for (int firstGroup = 0; firstGroup < groups.length(); firstGroup += groupsPerSocket) {
+        QUdpSocket* socket = new QUdpSocket();
+        if (!socket->bind(QHostAddress::AnyIPv4, 5568, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+            qWarning() << Q_FUNC_INFO << "Can't bind sACN input socket:" << socket->errorString();
+            delete socket;
+            return;
+        }
+        socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 1024 * 1024);
+#ifdef Q_OS_LINUX
+        // Only receive the groups joined on this socket, otherwise every socket receives all packets
+        const int multicastAll = 0;
+        setsockopt(socket->socketDescriptor(), IPPROTO_IP, IP_MULTICAST_ALL, &multicastAll, sizeof(multicastAll));
+#endif
+        for (int group = firstGroup; (group < groups.length()) && (group < (firstGroup + groupsPerSocket)); group++) {
+            if (!socket->joinMulticastGroup(groups.at(group), configuration.networkInterface)) {
+                qWarning() << Q_FUNC_INFO << "Can't join multicast group" << groups.at(group).toString() << socket->errorString();
+            }
+        }
+        sockets.append(socket);
+    }
+}
+
+void SacnInput::readPackets(const qint64 time) {
+    for (QUdpSocket* socket : sockets) {
+        while (socket->hasPendingDatagrams()) {
+            const qint64 size = socket->readDatagram(packetBuffer.data(), packetBuffer.size());
+            if (size < 0) {
+                break;
+            }
+            parsePacket(packetBuffer.constData(), (int)size, time);
+        }
+    }
+}
+
+void SacnInput::parsePacket(const char* packet, const int size, const qint64 time) {
+    if ((size < 126) || (memcmp(packet + 4, "ASC-E1.17\0\0\0", 12) != 0)) {
+        return;
+    }
+
+    // Only accept DMX data packets (Root Vector 0x04, Framing Vector 0x02, DMP Vector 0x02)
+    if ((readNumber(packet, 18, 4) != 0x04) || (readNumber(packet, 40, 4) != 0x02) || ((uint8_t)packet[117] != 0x02)) {
+        return;
+    }
+
+    // Per-address priority packets (Start Code 0xdd) aren't supported
+    if (packet[125] != 0) {
+        return;
+    }
+
+    // Ignore preview data (Options Bit 7)
+    const uint8_t options = (uint8_t)packet[112];
+    if ((options & 0x80) != 0) {
+        return;
+    }
+
+    const int universeNumber = readNumber(packet, 113, 2);
+    if (!universeIndexes.contains(universeNumber)) {
+        return;
+    }
+    const char* cid = packet + 22;
+    if ((configuration.ignoredCid.length() == 16) && (memcmp(cid, configuration.ignoredCid.constData(), 16) == 0)) {
+        return;
+    }
+    const int slotCount = readNumber(packet, 123, 2) - 1;
+    if ((slotCount < 0) || (slotCount > 512) || (size < (126 + slotCount))) {
+        return;
+    }
+
+    Universe& universe = universes[universeIndexes.value(universeNumber)];
+    Source* source = nullptr;
+    Source* freeSource = nullptr;
+    for (Source& candidate : universe.sources) {
+        if (candidate.active && (memcmp(candidate.cid.constData(), cid, 16) == 0)) {
+            source = &candidate;
+            break;
+        }
+        if (!candidate.active && (freeSource == nullptr)) {
+            freeSource = &candidate;
+        }
+    }
+
+    // Stream Terminated (Options Bit 6)
+    if ((options & 0x40) != 0) {
+        if (source != nullptr) {
+            source->active = false;
+        }
+        return;
+    }
+
+    const int sequence = (uint8_t)packet[111];
+    if (source == nullptr) {
+        if (freeSource == nullptr) {
+            statisticsDroppedSources++;
+            return;
+        }
+        source = freeSource;
+        source->active = true;
+        memcpy(source->cid.data(), cid, 16);
+    } else {
+        const int8_t difference = (int8_t)(sequence - source->sequence);
+        if ((difference <= 0) && (difference > -20)) {
+            return;
+        }
+        if (difference > 1) {
+            statisticsLostPackets += difference - 1;
+        }
+    }
+    source->sequence = sequence;
+    source->priority = std::min((int)(uint8_t)packet[108], 200);
+    source->lastPacketTime = time;
+    source->data.resize(slotCount);
+    memcpy(source->data.data(), packet + 126, slotCount);
+    statisticsPackets++;
+}
+
+void SacnInput::mergeUniverse(const Universe& universe, const int priority, QByteArray* data, const bool includeData) {
+    if (!includeData) {
+        data->resize(0);
+    }
+    for (const Source& source : universe.sources) {
+        if (!source.active || (source.priority != priority)) {
+            continue;
+        }
+        const int size = data->size();
+        if (source.data.size() > size) {
+            data->resize(source.data.size());
+            memset(data->data() + size, 0, source.data.size() - size);
+        }
+        uint8_t* values = (uint8_t*)data->data();
+        const uint8_t* sourceValues = (const uint8_t*)source.data.constData();
+        for (int slot = 0; slot < source.data.size(); slot++) {
+            values[slot] = std::max(values[slot], sourceValues[slot]);
+        }
+    }
+}
+
+void SacnInput::sendStatistics() {
+    const qint64 elapsedTime = statisticsTimer.nsecsElapsed();
+    if (elapsedTime < 1000000000) {
+        return;
+    }
+    const float seconds = elapsedTime / 1000000000.0;
+    QSet<QByteArray> sources;
+    for (const Universe& universe : universes) {
+        for (const Source& source : universe.sources) {
+            if (source.active) {
+                sources.insert(source.cid);
+            }
+        }
+    }
+    emit statisticsChanged("sACN Input Packets", QString::number(statisticsPackets / seconds, 'f', 0) + " / s");
+    emit statisticsChanged("sACN Input Sources", QString::number(sources.size()));
+    emit statisticsChanged("sACN Input Lost Packets", QString::number(statisticsLostPackets) + " / s");
+    emit statisticsChanged("sACN Input Dropped Sources", QString::number(statisticsDroppedSources) + " / s");
+    emit statisticsChanged("sACN Merge Time", QString::number(statisticsMaxMergeTime / 1000000.0, 'f', 3) + " ms (max)");
+    statisticsPackets = 0;
+    statisticsLostPackets = 0;
+    statisticsDroppedSources = 0;
+    statisticsMaxMergeTime = 0;
+    statisticsTimer.restart();
+}
+
+int SacnInput::readNumber(const char* packet, const int index, const int bytes) const {
+    int number = 0;
+    for (int byte = 0; byte < bytes; byte++) {
+        number = (number * 256) + (uint8_t)packet[index + byte];
+    }
+    return number;
+}
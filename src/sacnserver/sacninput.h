@@ -0,0 +1,72 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SACNINPUT_H
+#define SACNINPUT_H
+
+#include <QtNetwork>
+
+#include "outputthread/dmxframe.h"
+
+class SacnInput : public QObject {
+    Q_OBJECT
+public:
+    SacnInput(QObject* parent = nullptr);
+    void setInterface(QNetworkInterface networkInterface, QNetworkAddressEntry address);
+    void setUniverses(QSet<int> universes);
+    void setLocalPriority(int priority);
+    void setIgnoredCid(QByteArray cid);
+    bool mergeFrame(const DmxFrame& localFrame, DmxFrame* mergedFrame);
+    void close();
+signals:
+    void statisticsChanged(QString key, QString value);
+private:
+    struct Source {
+        QByteArray cid;
+        bool active = false;
+        int priority = 0;
+        int sequence = 0;
+        qint64 lastPacketTime = 0;
+        QByteArray data;
+    };
+    struct Universe {
+        int universe = 0;
+        QList<Source> sources;
+    };
+    struct Configuration {
+        QNetworkInterface networkInterface;
+        QNetworkAddressEntry address;
+        QSet<int> universes;
+        int localPriority = 100;
+        QByteArray ignoredCid;
+    };
+    void applyConfiguration();
+    void readPackets(qint64 time);
+    void parsePacket(const char* packet, int size, qint64 time);
+    void mergeUniverse(const Universe& universe, int priority, QByteArray* data, bool includeData);
+    void sendStatistics();
+    int readNumber(const char* packet, int index, int bytes) const;
+    QMutex configurationMutex;
+    Configuration configuredConfiguration;
+    std::atomic<bool> configurationChanged = false;
+    Configuration configuration;
+    QList<QUdpSocket*> sockets;
+    QList<Universe> universes;
+    QHash<int, int> universeIndexes;
+    QByteArray packetBuffer = QByteArray(1144, 0);
+    QElapsedTimer clock;
+    QElapsedTimer statisticsTimer;
+    int statisticsPackets = 0;
+    int statisticsLostPackets = 0;
+    int statisticsDroppedSources = 0;
+    qint64 statisticsMaxMergeTime = 0;
+    const int MAXSOURCES = 8;
+    const qint64 SOURCETIMEOUT = 2500;
+};
+
+#endif // SACNINPUT_H
@@ -0,0 +1,390 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "sacnoutput.h"
+
+SacnOutput::SacnOutput(QObject* parent) : OutputBackend("sACN", 5568, parent) {
+    sourceName = QString("Zöglfrex - " + QHostInfo::localHostName()).toUtf8();
+    sourceName.truncate(63);
+    sourceName.resize(64, (char)0x00);
+    universes.reserve(512);
+    syncPacket = createSyncPacket();
+}
+
+bool SacnOutput::supportsSync() const {
+    return true;
+}
+
+int SacnOutput::getMaximumRate() const {
+    return 1000;
+}
+
+QByteArray SacnOutput::getCid() const {
+    return cid;
+}
+
+void SacnOutput::setSyncUniverse(const int universe) {
+    QMutexLocker locker(&configurationMutex);
+    configuration.syncUniverse = universe;
+    setConfigurationChanged();
+}
+
+void SacnOutput::applyConfiguration() {
+    syncUniverse = configuration.syncUniverse;
+}
+
+void SacnOutput::queueFrame(const DmxFrame& frame) {
+    universes.clear();
+    for (int index = 0; index < frame.universeCount; index++) {
+        const int universe = frame.universes.at(index);
+        const QByteArray& data = frame.data.at(index);
+        universes.append(universe);
+        universeListUniverses.insert(universe);
+        Q_ASSERT(data.size() <= 512);
+        Q_ASSERT(universe <= 63999);
+        Q_ASSERT(universe >= 1);
+
+        QByteArray* packet = getDataPacket(universe);
+        packet->resize(126 + data.size());
+        char* packetData = packet->data();
+
+        // Synchronization Address (Octet 109-110)
+        packetData[109] = (char)(syncUniverse / 256);
+        packetData[110] = (char)(syncUniverse % 256);
+
+        // Sequence Number (Octet 111)
+        packetData[111] = (char)((uint8_t)packetData[111] + 1);
+
+        // Property Value Count (Octet 123-124)
+        packetData[123] = (char)((data.size() + 1) / 256);
+        packetData[124] = (char)((data.size() + 1) % 256);
+
+        // Property Values (Octet 126-637)
+        memcpy(packetData + 126, data.constData(), data.size());
+
+        updateFlagsAndLength(packet, 16);
+        updateFlagsAndLength(packet, 38);
+        updateFlagsAndLength(packet, 115);
+
+        queuePacket(*packet, universe);
+    }
+    if (syncUniverse > 0) {
+        char* packetData = syncPacket.data();
+
+        // Sequence Number (Octet 44)
+        packetData[44] = (char)syncSequence;
+
+        // Synchronization Address (Octet 45-46)
+        packetData[45] = (char)(syncUniverse / 256);
+        packetData[46] = (char)(syncUniverse % 256);
+
+        queuePacket(syncPacket, syncUniverse, true);
+        syncSequence++;
+    }
+
+    if (!universeListTimer.isValid() || universeListTimer.hasExpired(10000)) {
+        queueUniverseList();
+        universeListTimer.start();
+    }
+}
+
+void SacnOutput::prepareInterface(const Interface& interface) {
+    for (const int universe : universes) {
+        // Priority (Octet 108)
+        getDataPacket(universe)->data()[108] = (char)interface.priority;
+    }
+}
+
+quint32 SacnOutput::getDefaultDestination(const int universe, const QNetworkAddressEntry& address) const {
+    Q_UNUSED(address);
+    return ((239u << 24) | (255u << 16) | universe);
+}
+
+QByteArray SacnOutput::createDataPacket(const int universe) {
+    QByteArray packet;
+    // Root Layer
+    // Preamble Size (Octet 0-1)
+    packet.append((char)0x00);
+    packet.append((char)0x10);
+
+    // Postamble Size (Octet 2-3)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // ACN Packet Identifier (Octet 4-15)
+    packet.append((char)0x41);
+    packet.append((char)0x53);
+    packet.append((char)0x43);
+    packet.append((char)0x2d);
+    packet.append((char)0x45);
+    packet.append((char)0x31);
+    packet.append((char)0x2e);
+    packet.append((char)0x31);
+    packet.append((char)0x37);
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Flags and Length (Octet 16-17)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Vector (Octet 18-21)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x04);
+
+    // CID (Octet 22-37)
+    Q_ASSERT(cid.length() == 16);
+    packet.append(cid);
+
+    // Framing Layer
+    // Flags and Length (Octet 38-39)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Vector (Octet 40-43)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x02);
+
+    // Source Name (Octet 44-107)
+    packet.append(sourceName);
+
+    // Priority (Octet 108)
+    packet.append((char)100);
+
+    // Synchronization Address (Octet 109-110)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Sequence Number (Octet 111)
+    packet.append((char)0x00);
+
+    // Options (Octet 112)
+    packet.append((char)0x00); // deselect all options
+
+    // Universe (Octet 113-114)
+    packet.append((char)(universe / 256));
+    packet.append((char)(universe % 256));
+
+    // DMP Layer
+    // Flags and Length (Octet 115-116)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Vector (Octet 117)
+    packet.append((char)0x02);
+
+    // Address Type & Data Type (Octet 118)
+    packet.append((char)0xa1);
+
+    // First Property Address (Octet 119-120)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Address Increment (Octet 121-122)
+    packet.append((char)0x00);
+    packet.append((char)0x01);
+
+    // Property Value Count (Octet 123-124)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Start Code (Octet 125)
+    packet.append((char)0x00);
+
+    packet.reserve(126 + 512);
+    return packet;
+}
+
+QByteArray SacnOutput::createSyncPacket() {
+    QByteArray packet;
+    // Root Layer
+    // Preamble Size (Octet 0-1)
+    packet.append((char)0x00);
+    packet.append((char)0x10);
+
+    // Postamble Size (Octet 2-3)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // ACN Packet Identifier (Octet 4-15)
+    packet.append((char)0x41);
+    packet.append((char)0x53);
+    packet.append((char)0x43);
+    packet.append((char)0x2d);
+    packet.append((char)0x45);
+    packet.append((char)0x31);
+    packet.append((char)0x2e);
+    packet.append((char)0x31);
+    packet.append((char)0x37);
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Flags and Length (Octet 16-17)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Vector (Octet 18-21)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x08);
+
+    // CID (Octet 22-37)
+    Q_ASSERT(cid.length() == 16);
+    packet.append(cid);
+
+    // Framing Layer
+    // Flags and Length (Octet 38-39)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Vector (Octet 40-43)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+    packet.append((char)0x01);
+
+    // Sequence Number (Octet 44)
+    packet.append((char)0x00);
+
+    // Synchronization Address (Octet 45-46)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    // Reserved (Octet 47-48)
+    packet.append((char)0x00);
+    packet.append((char)0x00);
+
+    updateFlagsAndLength(&packet, 16);
+    updateFlagsAndLength(&packet, 38);
+    return packet;
+}
+
+void SacnOutput::queueUniverseList() {
+    QList<int> sortedUniverses = universeListUniverses.values();
+    universeListUniverses.clear();
+    std::sort(sortedUniverses.begin(), sortedUniverses.end());
+
+    QList<QList<int>> universePages;
+    QList<int> pageUniverses;
+    for (const int universe : sortedUniverses) {
+        if (pageUniverses.length() >= 512) {
+            universePages.append(pageUniverses);
+            pageUniverses.clear();
+        }
+        pageUniverses.append(universe);
+    }
+    universePages.append(pageUniverses);
+
+    universeListPackets.clear();
+    for (int page = 0; page < universePages.length(); page++) {
+        QByteArray packet;
+        // Root Layer
+        // Preamble Size (Octet 0-1)
+        packet.append((char)0x00);
+        packet.append((char)0x10);
+
+        // Postamble Size (Octet 2-3)
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+
+        // ACN Packet Identifier (Octet 4-15)
+        packet.append((char)0x41);
+        packet.append((char)0x53);
+        packet.append((char)0x43);
+        packet.append((char)0x2d);
+        packet.append((char)0x45);
+        packet.append((char)0x31);
+        packet.append((char)0x2e);
+        packet.append((char)0x31);
+        packet.append((char)0x37);
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+
+        // Flags and Length (Octet 16-17)
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+
+        // Vector (Octet 18-21)
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x08);
+
+        // CID (Octet 22-37)
+        Q_ASSERT(cid.length() == 16);
+        packet.append(cid);
+
+        // Framing Layer
+        // Flags and Length (Octet 38-39)
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+
+        // Vector (Octet 40-43)
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x02);
+
+        // Source Name (Octet 44-107)
+        packet.append(sourceName);
+
+        // Reserved (Octet 108-111)
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+
+        // Universe Discovery Layer
+        // Flags and Length (Octet 112-113)
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+
+        // Vector (Octet 114-117)
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x00);
+        packet.append((char)0x01);
+
+        // Page (Octet 118)
+        packet.append((char)page);
+
+        // Last Page (Octet 119)
+        packet.append((char)(universePages.length() - 1));
+
+        // List of Universes (Octet 120-1143)
+        Q_ASSERT(universePages.at(page).length() <= 512);
+        for (const int universe : universePages.at(page)) {
+            packet.append((char)(universe / 256));
+            packet.append((char)(universe % 256));
+        }
+
+        updateFlagsAndLength(&packet, 16);
+        updateFlagsAndLength(&packet, 38);
+        updateFlagsAndLength(&packet, 112);
+        universeListPackets.append(packet);
+    }
+    const quint32 address = QHostAddress("239.255.250.214").toIPv4Address();
+    for (const QByteArray& packet : universeListPackets) {
+        queueDatagram(packet, address);
+    }
+}
+
+void SacnOutput::updateFlagsAndLength(QByteArray* data, const int index) {
+    int length = 0x7000;
+    length += data->length() - index;
+    (*data)[index] = (char)(length / 256);
+    (*data)[index + 1] = (char)(length % 256);
+}
@@ -0,0 +1,49 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SACNOUTPUT_H
+#define SACNOUTPUT_H
+
+#include <QtNetwork>
+
+#include "outputbackend/outputbackend.h"
+
+class SacnOutput : public OutputBackend {
+    Q_OBJECT
+public:
+    SacnOutput(QObject* parent = nullptr);
+    bool supportsSync() const override;
+    int getMaximumRate() const override;
+    void setSyncUniverse(int universe);
+    QByteArray getCid() const;
+protected:
+    void applyConfiguration() override;
+    void queueFrame(const DmxFrame& frame) override;
+    void prepareInterface(const Interface& interface) override;
+    QByteArray createDataPacket(int universe) override;
+    quint32 getDefaultDestination(int universe, const QNetworkAddressEntry& address) const override;
+private:
+    struct Configuration {
+        int syncUniverse = 0;
+    };
+    void queueUniverseList();
+    QByteArray createSyncPacket();
+    void updateFlagsAndLength(QByteArray* data, int index);
+    Configuration configuration;
+    uint8_t syncSequence = 0;
+    int syncUniverse = 0;
+    QList<int> universes;
+    QByteArray syncPacket;
+    QSet<int> universeListUniverses;
+    QList<QByteArray> universeListPackets;
+    QByteArray sourceName;
+    const QByteArray cid = QUuid::createUuid().toRfc4122();
+    QElapsedTimer universeListTimer;
+};
+
+#endif // SACNOUTPUT_H
@@ -10,318 +10,261 @@
 
 SacnServer::SacnServer(QWidget* parent) : QWidget(parent, Qt::Window) {
     settings = new QSettings("Zoeglfrex");
+    output = new SacnOutput(this);
+    connect(output, &SacnOutput::statisticsChanged, this, &SacnServer::statisticsChanged);
+    output->setSyncUniverse(settings->value("sacn/syncuniverse", 0).toInt());
+    input = new SacnInput(this);
+    input->setIgnoredCid(output->getCid());
+    connect(input, &SacnInput::statisticsChanged, this, &SacnServer::statisticsChanged);
     QGridLayout* layout = new QGridLayout();
     setLayout(layout);
     setWindowTitle("Zöglfrex sACN Settings");
 
-    QLabel* networkInterfaceLabel = new QLabel("Network Interface");
-    layout->addWidget(networkInterfaceLabel, 0, 0);
-    networkInterfaceComboBox = new QComboBox();
+    QLabel* outputsLabel = new QLabel("Outputs");
+    layout->addWidget(outputsLabel, 0, 0);
+    outputsTableWidget = new QTableWidget(0, 3);
+    outputsTableWidget->setHorizontalHeaderLabels({"Network Interface", "Priority", "Universes"});
+    outputsTableWidget->verticalHeader()->hide();
+    outputsTableWidget->horizontalHeader()->setStretchLastSection(true);
     reloadNetworkInterfaces();
-
-    loadSocket(networkInterfaceComboBox->currentIndex());
-    connect(networkInterfaceComboBox, &QComboBox::currentIndexChanged, this, &SacnServer::loadSocket);
-    layout->addWidget(networkInterfaceComboBox, 0, 1);
+    if (!settings->contains("sacn/outputs/size") && settings->contains("sacn/interface") && (settings->value("sacn/interface") != "none")) {
+        addOutput(settings->value("sacn/interface").toString(), settings->value("sacn/address").toString(), settings->value("sacn/priority", 100).toInt(), QString());
+    }
+    const int outputs = settings->beginReadArray("sacn/outputs");
+    for (int row = 0; row < outputs; row++) {
+        settings->setArrayIndex(row);
+        addOutput(settings->value("interface").toString(), settings->value("address").toString(), settings->value("priority", 100).toInt(), settings->value("universes").toString());
+    }
+    settings->endArray();
+    loadOutputs();
+    connect(outputsTableWidget, &QTableWidget::itemChanged, this, &SacnServer::loadOutputs);
+    layout->addWidget(outputsTableWidget, 0, 1);
+
+    QPushButton* addOutputButton = new QPushButton("Add Output");
+    connect(addOutputButton, &QPushButton::clicked, this, [this] {
+        addOutput(QString(), QString(), 100, QString());
+        loadOutputs();
+    });
+    layout->addWidget(addOutputButton, 1, 0);
+    QPushButton* removeOutputButton = new QPushButton("Remove Output");
+    connect(removeOutputButton, &QPushButton::clicked, this, [this] {
+        outputsTableWidget->removeRow(outputsTableWidget->currentRow());
+        loadOutputs();
+    });
+    layout->addWidget(removeOutputButton, 1, 1);
 
     QPushButton* reloadNetworkInterfaceButton = new QPushButton("Reload Network Interfaces");
-    connect(reloadNetworkInterfaceButton, &QPushButton::clicked, this, &SacnServer::reloadNetworkInterfaces);
-    layout->addWidget(reloadNetworkInterfaceButton, 1, 0);
-
-    QLabel* priorityLabel = new QLabel("Priority");
-    layout->addWidget(priorityLabel, 2, 0);
-    QSpinBox* prioritySpinBox = new QSpinBox();
-    prioritySpinBox->setMinimum(0);
-    prioritySpinBox->setMaximum(200);
-    prioritySpinBox->setValue(settings->value("sacn/priority", 100).toInt());
-    connect(prioritySpinBox, &QSpinBox::valueChanged, this, [this](int port) {
-        settings->setValue("sacn/priority", port);
+    connect(reloadNetworkInterfaceButton, &QPushButton::clicked, this, [this] {
+        reloadNetworkInterfaces();
+        loadOutputs();
+        loadInput();
     });
-    layout->addWidget(prioritySpinBox, 2, 1);
-
-    QTimer* universeListTimer = new QTimer();
-    connect(universeListTimer, &QTimer::timeout, this, &SacnServer::sendUniverseList);
-    universeListTimer->start(10000);
+    layout->addWidget(reloadNetworkInterfaceButton, 2, 0);
+
+    QLabel* syncUniverseLabel = new QLabel("Sync Universe");
+    layout->addWidget(syncUniverseLabel, 3, 0);
+    QSpinBox* syncUniverseSpinBox = new QSpinBox();
+    syncUniverseSpinBox->setMinimum(0);
+    syncUniverseSpinBox->setMaximum(63999);
+    syncUniverseSpinBox->setSpecialValueText("Disabled");
+    syncUniverseSpinBox->setValue(settings->value("sacn/syncuniverse", 0).toInt());
+    connect(syncUniverseSpinBox, &QSpinBox::valueChanged, this, [this](int universe) {
+        output->setSyncUniverse(universe);
+        settings->setValue("sacn/syncuniverse", universe);
+    });
+    layout->addWidget(syncUniverseSpinBox, 3, 1);
+
+    QLabel* unicastLabel = new QLabel("Unicast Destinations");
+    layout->addWidget(unicastLabel, 4, 0);
+    unicastTableWidget = new QTableWidget(0, 2);
+    unicastTableWidget->setHorizontalHeaderLabels({"Universe", "IP Addresses"});
+    unicastTableWidget->verticalHeader()->hide();
+    unicastTableWidget->horizontalHeader()->setStretchLastSection(true);
+    const int unicastUniverses = settings->beginReadArray("sacn/unicast");
+    for (int row = 0; row < unicastUniverses; row++) {
+        settings->setArrayIndex(row);
+        unicastTableWidget->insertRow(row);
+        unicastTableWidget->setItem(row, 0, new QTableWidgetItem(settings->value("universe").toString()));
+        unicastTableWidget->setItem(row, 1, new QTableWidgetItem(settings->value("addresses").toString()));
+    }
+    settings->endArray();
+    loadUnicastDestinations();
+    connect(unicastTableWidget, &QTableWidget::itemChanged, this, &SacnServer::loadUnicastDestinations);
+    layout->addWidget(unicastTableWidget, 4, 1);
+
+    QPushButton* addUnicastButton = new QPushButton("Add Unicast Universe");
+    connect(addUnicastButton, &QPushButton::clicked, this, [this] {
+        const int row = unicastTableWidget->rowCount();
+        unicastTableWidget->insertRow(row);
+        unicastTableWidget->setItem(row, 0, new QTableWidgetItem());
+        unicastTableWidget->setItem(row, 1, new QTableWidgetItem());
+        unicastTableWidget->editItem(unicastTableWidget->item(row, 0));
+    });
+    layout->addWidget(addUnicastButton, 5, 0);
+    QPushButton* removeUnicastButton = new QPushButton("Remove Unicast Universe");
+    connect(removeUnicastButton, &QPushButton::clicked, this, [this] {
+        unicastTableWidget->removeRow(unicastTableWidget->currentRow());
+        loadUnicastDestinations();
+    });
+    layout->addWidget(removeUnicastButton, 5, 1);
+
+    QLabel* inputNetworkInterfaceLabel = new QLabel("Input Network Interface");
+    layout->addWidget(inputNetworkInterfaceLabel, 6, 0);
+    inputNetworkInterfaceComboBox = new QComboBox();
+    loadNetworkInterfaces(inputNetworkInterfaceComboBox, settings->value("sacn/input/interface").toString(), settings->value("sacn/input/address").toString());
+    connect(inputNetworkInterfaceComboBox, &QComboBox::currentIndexChanged, this, &SacnServer::loadInput);
+    layout->addWidget(inputNetworkInterfaceComboBox, 6, 1);
+
+    QLabel* inputUniversesLabel = new QLabel("Input Universes");
+    layout->addWidget(inputUniversesLabel, 7, 0);
+    inputUniversesLineEdit = new QLineEdit(settings->value("sacn/input/universes").toString());
+    inputUniversesLineEdit->setPlaceholderText("e.g. 1-4, 7");
+    connect(inputUniversesLineEdit, &QLineEdit::editingFinished, this, &SacnServer::loadInput);
+    layout->addWidget(inputUniversesLineEdit, 7, 1);
+
+    QLabel* localPriorityLabel = new QLabel("Local Priority");
+    layout->addWidget(localPriorityLabel, 8, 0);
+    localPrioritySpinBox = new QSpinBox();
+    localPrioritySpinBox->setMinimum(0);
+    localPrioritySpinBox->setMaximum(200);
+    localPrioritySpinBox->setValue(settings->value("sacn/input/priority", 100).toInt());
+    connect(localPrioritySpinBox, &QSpinBox::valueChanged, this, &SacnServer::loadInput);
+    layout->addWidget(localPrioritySpinBox, 8, 1);
+    loadInput();
 }
 
 void SacnServer::reloadNetworkInterfaces() {
-    networkInterfaceComboBox->clear();
     networkInterfaces.clear();
     networkAddresses.clear();
-    networkInterfaceComboBox->addItem("None");
-    int interfaceIndex = 0;
     for (QNetworkInterface interface : QNetworkInterface::allInterfaces()) {
         for (QNetworkAddressEntry address : interface.addressEntries()) {
             if (address.ip().protocol() == QAbstractSocket::IPv4Protocol) {
-                networkInterfaceComboBox->addItem(interface.name() + " (" + address.ip().toString() + ")");
                 networkInterfaces.append(interface);
                 networkAddresses.append(address);
-                if ((settings->value("sacn/interface") == interface.name()) && (settings->value("sacn/address") == address.ip().toString())) {
-                    interfaceIndex = networkInterfaces.length();
-                }
             }
         }
     }
-    networkInterfaceComboBox->setCurrentIndex(interfaceIndex);
-}
-
-void SacnServer::loadSocket(int index) {
-    index--;
-    delete socket;
-    socket = nullptr;
-    if (index >= 0) {
-        socket = new QUdpSocket();
-        socket->bind(networkAddresses.at(index).ip());
-        socket->setMulticastInterface(networkInterfaces.at(index));
-        settings->setValue("sacn/interface", networkInterfaces.at(index).name());
-        settings->setValue("sacn/address", networkAddresses.at(index).ip().toString());
-    } else {
-        settings->setValue("sacn/interface", "none");
-        settings->setValue("sacn/address", "none");
+    for (int row = 0; row < outputsTableWidget->rowCount(); row++) {
+        QComboBox* networkInterfaceComboBox = qobject_cast<QComboBox*>(outputsTableWidget->cellWidget(row, 0));
+        const QString interfaceName = networkInterfaceComboBox->currentData().toStringList().value(0);
+        const QString address = networkInterfaceComboBox->currentData().toStringList().value(1);
+        const QSignalBlocker blocker(networkInterfaceComboBox);
+        loadNetworkInterfaces(networkInterfaceComboBox, interfaceName, address);
+    }
+    if (inputNetworkInterfaceComboBox != nullptr) {
+        const QString interfaceName = inputNetworkInterfaceComboBox->currentData().toStringList().value(0);
+        const QString address = inputNetworkInterfaceComboBox->currentData().toStringList().value(1);
+        const QSignalBlocker blocker(inputNetworkInterfaceComboBox);
+        loadNetworkInterfaces(inputNetworkInterfaceComboBox, interfaceName, address);
     }
 }
 
-void SacnServer::sendUniverses(QHash<int, QByteArray> universeData) {
-    universes = universeData.keys();
-    if (socket == nullptr) {
-        return;
+void SacnServer::loadNetworkInterfaces(QComboBox* networkInterfaceComboBox, const QString interfaceName, const QString address) {
+    networkInterfaceComboBox->clear();
+    networkInterfaceComboBox->addItem("None", QStringList());
+    int interfaceIndex = 0;
+    for (int index = 0; index < networkInterfaces.length(); index++) {
+        const QString name = networkInterfaces.at(index).name();
+        const QString ip = networkAddresses.at(index).ip().toString();
+        networkInterfaceComboBox->addItem(name + " (" + ip + ")", QStringList({name, ip}));
+        if ((name == interfaceName) && (ip == address)) {
+            interfaceIndex = index + 1;
+        }
     }
-    for (const int universe : universeData.keys()) {
-        const QByteArray data = universeData.value(universe);
-        Q_ASSERT(data.size() <= 512);
-        Q_ASSERT(universe <= 63999);
-        Q_ASSERT(universe >= 1);
-
-        QByteArray packet;
-        // Root Layer
-        // Preamble Size (Octet 0-1)
-        packet.append((char)0x00);
-        packet.append((char)0x10);
-
-        // Postamble Size (Octet 2-3)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // ACN Packet Identifier (Octet 4-15)
-        packet.append((char)0x41);
-        packet.append((char)0x53);
-        packet.append((char)0x43);
-        packet.append((char)0x2d);
-        packet.append((char)0x45);
-        packet.append((char)0x31);
-        packet.append((char)0x2e);
-        packet.append((char)0x31);
-        packet.append((char)0x37);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Flags and Length (Octet 16-17)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Vector (Octet 18-21)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x04);
-
-        // CID (Octet 22-37)
-        Q_ASSERT(cid.length() == 16);
-        packet.append(cid);
-
-        // Framing Layer
-        // Flags and Length (Octet 38-39)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Vector (Octet 40-43)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x02);
-
-        // Source Name (Octet 44-107)
-        QByteArray source = QString("Zöglfrex - " + QHostInfo::localHostName()).toUtf8();
-        source.truncate(63);
-        source.resize(64, (char)0x00);
-        packet.append(source);
-
-        // Priority (Octet 108)
-        packet.append((char)settings->value("sacn/priority", 100).toInt());
-
-        // Synchronization Address (Octet 109-110)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Sequence Number (Octet 111)
-        packet.append(sequence);
-
-        // Options (Octet 112)
-        packet.append((char)0x00); // deselect all options
-
-        // Universe (Octet 113-114)
-        packet.append((char)(universe / 256));
-        packet.append((char)(universe % 256));
-
-        // DMP Layer
-        // Flags and Length (Octet 115-116)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Vector (Octet 117)
-        packet.append((char)0x02);
-
-        // Address Type & Data Type (Octet 118)
-        packet.append((char)0xa1);
-
-        // First Property Address (Octet 119-120)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Address Increment (Octet 121-122)
-        packet.append((char)0x00);
-        packet.append((char)0x01);
+    networkInterfaceComboBox->setCurrentIndex(interfaceIndex);
+}
 
-        // Property Value Count (Octet 123-124)
-        packet.append((char)((data.length() + 1) / 256));
-        packet.append((char)((data.length() + 1) % 256));
+void SacnServer::addOutput(const QString interfaceName, const QString address, const int priority, const QString universes) {
+    const QSignalBlocker blocker(outputsTableWidget);
+    const int row = outputsTableWidget->rowCount();
+    outputsTableWidget->insertRow(row);
 
-        // Start Code (Octet 125)
-        packet.append((char)0x00);
+    QComboBox* networkInterfaceComboBox = new QComboBox();
+    loadNetworkInterfaces(networkInterfaceComboBox, interfaceName, address);
+    connect(networkInterfaceComboBox, &QComboBox::currentIndexChanged, this, &SacnServer::loadOutputs);
+    outputsTableWidget->setCellWidget(row, 0, networkInterfaceComboBox);
 
-        // Property Values (Octet 126-637)
-        packet.append(data);
+    QSpinBox* prioritySpinBox = new QSpinBox();
+    prioritySpinBox->setMinimum(0);
+    prioritySpinBox->setMaximum(200);
+    prioritySpinBox->setValue(priority);
+    connect(prioritySpinBox, &QSpinBox::valueChanged, this, &SacnServer::loadOutputs);
+    outputsTableWidget->setCellWidget(row, 1, prioritySpinBox);
 
-        updateFlagsAndLength(&packet, 16);
-        updateFlagsAndLength(&packet, 38);
-        updateFlagsAndLength(&packet, 115);
+    outputsTableWidget->setItem(row, 2, new QTableWidgetItem(universes));
+}
 
-        const QString address = "239.255." + QString::number(universe / 256) + "." + QString::number(universe % 256);
-        const qint64 result = socket->writeDatagram(packet, QHostAddress(address), 5568);
-        if (result < 0) {
-            qWarning() << Q_FUNC_INFO << socket->error() << socket->errorString();
+void SacnServer::loadOutputs() {
+    QList<OutputBackend::Interface> interfaces;
+    settings->beginWriteArray("sacn/outputs");
+    for (int row = 0; row < outputsTableWidget->rowCount(); row++) {
+        const QComboBox* networkInterfaceComboBox = qobject_cast<QComboBox*>(outputsTableWidget->cellWidget(row, 0));
+        const QSpinBox* prioritySpinBox = qobject_cast<QSpinBox*>(outputsTableWidget->cellWidget(row, 1));
+        const QTableWidgetItem* universesItem = outputsTableWidget->item(row, 2);
+        const QString universesText = (universesItem == nullptr) ? QString() : universesItem->text();
+        const QStringList interfaceData = networkInterfaceComboBox->currentData().toStringList();
+        settings->setArrayIndex(row);
+        settings->setValue("interface", interfaceData.value(0, "none"));
+        settings->setValue("address", interfaceData.value(1, "none"));
+        settings->setValue("priority", prioritySpinBox->value());
+        settings->setValue("universes", universesText);
+        const int index = networkInterfaceComboBox->currentIndex() - 1;
+        if (index >= 0) {
+            OutputBackend::Interface interface;
+            interface.networkInterface = networkInterfaces.at(index);
+            interface.address = networkAddresses.at(index);
+            interface.priority = prioritySpinBox->value();
+            interface.universes = parseUniverses(universesText);
+            interfaces.append(interface);
         }
     }
-    sequence++;
+    settings->endArray();
+    output->setInterfaces(interfaces);
 }
 
-void SacnServer::sendUniverseList() {
-    if (socket == nullptr) {
-        return;
-    }
-    std::sort(universes.begin(), universes.end());
-
-    QList<QList<int>> universePages;
-    QList<int> pageUniverses;
-    for (const int universe : universes) {
-        if (pageUniverses.length() >= 512) {
-            universePages.append(pageUniverses);
-            pageUniverses.clear();
+QSet<int> SacnServer::parseUniverses(const QString text) {
+    QSet<int> universes;
+    for (const QString part : text.split(QRegularExpression("[,;\\s]+"), Qt::SkipEmptyParts)) {
+        const QStringList range = part.split("-");
+        bool startOk = false;
+        bool endOk = false;
+        const int start = range.first().toInt(&startOk);
+        const int end = range.last().toInt(&endOk);
+        if (!startOk || !endOk || (range.length() > 2) || (start < 1) || (end > 63999) || (start > end)) {
+            qWarning() << Q_FUNC_INFO << "Invalid universe range" << part;
+            continue;
         }
-        pageUniverses.append(universe);
-    }
-    universePages.append(pageUniverses);
-
-    for (int page = 0; page < universePages.length(); page++) {
-        QByteArray packet;
-        // Root Layer
-        // Preamble Size (Octet 0-1)
-        packet.append((char)0x00);
-        packet.append((char)0x10);
-
-        // Postamble Size (Octet 2-3)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // ACN Packet Identifier (Octet 4-15)
-        packet.append((char)0x41);
-        packet.append((char)0x53);
-        packet.append((char)0x43);
-        packet.append((char)0x2d);
-        packet.append((char)0x45);
-        packet.append((char)0x31);
-        packet.append((char)0x2e);
-        packet.append((char)0x31);
-        packet.append((char)0x37);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Flags and Length (Octet 16-17)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Vector (Octet 18-21)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x08);
-
-        // CID (Octet 22-37)
-        Q_ASSERT(cid.length() == 16);
-        packet.append(cid);
-
-        // Framing Layer
-        // Flags and Length (Octet 38-39)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Vector (Octet 40-43)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x02);
-
-        // Source Name (Octet 44-107)
-        QByteArray source = QString("Zöglfrex - " + QHostInfo::localHostName()).toUtf8();
-        source.truncate(63);
-        source.resize(64, (char)0x00);
-        packet.append(source);
-
-        // Reserved (Octet 108-111)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Universe Discovery Layer
-        // Flags and Length (Octet 112-113)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-
-        // Vector (Octet 114-117)
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x00);
-        packet.append((char)0x01);
-
-        // Page (Octet 118)
-        packet.append((char)page);
-
-        // Last Page (Octet 119)
-        packet.append((char)(pageUniverses.length() - 1));
-
-        // List of Universes (Octet 120-1143)
-        Q_ASSERT(universePages.at(page).length() <= 512);
-        for (const int universe : universePages.at(page)) {
-            packet.append((char)(universe / 256));
-            packet.append((char)(universe % 256));
+        for (int universe = start; universe <= end; universe++) {
+            universes.insert(universe);
         }
+    }
+    return universes;
+}
 
-        updateFlagsAndLength(&packet, 16);
-        updateFlagsAndLength(&packet, 38);
-        updateFlagsAndLength(&packet, 112);
+void SacnServer::loadUnicastDestinations() {
+    output->loadUnicastDestinations(unicastTableWidget, settings, "sacn/unicast", 63999);
+}
 
-        const qint64 result = socket->writeDatagram(packet, QHostAddress("239.255.250.214"), 5568);
-        if (result < 0) {
-            qWarning() << Q_FUNC_INFO << socket->error() << socket->errorString();
-        }
+void SacnServer::loadInput() {
+    const QStringList interfaceData = inputNetworkInterfaceComboBox->currentData().toStringList();
+    settings->setValue("sacn/input/interface", interfaceData.value(0, "none"));
+    settings->setValue("sacn/input/address", interfaceData.value(1, "none"));
+    settings->setValue("sacn/input/universes", inputUniversesLineEdit->text());
+    settings->setValue("sacn/input/priority", localPrioritySpinBox->value());
+    const int index = inputNetworkInterfaceComboBox->currentIndex() - 1;
+    if (index >= 0) {
+        input->setInterface(networkInterfaces.at(index), networkAddresses.at(index));
+    } else {
+        input->setInterface(QNetworkInterface(), QNetworkAddressEntry());
     }
+    input->setUniverses(parseUniverses(inputUniversesLineEdit->text()));
+    input->setLocalPriority(localPrioritySpinBox->value());
+}
+
+SacnOutput* SacnServer::getOutput() const {
+    return output;
 }
 
-void SacnServer::updateFlagsAndLength(QByteArray* data, const int index) {
-    int length = 0x7000;
-    length += data->length() - index;
-    (*data)[index] = (char)(length / 256);
-    (*data)[index + 1] = (char)(length % 256);
+SacnInput* SacnServer::getInput() const {
+    return input;
 }
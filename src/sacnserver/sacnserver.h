@@ -12,26 +12,36 @@
 #include<QtWidgets>
 #include<QtNetwork>
 
+#include "sacnserver/sacninput.h"
+#include "sacnserver/sacnoutput.h"
+
 class SacnServer : public QWidget {
     Q_OBJECT
 public:
     SacnServer(QWidget* parent = nullptr);
-public slots:
-    void sendUniverses(QHash<int, QByteArray> universeData);
+    SacnOutput* getOutput() const;
+    SacnInput* getInput() const;
+signals:
+    void statisticsChanged(QString key, QString value);
 private slots:
-    void loadSocket(int socketIndex);
+    void loadOutputs();
+    void loadUnicastDestinations();
+    void loadInput();
 private:
-    void sendUniverseList();
     void reloadNetworkInterfaces();
-    void updateFlagsAndLength(QByteArray* data, int index);
+    void loadNetworkInterfaces(QComboBox* networkInterfaceComboBox, QString interfaceName, QString address);
+    void addOutput(QString interfaceName, QString address, int priority, QString universes);
+    static QSet<int> parseUniverses(QString text);
     QSettings* settings;
-    QUdpSocket* socket = nullptr;
-    QComboBox* networkInterfaceComboBox;
+    SacnOutput* output;
+    SacnInput* input;
+    QTableWidget* outputsTableWidget;
+    QTableWidget* unicastTableWidget;
+    QComboBox* inputNetworkInterfaceComboBox = nullptr;
+    QLineEdit* inputUniversesLineEdit;
+    QSpinBox* localPrioritySpinBox;
     QList<QNetworkInterface> networkInterfaces = QList<QNetworkInterface>();
     QList<QNetworkAddressEntry> networkAddresses = QList<QNetworkAddressEntry>();
-    uint8_t sequence = 0;
-    QList<int> universes;
-    const QByteArray cid = QUuid::createUuid().toRfc4122();
 };
 
 #endif // SACNSERVER_H
@@ -0,0 +1,60 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHAREDMEMORYLAYOUT_H
+#define SHAREDMEMORYLAYOUT_H
+
+// Memory layout of the shared memory output, documented in docs/shared_memory.md
+// This header has no Qt dependency so that other programs can include it.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+constexpr char SHAREDMEMORY_MAGIC[8] = {'Z', 'F', 'X', 'D', 'M', 'X', '\0', '\0'};
+constexpr uint32_t SHAREDMEMORY_VERSION = 1;
+constexpr uint32_t SHAREDMEMORY_SLOTS = 4;
+constexpr uint32_t SHAREDMEMORY_UNIVERSES = 512;
+constexpr uint32_t SHAREDMEMORY_UNIVERSESIZE = 512;
+
+struct alignas(64) SharedMemoryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint32_t maxUniverses;
+    uint32_t reserved;
+    std::atomic<uint64_t> frameCount; // the latest frame is in slot (frameCount - 1) % slotCount
+};
+
+struct SharedMemoryUniverse {
+    uint16_t universe;
+    uint16_t size;
+};
+
+struct alignas(64) SharedMemorySlot {
+    std::atomic<uint64_t> sequence; // odd while the slot is written
+    uint64_t frameNumber;
+    int64_t timestamp; // milliseconds since 1970-01-01 UTC
+    uint32_t universeCount;
+    uint32_t reserved;
+    SharedMemoryUniverse universes[SHAREDMEMORY_UNIVERSES];
+    uint8_t data[SHAREDMEMORY_UNIVERSES][SHAREDMEMORY_UNIVERSESIZE];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory requires lock-free 64 bit atomics");
+static_assert(sizeof(SharedMemoryHeader) == 64, "Unexpected shared memory header size");
+static_assert(offsetof(SharedMemoryHeader, frameCount) == 32, "Unexpected shared memory header layout");
+static_assert(offsetof(SharedMemorySlot, universes) == 32, "Unexpected shared memory slot layout");
+static_assert(offsetof(SharedMemorySlot, data) == 2080, "Unexpected shared memory slot layout");
+static_assert(sizeof(SharedMemorySlot) == 264256, "Unexpected shared memory slot size");
+
+constexpr size_t SHAREDMEMORY_SIZE = sizeof(SharedMemoryHeader) + (SHAREDMEMORY_SLOTS * sizeof(SharedMemorySlot));
+
+#endif // SHAREDMEMORYLAYOUT_H
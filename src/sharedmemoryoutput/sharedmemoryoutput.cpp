@@ -0,0 +1,209 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "sharedmemoryoutput.h"
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SharedMemoryOutput::SharedMemoryOutput(QObject* parent) : FrameOutput(parent) {
+    statisticsTimer.start();
+}
+
+SharedMemoryOutput::~SharedMemoryOutput() {
+    close();
+}
+
+void SharedMemoryOutput::setName(const QString sharedMemoryName) {
+    QMutexLocker locker(&configurationMutex);
+    configuredName = sharedMemoryName;
+    configurationChanged.store(true, std::memory_order_release);
+}
+
+int SharedMemoryOutput::getMaximumRate() const {
+    return 1000;
+}
+
+bool SharedMemoryOutput::usesUniverseRates() const {
+    return false;
+}
+
+void SharedMemoryOutput::sendFrame(const DmxFrame& frame) {
+    if (configurationChanged.load(std::memory_order_acquire)) {
+        QMutexLocker locker(&configurationMutex);
+        configurationChanged.store(false, std::memory_order_release);
+        close();
+        name = configuredName.toUtf8();
+        if (!name.isEmpty()) {
+            open();
+        }
+    }
+    if (header == nullptr) {
+        return;
+    }
+    QElapsedTimer writeTimer;
+    writeTimer.start();
+    const uint64_t frameCount = header->frameCount.load(std::memory_order_relaxed);
+    SharedMemorySlot* slot = &frameSlots[frameCount % SHAREDMEMORY_SLOTS];
+    const uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->frameNumber = frame.number;
+    slot->timestamp = frame.timestamp;
+    const int universeCount = std::min(frame.universeCount, (int)SHAREDMEMORY_UNIVERSES);
+    if (universeCount < frame.universeCount) {
+        statisticsTruncatedFrames++;
+    }
+    slot->universeCount = universeCount;
+    for (int index = 0; index < universeCount; index++) {
+        const QByteArray& data = frame.data.at(index);
+        slot->universes[index].universe = (uint16_t)frame.universes.at(index);
+        slot->universes[index].size = (uint16_t)data.size();
+        memcpy(slot->data[index], data.constData(), data.size());
+    }
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    header->frameCount.store(frameCount + 1, std::memory_order_release);
+
+    statisticsFrames++;
+    statisticsMaxWriteTime = std::max(writeTimer.nsecsElapsed(), statisticsMaxWriteTime);
+    const qint64 elapsedTime = statisticsTimer.nsecsElapsed();
+    if (elapsedTime >= 1000000000) {
+        const float seconds = elapsedTime / 1000000000.0;
+        emit statisticsChanged("Shared Memory Frames", QString::number(statisticsFrames / seconds, 'f', 1) + " / s");
+        emit statisticsChanged("Shared Memory Write Time", QString::number(statisticsMaxWriteTime / 1000000.0, 'f', 3) + " ms (max)");
+        emit statisticsChanged("Shared Memory Truncated Frames", QString::number(statisticsTruncatedFrames) + " / s");
+        statisticsFrames = 0;
+        statisticsTruncatedFrames = 0;
+        statisticsMaxWriteTime = 0;
+        statisticsTimer.restart();
+    }
+}
+
+bool SharedMemoryOutput::open() {
+#ifdef Q_OS_UNIX
+    // Only a segment this process created is initialized, an existing one may hold the data of another instance
+    created = true;
+    descriptor = shm_open(name.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if ((descriptor < 0) && (errno == EEXIST)) {
+        created = false;
+        descriptor = shm_open(name.constData(), O_RDWR, 0644);
+    }
+    if (descriptor < 0) {
+        qWarning() << Q_FUNC_INFO << "Can't open shared memory" << name << strerror(errno);
+        return false;
+    }
+    // The writer holds the lock as long as the segment is open, so two instances never write the same segment
+    if (flock(descriptor, LOCK_EX | LOCK_NB) < 0) {
+        if (errno == EWOULDBLOCK) {
+            qWarning() << Q_FUNC_INFO << "Shared memory" << name << "is already used by another instance";
+        } else {
+            qWarning() << Q_FUNC_INFO << "Can't lock shared memory" << name << strerror(errno);
+        }
+        closeDescriptor();
+        return false;
+    }
+    if (created) {
+        if (ftruncate(descriptor, SHAREDMEMORY_SIZE) < 0) {
+            qWarning() << Q_FUNC_INFO << "Can't resize shared memory" << name << strerror(errno);
+            closeDescriptor();
+            return false;
+        }
+    } else {
+        struct stat status;
+        if (fstat(descriptor, &status) < 0) {
+            qWarning() << Q_FUNC_INFO << "Can't read the size of shared memory" << name << strerror(errno);
+            closeDescriptor();
+            return false;
+        }
+        if (static_cast<size_t>(status.st_size) < SHAREDMEMORY_SIZE) {
+            qWarning() << Q_FUNC_INFO << "Existing shared memory" << name << "is too small";
+            closeDescriptor();
+            return false;
+        }
+    }
+    void* memory = mmap(nullptr, SHAREDMEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (memory == MAP_FAILED) {
+        qWarning() << Q_FUNC_INFO << "Can't map shared memory" << name << strerror(errno);
+        closeDescriptor();
+        return false;
+    }
+    SharedMemoryHeader* existingHeader = static_cast<SharedMemoryHeader*>(memory);
+    SharedMemorySlot* existingSlots = reinterpret_cast<SharedMemorySlot*>(static_cast<char*>(memory) + sizeof(SharedMemoryHeader));
+    if (created) {
+        memset(memory, 0, SHAREDMEMORY_SIZE);
+    } else {
+        if (memcmp(existingHeader->magic, SHAREDMEMORY_MAGIC, sizeof(SHAREDMEMORY_MAGIC)) != 0) {
+            qWarning() << Q_FUNC_INFO << "Existing shared memory" << name << "wasn't created by Zöglfrex";
+            munmap(memory, SHAREDMEMORY_SIZE);
+            closeDescriptor();
+            return false;
+        }
+        if ((existingHeader->version != SHAREDMEMORY_VERSION) || (existingHeader->headerSize != sizeof(SharedMemoryHeader)) || (existingHeader->slotCount != SHAREDMEMORY_SLOTS) || (existingHeader->slotSize != sizeof(SharedMemorySlot)) || (existingHeader->maxUniverses != SHAREDMEMORY_UNIVERSES)) {
+            qWarning() << Q_FUNC_INFO << "Existing shared memory" << name << "has another layout";
+            munmap(memory, SHAREDMEMORY_SIZE);
+            closeDescriptor();
+            return false;
+        }
+        // A writer that stopped while writing left an odd sequence, which would invert the parity of its slot
+        for (uint32_t slotIndex = 0; slotIndex < SHAREDMEMORY_SLOTS; slotIndex++) {
+            const uint64_t sequence = existingSlots[slotIndex].sequence.load(std::memory_order_relaxed);
+            if ((sequence % 2) != 0) {
+                existingSlots[slotIndex].sequence.store(sequence + 1, std::memory_order_release);
+            }
+        }
+    }
+    header = existingHeader;
+    frameSlots = existingSlots;
+    header->version = SHAREDMEMORY_VERSION;
+    header->headerSize = sizeof(SharedMemoryHeader);
+    header->slotCount = SHAREDMEMORY_SLOTS;
+    header->slotSize = sizeof(SharedMemorySlot);
+    header->maxUniverses = SHAREDMEMORY_UNIVERSES;
+    std::atomic_thread_fence(std::memory_order_release);
+    // The magic is written last, readers must not use the segment before it is set
+    memcpy(header->magic, SHAREDMEMORY_MAGIC, sizeof(SHAREDMEMORY_MAGIC));
+    return true;
+#else
+    qWarning() << Q_FUNC_INFO << "Shared memory output is only supported on Unix systems";
+    return false;
+#endif
+}
+
+void SharedMemoryOutput::closeDescriptor() {
+#ifdef Q_OS_UNIX
+    if (descriptor < 0) {
+        return;
+    }
+    if (created) {
+        shm_unlink(name.constData());
+    }
+    // Closing the descriptor releases the lock
+    ::close(descriptor);
+    descriptor = -1;
+#endif
+}
+
+void SharedMemoryOutput::close() {
+#ifdef Q_OS_UNIX
+    if (header == nullptr) {
+        return;
+    }
+    munmap(header, SHAREDMEMORY_SIZE);
+    // A segment of another instance stays for its readers
+    closeDescriptor();
+#endif
+    header = nullptr;
+    frameSlots = nullptr;
+}
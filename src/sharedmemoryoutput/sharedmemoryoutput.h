@@ -0,0 +1,44 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHAREDMEMORYOUTPUT_H
+#define SHAREDMEMORYOUTPUT_H
+
+#include <QtCore>
+
+#include "outputthread/frameoutput.h"
+#include "sharedmemoryoutput/sharedmemorylayout.h"
+
+class SharedMemoryOutput : public FrameOutput {
+    Q_OBJECT
+public:
+    SharedMemoryOutput(QObject* parent = nullptr);
+    ~SharedMemoryOutput();
+    void setName(QString name);
+    void sendFrame(const DmxFrame& frame) override;
+    int getMaximumRate() const override;
+    bool usesUniverseRates() const override;
+    void close() override;
+private:
+    bool open();
+    void closeDescriptor();
+    QMutex configurationMutex;
+    QString configuredName;
+    std::atomic<bool> configurationChanged = false;
+    QByteArray name;
+    SharedMemoryHeader* header = nullptr;
+    SharedMemorySlot* frameSlots = nullptr;
+    int descriptor = -1;
+    bool created = false;
+    QElapsedTimer statisticsTimer;
+    int statisticsFrames = 0;
+    int statisticsTruncatedFrames = 0;
+    qint64 statisticsMaxWriteTime = 0;
+};
+
+#endif // SHAREDMEMORYOUTPUT_H
@@ -0,0 +1,38 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "statisticswindow.h"
+
+StatisticsWindow::StatisticsWindow(QWidget* parent) : QWidget(parent, Qt::Window) {
+    setWindowTitle("Zöglfrex Engine Statistics");
+    resize(400, 300);
+
+    tableWidget = new QTableWidget(0, 2);
+    tableWidget->setHorizontalHeaderLabels({"Statistic", "Value"});
+    tableWidget->setSelectionMode(QAbstractItemView::NoSelection);
+    tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableWidget->setFocusPolicy(Qt::NoFocus);
+    tableWidget->verticalHeader()->hide();
+    tableWidget->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    tableWidget->horizontalHeader()->setStretchLastSection(true);
+
+    QVBoxLayout* layout = new QVBoxLayout();
+    layout->addWidget(tableWidget);
+    setLayout(layout);
+}
+
+void StatisticsWindow::setValue(const QString key, const QString value) {
+    if (!rows.contains(key)) {
+        const int row = tableWidget->rowCount();
+        tableWidget->insertRow(row);
+        tableWidget->setItem(row, 0, new QTableWidgetItem(key));
+        tableWidget->setItem(row, 1, new QTableWidgetItem());
+        rows[key] = row;
+    }
+    tableWidget->item(rows.value(key), 1)->setText(value);
+}
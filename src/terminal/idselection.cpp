@@ -0,0 +1,53 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "idselection.h"
+
+void IdSelection::add(const QString& id, const QString& sortId) {
+    ids.insert(sortId.isNull() ? getSortId(id) : sortId, id);
+}
+
+void IdSelection::remove(const QString& id) {
+    ids.remove(getSortId(id));
+}
+
+void IdSelection::removeRange(const QString& fromSortId, const QString& toSortId) {
+    auto id = ids.lowerBound(fromSortId);
+    while ((id != ids.end()) && (id.key() <= toSortId)) {
+        id = ids.erase(id);
+    }
+}
+
+void IdSelection::clear() {
+    ids.clear();
+}
+
+bool IdSelection::isEmpty() const {
+    return ids.isEmpty();
+}
+
+int IdSelection::size() const {
+    return ids.size();
+}
+
+QStringList IdSelection::getIds() const {
+    return ids.values();
+}
+
+QString IdSelection::getSortId(const QString& id) {
+    // Every ID part is padded to the same width, so the text order of sort IDs is the numeric order of the IDs
+    QString sortId;
+    sortId.reserve(id.size() * 11);
+    for (const QStringView part : QStringView(id).split(u'.')) {
+        if (!sortId.isEmpty()) {
+            sortId.append(u'.');
+        }
+        sortId.append(QString::number(part.toInt()).rightJustified(10, u'0'));
+    }
+    return sortId;
+}
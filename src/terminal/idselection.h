@@ -0,0 +1,29 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IDSELECTION_H
+#define IDSELECTION_H
+
+#include <QtCore>
+
+// An ordered set of item IDs, sorted by their sort IDs, for adding and removing the parts of a terminal selection
+class IdSelection {
+public:
+    void add(const QString& id, const QString& sortId = QString());
+    void remove(const QString& id);
+    void removeRange(const QString& fromSortId, const QString& toSortId);
+    void clear();
+    bool isEmpty() const;
+    int size() const;
+    QStringList getIds() const;
+    static QString getSortId(const QString& id);
+private:
+    QMap<QString, QString> ids;
+};
+
+#endif // IDSELECTION_H
@@ -38,6 +38,27 @@ Terminal::Terminal(QWidget *parent) : QWidget(parent) {
     keyStrings[Thru] = " Thru ";
     keyStrings[Period] = ".";
 
+    // Scripts accept the key names and the keyboard shortcuts
+    for (auto keyString = keyStrings.cbegin(); keyString != keyStrings.cend(); keyString++) {
+        const QString word = keyString.value().trimmed().toLower();
+        if (!word.isEmpty() && word.at(0).isLetter()) {
+            scriptKeys[word] = keyString.key();
+        }
+    }
+    scriptKeys["t"] = Thru;
+    scriptKeys["a"] = Attribute;
+    scriptKeys["s"] = Set;
+    scriptKeys["m"] = Model;
+    scriptKeys["f"] = Fixture;
+    scriptKeys["g"] = Group;
+    scriptKeys["i"] = Intensity;
+    scriptKeys["c"] = Color;
+    scriptKeys["p"] = Position;
+    scriptKeys["r"] = Raw;
+    scriptKeys["e"] = Effect;
+    scriptKeys["l"] = Cuelist;
+    scriptKeys["q"] = Cue;
+
     QVBoxLayout *layout = new QVBoxLayout();
     setLayout(layout);
     QHBoxLayout* promptLayout = new QHBoxLayout();
@@ -51,14 +72,14 @@ Terminal::Terminal(QWidget *parent) : QWidget(parent) {
     blindButton = new QPushButton("Blind");
     blindButton->setCheckable(true);
     connect(blindButton, &QPushButton::clicked, this, [this] {
-        QSqlQuery query;
+        PreparedQuery query;
         if (blindButton->isChecked()) {
             query.prepare("UPDATE currentitems SET cue_key = (SELECT cuelists.currentcue_key FROM cuelists, currentitems WHERE cuelists.key = currentitems.cuelist_key)");
         } else {
             query.prepare("UPDATE currentitems SET cue_key = NULL");
         }
-        if (!query.exec()) {
-            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
         }
         emit dbChanged();
     });
@@ -123,36 +144,276 @@ void Terminal::execute() {
     info("> " + keysToString(keys));
     clearPrompt();
 
-    const Key selectionType = keys.first();
+    commandFailed = false;
+    Command command;
+    if (!parseCommand(keys, &command)) {
+        return;
+    }
+    // Popups run their own event loop, in which the engine may write to the database, so they are answered before the transaction begins
+    if (!askForInput(command)) {
+        return;
+    }
+
+    // Every command is one transaction, so it is either applied completely or not at all
+    QSqlDatabase database = QSqlDatabase::database();
+    const bool transaction = database.transaction();
+    if (!transaction) {
+        qWarning() << Q_FUNC_INFO << "Failed to begin a transaction:" << database.lastError().text();
+    }
+    const int changes = getTotalChanges();
+    executeCommand(command);
+    if (transaction) {
+        if (commandFailed) {
+            const bool changed = (getTotalChanges() != changes);
+            // A rollback doesn't leave any changes to collect, so the item index has to read everything again
+            ItemIndex::invalidateAll();
+            if (!database.rollback()) {
+                qWarning() << Q_FUNC_INFO << "Failed to roll back the transaction:" << database.lastError().text();
+            } else if (changed) {
+                warning("Reverted all changes of this command.");
+            }
+        } else if (!database.commit()) {
+            qWarning() << Q_FUNC_INFO << "Failed to commit the transaction:" << database.lastError().text();
+            database.rollback();
+            ItemIndex::invalidateAll();
+            error("Failed to save the changes of this command.");
+        }
+    }
+    emit dbChanged();
+}
+
+int Terminal::getTotalChanges() const {
+    PreparedQuery query("SELECT total_changes()");
+    if (!query->exec() || !query->next()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+        return -1;
+    }
+    return query->value(0).toInt();
+}
+
+bool Terminal::executeScript(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error("Failed to open the script " + fileName + ".");
+        return false;
+    }
+    info("Executing the script " + fileName + ".");
+    QElapsedTimer timer;
+    timer.start();
+
+    // The whole script is one transaction and the views are only reloaded at the end
+    QSqlDatabase database = QSqlDatabase::database();
+    if (!database.transaction()) {
+        qWarning() << Q_FUNC_INFO << "Failed to begin a transaction:" << database.lastError().text();
+        error("Failed to execute the script " + fileName + ".");
+        return false;
+    }
+    int commands = 0;
+    int failedCommands = 0;
+    int lineNumber = 0;
+    QTextStream stream(&file);
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine().trimmed();
+        lineNumber++;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        commands++;
+        QList<Key> keys;
+        QString text;
+        if (!stringToKeys(line, &keys, &text) || keys.isEmpty()) {
+            error("Can't read the command \"" + line + "\" in line " + QString::number(lineNumber) + ".");
+            failedCommands++;
+            continue;
+        }
+        info("> " + keysToString(keys) + " (Line " + QString::number(lineNumber) + ")");
+        commandFailed = false;
+        Command command;
+        if (!parseCommand(keys, &command)) {
+            failedCommands++;
+            continue;
+        }
+        // Scripts give the text in quotes after the command and don't ask before deleting
+        commandText = text;
+        // Every command has its own savepoint, so a failing command only reverts its own changes
+        PreparedQuery savepointQuery("SAVEPOINT script_command");
+        if (!savepointQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << savepointQuery->executedQuery() << savepointQuery->lastError().text();
+            error("Failed to execute the command in line " + QString::number(lineNumber) + ".");
+            failedCommands++;
+            continue;
+        }
+        executeCommand(command);
+        if (commandFailed) {
+            failedCommands++;
+            PreparedQuery rollbackQuery("ROLLBACK TO script_command");
+            if (!rollbackQuery->exec()) {
+                qWarning() << Q_FUNC_INFO << rollbackQuery->executedQuery() << rollbackQuery->lastError().text();
+            }
+            // Reverting a savepoint doesn't leave any changes to collect
+            ItemIndex::invalidateAll();
+        }
+        PreparedQuery releaseQuery("RELEASE script_command");
+        if (!releaseQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << releaseQuery->executedQuery() << releaseQuery->lastError().text();
+        }
+    }
+    commandText = QString();
+    if (!database.commit()) {
+        qWarning() << Q_FUNC_INFO << "Failed to commit the transaction:" << database.lastError().text();
+        database.rollback();
+        ItemIndex::invalidateAll();
+        error("Failed to save the changes of the script " + fileName + ".");
+        emit dbChanged();
+        return false;
+    }
+    emit dbChanged();
+    const qint64 time = qMax<qint64>(timer.nsecsElapsed(), 1);
+    success("Executed " + QString::number(commands) + " commands of the script " + fileName + " in " + QString::number(time / 1000000.0, 'f', 3) + " ms (" + QString::number(commands * 1000000000.0 / time, 'f', 0) + " commands / s).");
+    if (failedCommands > 0) {
+        warning(QString::number(failedCommands) + " of " + QString::number(commands) + " commands failed.");
+    }
+    return (failedCommands == 0);
+}
+
+bool Terminal::parseCommand(QList<Key> keys, Command* command) {
+    command->selectionType = keys.first();
     keys.removeFirst();
 
-    QList<Key> selectionIdKeys;
-    selectionIdKeys.append(selectionType);
-    QList<Key> attributeKeys;
-    QList<Key> valueKeys;
+    command->selectionIdKeys = {command->selectionType};
+    command->attributeKeys.clear();
+    command->valueKeys.clear();
     bool attributeReached = false;
     bool valueReached = false;
     for (const Key key : keys) {
         if (key == Set) {
             if (valueReached) {
                 error("Can't use Set more than one time in one command.");
-                return;
+                return false;
             }
             valueReached = true;
         } else if ((itemKeys.contains(key) || (key == Attribute)) && !valueReached) {
-            attributeKeys.append(key);
+            command->attributeKeys.append(key);
             attributeReached = true;
         } else {
             if (valueReached) {
-                valueKeys.append(key);
+                command->valueKeys.append(key);
             } else if (attributeReached) {
-                attributeKeys.append(key);
+                command->attributeKeys.append(key);
             } else {
-                selectionIdKeys.append(key);
+                command->selectionIdKeys.append(key);
             }
         }
     }
-    if (!attributeReached && !valueReached) {
+    command->selection = (!attributeReached && !valueReached);
+    if (command->selection) {
+        return true;
+    }
+    command->ids = keysToIds(command->selectionIdKeys);
+    if (command->ids.isEmpty()) {
+        error("Invalid selection ID given.");
+        return false;
+    }
+    command->attributes.clear();
+    if (!command->attributeKeys.isEmpty()) {
+        QList<Key> attributeKeys = command->attributeKeys;
+        attributeKeys.append(Attribute);
+        QList<Key> currentItemKeys;
+        for (const Key key : attributeKeys) {
+            if (itemKeys.contains(key) || (key == Attribute)) {
+                if (!currentItemKeys.isEmpty()) {
+                    Key currentItemType = currentItemKeys.first();
+                    QStringList ids = keysToIds(currentItemKeys);
+                    if (ids.isEmpty()) {
+                        error("Invalid Attribute given: " + keysToString(currentItemKeys));
+                        return false;
+                    }
+                    command->attributes[currentItemType] = ids;
+                }
+                currentItemKeys.clear();
+            }
+            currentItemKeys.append(key);
+        }
+    }
+    if (command->attributes.value(Attribute, QStringList()).size() == 0) {
+        command->attribute = QString();
+    } else if (command->attributes.value(Attribute).size() == 1) {
+        command->attribute = command->attributes.value(Attribute).first();
+    } else {
+        error("Invalid number of Attribute IDs given.");
+        return false;
+    }
+    return true;
+}
+
+bool Terminal::askForInput(const Command& command) {
+    commandText = QString();
+    if (command.selection) {
+        return true;
+    }
+    ItemInfos item;
+    for (const ItemInfos& infos : {modelInfos, fixtureInfos, groupInfos, intensityInfos, colorInfos, positionInfos, rawInfos, effectInfos, cuelistInfos, cueInfos}) {
+        if (infos.key == command.selectionType) {
+            item = infos;
+        }
+    }
+    if (item.singular.isEmpty()) {
+        return true;
+    }
+    if (command.attributeKeys.isEmpty() && (command.valueKeys.size() == 1) && command.valueKeys.startsWith(Minus)) {
+        QMessageBox msgBox;
+        msgBox.setText("Delete " + QString::number(command.ids.length()) + " " + item.plural + "?");
+        msgBox.setInformativeText("Do you want to delete " + item.singular + " " + command.ids.join(", ") + "?");
+        msgBox.setStandardButtons(QMessageBox::Cancel | QMessageBox::Yes);
+        msgBox.setDefaultButton(QMessageBox::Yes);
+        if (msgBox.exec() != QMessageBox::Yes) {
+            error("Popup canceled.");
+            return false;
+        }
+        return true;
+    }
+    QString attribute;
+    QString attributeName;
+    if (command.attribute == AttributeIds::id) {
+        return true;
+    } else if (command.attribute == AttributeIds::label) {
+        attribute = "label";
+        attributeName = "Label";
+    } else if ((item.key == Model) && ((command.attribute == AttributeIds::modelChannels) || !command.attributes.contains(Attribute))) {
+        attribute = "channels";
+        attributeName = "Channels";
+    } else {
+        return true;
+    }
+    QString textValue = QString();
+    if (command.ids.length() == 1) {
+        PreparedQuery query("SELECT " + attribute + " FROM " + item.selectTable + " WHERE id = :id");
+        query->bindValue(":id", command.ids.first());
+        if (!query->exec()) {
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+            error("Failed to load current " + attributeName + " of " + item.singular + " " + command.ids.first() + ".");
+            return false;
+        }
+        while (query->next()) {
+            textValue = query->value(0).toString();
+        }
+    }
+    bool ok;
+    textValue = QInputDialog::getText(this, QString(), (item.singular + " " + attributeName), QLineEdit::Normal, textValue, &ok);
+    if (!ok) {
+        error("Popup canceled.");
+        return false;
+    }
+    commandText = textValue;
+    return true;
+}
+
+void Terminal::executeCommand(const Command& command) {
+    const Key selectionType = command.selectionType;
+    const QList<Key> selectionIdKeys = command.selectionIdKeys;
+    const QList<Key> attributeKeys = command.attributeKeys;
+    const QList<Key> valueKeys = command.valueKeys;
+    if (command.selection) {
         if (selectionType == Fixture) {
             setCurrentItem(fixtureInfos, "currentgroup_fixtures", selectionIdKeys, "UPDATE currentitems SET fixture_key = :key");
         } else if (selectionType == Group) {
@@ -170,55 +431,24 @@ void Terminal::execute() {
         } else if (selectionType == Cuelist) {
             setCurrentItem(cuelistInfos, cuelistInfos.selectTable, selectionIdKeys, "UPDATE currentitems SET cuelist_key = :key");
         } else if (selectionType == Cue) {
-            QSqlQuery currentCueQuery;
-            if (currentCueQuery.exec("SELECT cue_key FROM currentitems WHERE cue_key IS NOT NULL")) {
-                if (currentCueQuery.next()) {
+            PreparedQuery currentCueQuery("SELECT cue_key FROM currentitems WHERE cue_key IS NOT NULL");
+            if (currentCueQuery->exec()) {
+                if (currentCueQuery->next()) {
                     setCurrentItem(cueInfos, cueInfos.selectTable, selectionIdKeys, "UPDATE currentitems SET cue_key = :key");
                 } else {
                     setCurrentItem(cueInfos, cueInfos.selectTable, selectionIdKeys, "UPDATE cuelists SET currentcue_key = :key WHERE key = (SELECT cuelist_key FROM currentitems)");
                 }
             } else {
-                qWarning() << Q_FUNC_INFO << currentCueQuery.executedQuery() << currentCueQuery.lastError().text();
+                qWarning() << Q_FUNC_INFO << currentCueQuery->executedQuery() << currentCueQuery->lastError().text();
             }
         } else {
             error("Can't select this Item type: " + keysToString({selectionType}));
         }
         return;
     }
-    const QStringList ids = keysToIds(selectionIdKeys);
-    if (ids.isEmpty()) {
-        error("Invalid selection ID given.");
-        return;
-    }
-    QHash<Key, QStringList> attributes;
-    if (!attributeKeys.isEmpty()) {
-        attributeKeys.append(Attribute);
-        QList<Key> currentItemKeys;
-        for (const Key key : attributeKeys) {
-            if (itemKeys.contains(key) || (key == Attribute)) {
-                if (!currentItemKeys.isEmpty()) {
-                    Key currentItemType = currentItemKeys.first();
-                    QStringList ids = keysToIds(currentItemKeys);
-                    if (ids.isEmpty()) {
-                        error("Invalid Attribute given: " + keysToString(currentItemKeys));
-                        return;
-                    }
-                    attributes[currentItemType] = ids;
-                }
-                currentItemKeys.clear();
-            }
-            currentItemKeys.append(key);
-        }
-    }
-    QString attribute;
-    if (attributes.value(Attribute, QStringList()).size() == 0) {
-        attribute = QString();
-    } else if (attributes.value(Attribute).size() == 1) {
-        attribute = attributes.value(Attribute).first();
-    } else {
-        error("Invalid number of Attribute IDs given.");
-        return;
-    }
+    const QStringList ids = command.ids;
+    const QHash<Key, QStringList> attributes = command.attributes;
+    const QString attribute = command.attribute;
 
     if (selectionType == Model) {
         if (attributeKeys.isEmpty() && (valueKeys.size() == 1) && valueKeys.startsWith(Minus)) {
@@ -449,14 +679,14 @@ void Terminal::execute() {
             error("Unknown Cuelist Attribute.");
         }
     } else if (selectionType == Cue) {
-        QSqlQuery currentCuelistQuery;
-        if (currentCuelistQuery.exec("SELECT cuelists.id FROM cuelists, currentitems WHERE currentitems.cuelist_key = cuelists.key")) {
-            if (!currentCuelistQuery.next()) {
+        PreparedQuery currentCuelistQuery("SELECT cuelists.id FROM cuelists, currentitems WHERE currentitems.cuelist_key = cuelists.key");
+        if (currentCuelistQuery->exec()) {
+            if (!currentCuelistQuery->next()) {
                 error("Can't set Cue Attribute because no Cuelist is currently selected.");
                 return;
             }
         } else {
-            qWarning() << Q_FUNC_INFO << currentCuelistQuery.executedQuery() << currentCuelistQuery.lastError().text();
+            qWarning() << Q_FUNC_INFO << currentCuelistQuery->executedQuery() << currentCuelistQuery->lastError().text();
             error("Can't set Cue Attribute because the request for the current Cuelist failed.");
             return;
         }
@@ -524,54 +754,98 @@ void Terminal::execute() {
     }
 }
 
-void Terminal::updateSortingKeys(const ItemInfos item) {
-    QSqlQuery idsQuery;
-    idsQuery.prepare("SELECT key, id, sortkey FROM " + item.selectTable);
-    if (idsQuery.exec()) {
-        struct IdKey {
-            int key;
-            QString id;
-            int sortkey;
-        };
-        QList<IdKey> idKeys;
-        while (idsQuery.next()) {
-            IdKey idKey;
-            idKey.key = idsQuery.value(0).toInt();
-            idKey.id = idsQuery.value(1).toString();
-            idKey.sortkey = idsQuery.value(2).toInt();
-            idKeys.append(idKey);
-        }
-        std::sort(idKeys.begin(), idKeys.end(), [] (IdKey a, IdKey b) { return compareIds(a.id, b.id); });
-        for (int index = 1; index <= idKeys.length(); index++) {
-            const IdKey idKey = idKeys.at(index - 1);
-            if (idKey.sortkey != index) {
-                QSqlQuery query;
-                query.prepare("UPDATE " + item.updateTable + " SET sortkey = :sortkey WHERE key = :key");
-                query.bindValue(":key", idKey.key);
-                query.bindValue(":sortkey", index);
-                if (!query.exec()) {
-                    qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-                    error("Failed to update the sorting key of " + item.singular + " " + idKey.id + ".");
-                }
+void Terminal::updateSortingKeys(const ItemInfos item, const QSet<int> changedKeys) {
+    struct IdKey {
+        int key;
+        QString sortId;
+    };
+    QList<IdKey> changedIdKeys;
+    for (const int key : changedKeys) {
+        PreparedQuery sortIdQuery("SELECT sortid FROM " + item.selectTable + " WHERE key = :key");
+        sortIdQuery->bindValue(":key", key);
+        if (!sortIdQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << sortIdQuery->executedQuery() << sortIdQuery->lastError().text();
+            error("Failed to update the " + item.singular + " sorting keys.");
+            return;
+        }
+        if (sortIdQuery->next()) {
+            changedIdKeys.append({key, sortIdQuery->value(0).toString()});
+        }
+    }
+    std::sort(changedIdKeys.begin(), changedIdKeys.end(), [] (IdKey a, IdKey b) { return (a.sortId < b.sortId); });
+    // All other items are already in order, so every changed item only has to be placed into the gap between its neighbours
+    QSet<int> unplacedKeys = changedKeys;
+    bool gapsFull = false;
+    for (const IdKey& changedIdKey : changedIdKeys) {
+        unplacedKeys.remove(changedIdKey.key);
+        qint64 previousSortkey = 0;
+        PreparedQuery previousQuery("SELECT sortkey FROM " + item.selectTable + " WHERE sortid < :sortid ORDER BY sortid DESC LIMIT 1");
+        previousQuery->bindValue(":sortid", changedIdKey.sortId);
+        if (!previousQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << previousQuery->executedQuery() << previousQuery->lastError().text();
+            error("Failed to update the " + item.singular + " sorting keys.");
+            return;
+        }
+        if (previousQuery->next()) {
+            previousSortkey = previousQuery->value(0).toLongLong();
+        }
+        // The following changed items aren't placed yet, so they are skipped
+        bool nextFound = false;
+        qint64 nextSortkey = 0;
+        PreparedQuery nextQuery("SELECT key, sortkey FROM " + item.selectTable + " WHERE sortid > :sortid ORDER BY sortid LIMIT :limit");
+        nextQuery->bindValue(":sortid", changedIdKey.sortId);
+        nextQuery->bindValue(":limit", unplacedKeys.size() + 1);
+        if (!nextQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << nextQuery->executedQuery() << nextQuery->lastError().text();
+            error("Failed to update the " + item.singular + " sorting keys.");
+            return;
+        }
+        while (!nextFound && nextQuery->next()) {
+            if (!unplacedKeys.contains(nextQuery->value(0).toInt())) {
+                nextFound = true;
+                nextSortkey = nextQuery->value(1).toLongLong();
             }
         }
-    } else {
-        qWarning() << Q_FUNC_INFO << idsQuery.executedQuery() << idsQuery.lastError().text();
+        qint64 sortkey = previousSortkey + sortkeyGap;
+        if (nextFound) {
+            if ((nextSortkey - previousSortkey) <= 1) {
+                gapsFull = true;
+                break;
+            }
+            sortkey = previousSortkey + (nextSortkey - previousSortkey) / 2;
+        }
+        PreparedQuery updateQuery("UPDATE " + item.updateTable + " SET sortkey = :sortkey WHERE key = :key");
+        updateQuery->bindValue(":key", changedIdKey.key);
+        updateQuery->bindValue(":sortkey", sortkey);
+        if (!updateQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << updateQuery->executedQuery() << updateQuery->lastError().text();
+            error("Failed to update the " + item.singular + " sorting keys.");
+            return;
+        }
+    }
+    if (!gapsFull) {
+        return;
+    }
+    // Only renumber all items if there is no gap left
+    QVariantList keys;
+    QVariantList values;
+    PreparedQuery idsQuery("SELECT key FROM " + item.selectTable + " ORDER BY sortid");
+    if (!idsQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << idsQuery->executedQuery() << idsQuery->lastError().text();
         error("Failed to update the " + item.singular + " sorting keys.");
+        return;
     }
-}
-
-bool Terminal::compareIds(const QString a, const QString b) {
-    QStringList aParts = a.split(".");
-    QStringList bParts = b.split(".");
-    for (int part = 0; part < std::min(aParts.length(), bParts.length()); part++) {
-        const int aPart = aParts.at(part).toInt();
-        const int bPart = bParts.at(part).toInt();
-        if (aPart != bPart) {
-            return aPart < bPart;
-        }
+    while (idsQuery->next()) {
+        keys.append(idsQuery->value(0).toInt());
+        values.append(keys.length() * sortkeyGap);
+    }
+    PreparedQuery query("UPDATE " + item.updateTable + " SET sortkey = :sortkey WHERE key = :key");
+    query->bindValue(":key", keys);
+    query->bindValue(":sortkey", values);
+    if (!query->execBatch()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+        error("Failed to update the " + item.singular + " sorting keys.");
     }
-    return (aParts.length() < bParts.length());
 }
 
 void Terminal::setCurrentItem(const ItemInfos item, const QString itemTable, const QList<Key> idKeys, const QString updateQueryText) {
@@ -580,30 +854,27 @@ void Terminal::setCurrentItem(const ItemInfos item, const QString itemTable, con
         error("Invalid " + item.singular + " selection given.");
         return;
     }
-    QSqlQuery keyQuery;
-    keyQuery.prepare("SELECT key FROM " + itemTable + " WHERE id = :id");
-    keyQuery.bindValue(":id", ids.first());
-    if (!keyQuery.exec()) {
-        qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-        error("Can't select " + item.singular + " because the key request for " + item.singular + " " + ids.first() + " failed.");
+    bool keyLoaded = false;
+    const int key = ItemIndex::getKey(itemTable, ids.first(), &keyLoaded);
+    if (!keyLoaded) {
+        error("Failed to load " + item.singular + " " + ids.first() + ".");
         return;
     }
-    if (!keyQuery.next()) {
+    if (key < 0) {
         error("Can't select " + item.singular + " " + ids.first() + ".");
         return;
     }
-    const int key = keyQuery.value(0).toInt();
-    QSqlQuery updateQuery;
-    updateQuery.prepare(updateQueryText);
-    updateQuery.bindValue(":key", key);
-    if (!updateQuery.exec()) {
-        qWarning() << Q_FUNC_INFO << updateQuery.executedQuery() << updateQuery.lastError().text();
+    PreparedQuery updateQuery(updateQueryText);
+    updateQuery->bindValue(":key", key);
+    if (!updateQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << updateQuery->executedQuery() << updateQuery->lastError().text();
         error("Failed to select " + item.singular + ".");
     }
-    emit dbChanged();
 }
 
 void Terminal::setCueItem(const ItemInfos item, const QString valueTable, const QList<Key> idKeys, const bool multipleItemsAllowed) {
+    QElapsedTimer timer;
+    timer.start();
     QList<int> itemKeys;
     if ((idKeys.size() != 2) || !idKeys.endsWith(Minus)) {
         const QStringList ids = keysToIds(idKeys);
@@ -616,18 +887,16 @@ void Terminal::setCueItem(const ItemInfos item, const QString valueTable, const
             return;
         }
         for (QString id : ids) {
-            QSqlQuery itemKeyQuery;
-            itemKeyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-            itemKeyQuery.bindValue(":id", id);
-            if (itemKeyQuery.exec()) {
-                if (itemKeyQuery.next()) {
-                    itemKeys.append(itemKeyQuery.value(0).toInt());
-                } else {
-                    warning("Can't select " + item.singular + " " + id + " because this " + item.singular + " doesn't exist.");
-                }
+            bool itemKeyLoaded = false;
+            const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+            if (!itemKeyLoaded) {
+                error("Failed to load " + item.singular + " " + id + ".");
+                return;
+            }
+            if (itemKey >= 0) {
+                itemKeys.append(itemKey);
             } else {
-                qWarning() << Q_FUNC_INFO << itemKeyQuery.executedQuery() << itemKeyQuery.lastError().text();
-                error("Can't set Cue " + item.plural + " because the key request for " + item.singular + " " + ids.first() + " failed.");
+                warning("Can't select " + item.singular + " " + id + " because this " + item.singular + " doesn't exist.");
             }
         }
         if (itemKeys.isEmpty()) {
@@ -635,122 +904,130 @@ void Terminal::setCueItem(const ItemInfos item, const QString valueTable, const
             return;
         }
     }
-    QSqlQuery groupKeyQuery;
-    if (!groupKeyQuery.exec("SELECT group_key FROM currentitems WHERE group_key IS NOT NULL")) {
-        qWarning() << Q_FUNC_INFO << groupKeyQuery.executedQuery() << groupKeyQuery.lastError().text();
+    PreparedQuery groupKeyQuery("SELECT group_key FROM currentitems WHERE group_key IS NOT NULL");
+    if (!groupKeyQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << groupKeyQuery->executedQuery() << groupKeyQuery->lastError().text();
         error("Can't set Cue " + item.plural + " because request for the current Group failed.");
         return;
     }
-    if (!groupKeyQuery.next()) {
+    if (!groupKeyQuery->next()) {
         error("Can't set Cue " + item.plural + " because no Group is currently selected.");
         return;
     }
-    const int groupKey = groupKeyQuery.value(0).toInt();
-    QList<int> cueKeys;
-    QSqlQuery cueKeyQuery;
-    if (!cueKeyQuery.exec("SELECT key, sortkey FROM currentcue")) {
-        qWarning() << Q_FUNC_INFO << cueKeyQuery.executedQuery() << cueKeyQuery.lastError().text();
+    const int groupKey = groupKeyQuery->value(0).toInt();
+    PreparedQuery cueKeyQuery("SELECT key, sortkey FROM currentcue");
+    if (!cueKeyQuery->exec()) {
+        qWarning() << Q_FUNC_INFO << cueKeyQuery->executedQuery() << cueKeyQuery->lastError().text();
         error("Can't set Cue " + item.plural + " because the request for the current Cue failed.");
         return;
     }
-    if (!cueKeyQuery.next()) {
+    if (!cueKeyQuery->next()) {
         error("Can't set Cue " + item.plural + " because no Cue is currently selected.");
         return;
     }
-    cueKeys.append(cueKeyQuery.value(0).toInt());
+    const int currentCueKey = cueKeyQuery->value(0).toInt();
+    QList<int> cueKeys = {currentCueKey};
     if (trackingButton->isChecked()) {
-        QSqlQuery currentCueValueQuery;
-        currentCueValueQuery.prepare("SELECT valueitem_key FROM " + valueTable + " WHERE item_key = :cue AND foreignitem_key = :group");
-        currentCueValueQuery.bindValue(":cue", cueKeys.first());
-        currentCueValueQuery.bindValue(":group", groupKey);
-        if (currentCueValueQuery.exec()) {
-            QSet<int> currentCueValueKeys;
-            while (currentCueValueQuery.next()) {
-                currentCueValueKeys.insert(currentCueValueQuery.value(0).toInt());
-            }
-            QSqlQuery cueTrackingKeyQuery;
-            cueTrackingKeyQuery.prepare("SELECT key, block FROM currentcuelist_cues WHERE sortkey > :sortkey ORDER BY sortkey");
-            cueTrackingKeyQuery.bindValue(":sortkey", cueKeyQuery.value(1).toInt());
-            if (cueTrackingKeyQuery.exec()) {
-                bool sameValue = true;
-                while (cueTrackingKeyQuery.next() && (cueTrackingKeyQuery.value(1).toInt() == 0) && sameValue) {
-                    const int cueKey = cueTrackingKeyQuery.value(0).toInt();
-                    QSqlQuery cueValueQuery;
-                    cueValueQuery.prepare("SELECT valueitem_key FROM " + valueTable + " WHERE item_key = :cue AND foreignitem_key = :group");
-                    cueValueQuery.bindValue(":cue", cueKey);
-                    cueValueQuery.bindValue(":group", groupKey);
-                    if (cueValueQuery.exec()) {
-                        QSet<int> cueValueKeys;
-                        while (cueValueQuery.next()) {
-                            cueValueKeys.insert(cueValueQuery.value(0).toInt());
-                        }
-                        sameValue = (cueValueKeys == currentCueValueKeys);
-                        if (sameValue) {
-                            cueKeys.append(cueKey);
-                        }
-                    } else {
-                        qWarning() << Q_FUNC_INFO << cueKeyQuery.executedQuery() << cueKeyQuery.lastError().text();
-                        error("Can't set Cue " + item.plural + " because the Cue tracking request failed.");
-                        return;
-                    }
+        // The values of the current Group in the current Cue and all following Cues in one request
+        PreparedQuery cueValueQuery("SELECT cues.key, cues.block, cuevalues.valueitem_key FROM currentcuelist_cues AS cues LEFT JOIN " + valueTable + " AS cuevalues ON cuevalues.item_key = cues.key AND cuevalues.foreignitem_key = :group WHERE cues.sortkey >= :sortkey ORDER BY cues.sortkey");
+        cueValueQuery->bindValue(":group", groupKey);
+        cueValueQuery->bindValue(":sortkey", cueKeyQuery->value(1).toLongLong());
+        if (!cueValueQuery->exec()) {
+            qWarning() << Q_FUNC_INFO << cueValueQuery->executedQuery() << cueValueQuery->lastError().text();
+            error("Can't set Cue " + item.plural + " because the Cue tracking request failed.");
+            return;
+        }
+        QList<int> followingCueKeys;
+        QSet<int> blockedCueKeys;
+        QHash<int, QSet<int>> cueValueKeys;
+        while (cueValueQuery->next()) {
+            const int cueKey = cueValueQuery->value(0).toInt();
+            if (!cueValueKeys.contains(cueKey)) {
+                cueValueKeys[cueKey] = QSet<int>();
+                if (cueKey != currentCueKey) {
+                    followingCueKeys.append(cueKey);
+                }
+                if (cueValueQuery->value(1).toInt() != 0) {
+                    blockedCueKeys.insert(cueKey);
                 }
-            } else {
-                qWarning() << Q_FUNC_INFO << cueKeyQuery.executedQuery() << cueKeyQuery.lastError().text();
-                error("Can't set Cue " + item.plural + " because the Cue tracking request failed.");
-                return;
             }
-        } else {
-            qWarning() << Q_FUNC_INFO << cueKeyQuery.executedQuery() << cueKeyQuery.lastError().text();
-            error("Can't set Cue " + item.plural + " because the request for the " + item.singular + " in the current Cue failed.");
-            return;
+            if (!cueValueQuery->value(2).isNull()) {
+                cueValueKeys[cueKey].insert(cueValueQuery->value(2).toInt());
+            }
+        }
+        // The value is tracked until a blocked Cue or a Cue with another value
+        const QSet<int> currentCueValueKeys = cueValueKeys.value(currentCueKey);
+        for (const int cueKey : followingCueKeys) {
+            if (blockedCueKeys.contains(cueKey) || (cueValueKeys.value(cueKey) != currentCueValueKeys)) {
+                break;
+            }
+            cueKeys.append(cueKey);
         }
     }
+    QVariantList deleteCueKeys;
+    QVariantList deleteGroupKeys;
+    QVariantList insertCueKeys;
+    QVariantList insertGroupKeys;
+    QVariantList insertItemKeys;
     for (const int cueKey : cueKeys) {
-        QSqlQuery deleteQuery;
-        deleteQuery.prepare("DELETE FROM " + valueTable + " WHERE item_key = :cue AND foreignitem_key = :group");
-        deleteQuery.bindValue(":cue", cueKey);
-        deleteQuery.bindValue(":group", groupKey);
-        if (!deleteQuery.exec()) {
-            qWarning() << Q_FUNC_INFO << deleteQuery.executedQuery() << deleteQuery.lastError().text();
-            error("Failed deleting Cue " + item.plural + ".");
-        }
+        deleteCueKeys.append(cueKey);
+        deleteGroupKeys.append(groupKey);
         for (const int key : itemKeys) {
-            QSqlQuery query;
-            query.prepare("INSERT OR REPLACE INTO " + valueTable + " (item_key, foreignitem_key, valueitem_key) VALUES (:cue, :group, :item)");
-            query.bindValue(":cue", cueKey);
-            query.bindValue(":group", groupKey);
-            query.bindValue(":item", key);
-            if (!query.exec()) {
-                qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-                error("Failed inserting " + item.singular + ".");
-            }
+            insertCueKeys.append(cueKey);
+            insertGroupKeys.append(groupKey);
+            insertItemKeys.append(key);
         }
     }
-    emit dbChanged();
+    PreparedQuery deleteQuery("DELETE FROM " + valueTable + " WHERE item_key = :cue AND foreignitem_key = :group");
+    deleteQuery->bindValue(":cue", deleteCueKeys);
+    deleteQuery->bindValue(":group", deleteGroupKeys);
+    if (!deleteQuery->execBatch()) {
+        qWarning() << Q_FUNC_INFO << deleteQuery->executedQuery() << deleteQuery->lastError().text();
+        error("Failed deleting Cue " + item.plural + ".");
+        return;
+    }
+    if (!insertCueKeys.isEmpty()) {
+        PreparedQuery insertQuery("INSERT OR REPLACE INTO " + valueTable + " (item_key, foreignitem_key, valueitem_key) VALUES (:cue, :group, :item)");
+        insertQuery->bindValue(":cue", insertCueKeys);
+        insertQuery->bindValue(":group", insertGroupKeys);
+        insertQuery->bindValue(":item", insertItemKeys);
+        if (!insertQuery->execBatch()) {
+            qWarning() << Q_FUNC_INFO << insertQuery->executedQuery() << insertQuery->lastError().text();
+            error("Failed inserting " + item.plural + ".");
+            return;
+        }
+    }
+    const QString cueString = QString::number(cueKeys.size()) + " " + ((cueKeys.size() == 1) ? cueInfos.singular : cueInfos.plural);
+    const QString timeString = QString::number(timer.nsecsElapsed() / 1000000.0, 'f', 3) + " ms";
+    if (itemKeys.isEmpty()) {
+        success("Removed Cue " + item.plural + " of the current Group in " + cueString + " (" + timeString + ").");
+    } else {
+        success("Set Cue " + item.plural + " of the current Group in " + cueString + " (" + timeString + ").");
+    }
 }
 
 void Terminal::createItems(const ItemInfos item, QStringList ids) {
     Q_ASSERT(!ids.isEmpty());
     QStringList successfulIds;
+    QSet<int> createdKeys;
     for (QString id : ids) {
-        QSqlQuery existsQuery;
-        existsQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        existsQuery.bindValue(":id", id);
-        if (existsQuery.exec()) {
-            if (!existsQuery.next()) {
-                QSqlQuery insertQuery;
-                insertQuery.prepare("INSERT INTO " + item.updateTable + " (id, sortkey) VALUES (:id, 0)");
-                insertQuery.bindValue(":id", id);
-                if (insertQuery.exec()) {
-                    successfulIds.append(id);
-                } else {
-                    qWarning() << Q_FUNC_INFO << insertQuery.executedQuery() << insertQuery.lastError().text();
-                    error("Failed to insert " + item.singular + " " + id + ".");
-                }
+        bool existingKeyLoaded = false;
+        const int existingKey = ItemIndex::getKey(item.selectTable, id, &existingKeyLoaded);
+        if (!existingKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (existingKey < 0) {
+            PreparedQuery insertQuery("INSERT INTO " + item.updateTable + " (id, sortid, sortkey) VALUES (:id, :sortid, 0)");
+            insertQuery->bindValue(":id", id);
+            insertQuery->bindValue(":sortid", IdSelection::getSortId(id));
+            if (insertQuery->exec()) {
+                successfulIds.append(id);
+                createdKeys.insert(insertQuery->lastInsertId().toInt());
+            } else {
+                qWarning() << Q_FUNC_INFO << insertQuery->executedQuery() << insertQuery->lastError().text();
+                error("Failed to insert " + item.singular + " " + id + ".");
             }
-        } else {
-            qWarning() << Q_FUNC_INFO << existsQuery.executedQuery() << existsQuery.lastError().text();
-            error("Failed to check if " + item.singular + " " + id + " already exists.");
         }
     }
     if (successfulIds.size() == 1) {
@@ -758,59 +1035,45 @@ void Terminal::createItems(const ItemInfos item, QStringList ids) {
     } else if (successfulIds.size() > 1) {
         success("Created " + item.plural + " " + successfulIds.join(", ") + ".");
     }
-    updateSortingKeys(item);
+    if (!createdKeys.isEmpty()) {
+        updateSortingKeys(item, createdKeys);
+    }
     if (item.selectTable == cueInfos.selectTable) {
+        // New Cues copy the previous Cue, which might be new as well, so they're copied in Cue order
+        IdSelection cueIds;
         for (QString id : successfulIds) {
-            QSqlQuery keyQuery;
-            keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-            keyQuery.bindValue(":id", id);
-            if (keyQuery.exec()) {
-                if (keyQuery.next()) {
-                    const int key = keyQuery.value(0).toInt();
-                    QSqlQuery previousCueQuery;
-                    previousCueQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE sortkey = (SELECT MAX(sortkey) FROM " + item.selectTable + " WHERE sortkey < (SELECT sortkey FROM " + item.selectTable + " WHERE key = :key))");
-                    previousCueQuery.bindValue(":key", key);
-                    if (previousCueQuery.exec()) {
-                        if (previousCueQuery.next()) {
-                            const int previousCueKey = previousCueQuery.value(0).toInt();
-                            QStringList tables;
-                            tables.append("cue_group_intensities");
-                            tables.append("cue_group_colors");
-                            tables.append("cue_group_positions");
-                            tables.append("cue_group_raws");
-                            tables.append("cue_group_effects");
-                            for (QString table : tables) {
-                                QSqlQuery valueQuery;
-                                valueQuery.prepare("SELECT foreignitem_key, valueitem_key FROM " + table + " WHERE item_key = :key");
-                                valueQuery.bindValue(":key", previousCueKey);
-                                if (valueQuery.exec()) {
-                                    while (valueQuery.next()) {
-                                        QSqlQuery updateQuery;
-                                        updateQuery.prepare("INSERT INTO " + table + " (item_key, foreignitem_key, valueitem_key) VALUES (:key, :foreignitem, :valueitem)");
-                                        updateQuery.bindValue(":key", key);
-                                        updateQuery.bindValue(":foreignitem", valueQuery.value(0).toInt());
-                                        updateQuery.bindValue(":valueitem", valueQuery.value(1).toInt());
-                                        if (!updateQuery.exec()) {
-                                            qWarning() << Q_FUNC_INFO << updateQuery.executedQuery() << updateQuery.lastError().text();
-                                            error("Failed to copy data of the previous " + item.singular + " to " + item.singular + " " + id + ".");
-                                        }
-                                    }
-                                } else {
-                                    qWarning() << Q_FUNC_INFO << valueQuery.executedQuery() << valueQuery.lastError().text();
-                                    error("Failed to copy the data of the previous " + item.singular + " to " + item.singular + " " + id + ".");
-                                }
+            cueIds.add(id);
+        }
+        const QStringList tables = {"cue_group_intensities", "cue_group_colors", "cue_group_positions", "cue_group_raws", "cue_group_effects"};
+        for (QString id : cueIds.getIds()) {
+            bool keyLoaded = false;
+            const int key = ItemIndex::getKey(item.selectTable, id, &keyLoaded);
+            if (!keyLoaded) {
+                error("Failed to load " + item.singular + " " + id + ".");
+                return;
+            }
+            if (key >= 0) {
+                PreparedQuery previousCueQuery("SELECT key FROM " + item.selectTable + " WHERE sortkey = (SELECT MAX(sortkey) FROM " + item.selectTable + " WHERE sortkey < (SELECT sortkey FROM " + item.selectTable + " WHERE key = :key))");
+                previousCueQuery->bindValue(":key", key);
+                if (previousCueQuery->exec()) {
+                    if (previousCueQuery->next()) {
+                        const int previousCueKey = previousCueQuery->value(0).toInt();
+                        for (QString table : tables) {
+                            PreparedQuery copyQuery("INSERT INTO " + table + " (item_key, foreignitem_key, valueitem_key) SELECT :key, foreignitem_key, valueitem_key FROM " + table + " WHERE item_key = :previouscue");
+                            copyQuery->bindValue(":key", key);
+                            copyQuery->bindValue(":previouscue", previousCueKey);
+                            if (!copyQuery->exec()) {
+                                qWarning() << Q_FUNC_INFO << copyQuery->executedQuery() << copyQuery->lastError().text();
+                                error("Failed to copy the data of the previous " + item.singular + " to " + item.singular + " " + id + ".");
                             }
                         }
-                    } else {
-                        qWarning() << Q_FUNC_INFO << previousCueQuery.executedQuery() << previousCueQuery.lastError().text();
-                        error("Failed to get the " + item.singular + " before " + item.singular + " " + id + ".");
                     }
                 } else {
-                    error(item.singular + " " + id + " wasn't found.");
+                    qWarning() << Q_FUNC_INFO << previousCueQuery->executedQuery() << previousCueQuery->lastError().text();
+                    error("Failed to get the " + item.singular + " before " + item.singular + " " + id + ".");
                 }
             } else {
-                qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-                error("Failed to get " + item.singular + " " + id + ".");
+                error(item.singular + " " + id + " wasn't found.");
             }
         }
     }
@@ -818,37 +1081,25 @@ void Terminal::createItems(const ItemInfos item, QStringList ids) {
 
 void Terminal::deleteItems(const ItemInfos item, QStringList ids) {
     Q_ASSERT(!ids.isEmpty());
-    QMessageBox msgBox;
-    msgBox.setText("Delete " + QString::number(ids.length()) + " " + item.plural + "?");
-    msgBox.setInformativeText("Do you want to delete " + item.singular + " " + ids.join(", ") + "?");
-    msgBox.setStandardButtons(QMessageBox::Cancel | QMessageBox::Yes);
-    msgBox.setDefaultButton(QMessageBox::Yes);
-    if (msgBox.exec() != QMessageBox::Yes) {
-        error("Popup canceled.");
-        return;
-    }
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                QSqlQuery deleteQuery;
-                deleteQuery.prepare("DELETE FROM " + item.updateTable + " WHERE key = :key");
-                deleteQuery.bindValue(":key", keyQuery.value(0).toInt());
-                if (deleteQuery.exec()) {
-                    successfulIds.append(id);
-                } else {
-                    qWarning() << Q_FUNC_INFO << deleteQuery.executedQuery() << deleteQuery.lastError().text();
-                    error("Can't delete " + item.singular + " because the request failed.");
-                }
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            PreparedQuery deleteQuery("DELETE FROM " + item.updateTable + " WHERE key = :key");
+            deleteQuery->bindValue(":key", itemKey);
+            if (deleteQuery->exec()) {
+                successfulIds.append(id);
             } else {
-                warning("Can't delete " + item.singular + " " + id + " because this " + item.singular + " doesn't exist.");
+                qWarning() << Q_FUNC_INFO << deleteQuery->executedQuery() << deleteQuery->lastError().text();
+                error("Can't delete " + item.singular + " because the request failed.");
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Couldn't delete " + item.singular + " " + id + ": ");
+            warning("Can't delete " + item.singular + " " + id + " because this " + item.singular + " doesn't exist.");
         }
     }
     if (successfulIds.size() == 1) {
@@ -856,8 +1107,6 @@ void Terminal::deleteItems(const ItemInfos item, QStringList ids) {
     } else if (successfulIds.size() > 1) {
         success("Deleted " + item.plural + " " + successfulIds.join(", ") + ".");
     }
-    updateSortingKeys(item);
-    emit dbChanged();
 }
 
 void Terminal::moveItems(const ItemInfos item, QStringList ids, QList<Key> valueKeys) {
@@ -870,40 +1119,38 @@ void Terminal::moveItems(const ItemInfos item, QStringList ids, QList<Key> value
     }
     createItems(item, ids);
     QStringList successfulIds;
+    QSet<int> movedKeys;
     for (QString id : ids) {
-        QSqlQuery existsQuery;
-        existsQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        existsQuery.bindValue(":id", newIds.first());
-        if (existsQuery.exec()) {
-            if (existsQuery.next()) {
-                warning("Can't set ID of " + item.singular + " to " + newIds.first() + " because this " + item.singular + " ID is already used.");
-            } else {
-                QSqlQuery keyQuery;
-                keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-                keyQuery.bindValue(":id", id);
-                if (keyQuery.exec()) {
-                    if (keyQuery.next()) {
-                        QSqlQuery updateQuery;
-                        updateQuery.prepare("UPDATE " + item.updateTable + " SET id = :newId WHERE key = :key");
-                        updateQuery.bindValue(":key", keyQuery.value(0).toInt());
-                        updateQuery.bindValue(":newId", newIds.first());
-                        if (updateQuery.exec()) {
-                            successfulIds.append(id);
-                        } else {
-                            qWarning() << Q_FUNC_INFO << updateQuery.executedQuery() << updateQuery.lastError().text();
-                            error("Failed to update ID of " + item.singular + " " + id + " because the request failed.");
-                        }
-                    } else {
-                        warning("Can't set ID of " + item.singular + " " + id + " because this " + item.singular + " doesn't exist.");
-                    }
+        bool existingKeyLoaded = false;
+        const int existingKey = ItemIndex::getKey(item.selectTable, newIds.first(), &existingKeyLoaded);
+        if (!existingKeyLoaded) {
+            error("Failed to load " + item.singular + " " + newIds.first() + ".");
+            return;
+        }
+        if (existingKey >= 0) {
+            warning("Can't set ID of " + item.singular + " to " + newIds.first() + " because this " + item.singular + " ID is already used.");
+        } else {
+            bool itemKeyLoaded = false;
+            const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+            if (!itemKeyLoaded) {
+                error("Failed to load " + item.singular + " " + id + ".");
+                return;
+            }
+            if (itemKey >= 0) {
+                PreparedQuery updateQuery("UPDATE " + item.updateTable + " SET id = :newId, sortid = :sortid WHERE key = :key");
+                updateQuery->bindValue(":key", itemKey);
+                updateQuery->bindValue(":newId", newIds.first());
+                updateQuery->bindValue(":sortid", IdSelection::getSortId(newIds.first()));
+                if (updateQuery->exec()) {
+                    successfulIds.append(id);
+                    movedKeys.insert(itemKey);
                 } else {
-                    qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-                    error("Failed loading " + item.singular + " " + id + ".");
+                    qWarning() << Q_FUNC_INFO << updateQuery->executedQuery() << updateQuery->lastError().text();
+                    error("Failed to update ID of " + item.singular + " " + id + " because the request failed.");
                 }
+            } else {
+                warning("Can't set ID of " + item.singular + " " + id + " because this " + item.singular + " doesn't exist.");
             }
-        } else {
-            qWarning() << Q_FUNC_INFO << existsQuery.executedQuery() << existsQuery.lastError().text();
-            error("Error executing check if " + item.singular + " " + newIds.first() + " exists.");
         }
     }
     if (successfulIds.size() == 1) {
@@ -911,8 +1158,9 @@ void Terminal::moveItems(const ItemInfos item, QStringList ids, QList<Key> value
     } else if (successfulIds.size() > 1) {
         success("Set ID of " + item.plural + " " + successfulIds.join(", ") + " to " + newIds.first() + ".");
     }
-    updateSortingKeys(item);
-    emit dbChanged();
+    if (!movedKeys.isEmpty()) {
+        updateSortingKeys(item, movedKeys);
+    }
 }
 
 void Terminal::setBoolAttribute(const ItemInfos item, const QString attribute, const QString attributeName, QStringList ids, QList<Key> valueKeys) {
@@ -930,27 +1178,24 @@ void Terminal::setBoolAttribute(const ItemInfos item, const QString attribute, c
     createItems(item, ids);
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                QSqlQuery updateQuery;
-                updateQuery.prepare("UPDATE " + item.updateTable + " SET " + attribute + " = :value WHERE key = :key");
-                updateQuery.bindValue(":key", keyQuery.value(0).toInt());
-                updateQuery.bindValue(":value", value);
-                if (updateQuery.exec()) {
-                    successfulIds.append(id);
-                } else {
-                    qWarning() << Q_FUNC_INFO << updateQuery.executedQuery() << updateQuery.lastError().text();
-                    error("Failed setting " + attributeName + " of " + item.singular + " " + id + ".");
-                }
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            PreparedQuery updateQuery("UPDATE " + item.updateTable + " SET " + attribute + " = :value WHERE key = :key");
+            updateQuery->bindValue(":key", itemKey);
+            updateQuery->bindValue(":value", value);
+            if (updateQuery->exec()) {
+                successfulIds.append(id);
             } else {
-                warning("Failed to set " + attributeName + " of " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+                qWarning() << Q_FUNC_INFO << updateQuery->executedQuery() << updateQuery->lastError().text();
+                error("Failed setting " + attributeName + " of " + item.singular + " " + id + ".");
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            warning("Failed to set " + attributeName + " of " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     if (successfulIds.length() == 1) {
@@ -958,31 +1203,16 @@ void Terminal::setBoolAttribute(const ItemInfos item, const QString attribute, c
     } else if (successfulIds.length() > 1) {
         success("Set " + attributeName + " of " + item.plural + " " + successfulIds.join(", ") + " to " + valueText + ".");
     }
-    emit dbChanged();
 }
 
 void Terminal::setTextAttribute(const ItemInfos item, const QString attribute, const QString attributeName, QStringList ids, const QString regex) {
     Q_ASSERT(!ids.isEmpty());
-    QString textValue = QString();
-    if (ids.length() == 1) {
-        QSqlQuery query;
-        query.prepare("SELECT " + attribute + " FROM " + item.selectTable + " WHERE id = :id");
-        query.bindValue(":id", ids.first());
-        if (!query.exec()) {
-            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-            error("Failed to load current " + attributeName + " of " + item.singular + " " + ids.first() + ".");
-            return;
-        }
-        while (query.next()) {
-            textValue = query.value(0).toString();
-        }
-    }
-    bool ok;
-    textValue = QInputDialog::getText(this, QString(), (item.singular+ " " + attributeName), QLineEdit::Normal, textValue, &ok);
-    if (!ok) {
-        error("Popup canceled.");
+    // The text was given in the script or in the popup before the transaction began
+    if (commandText.isNull()) {
+        error("Can't set " + item.singular + " " + attributeName + " because no text was given.");
         return;
     }
+    const QString textValue = commandText;
     if (!regex.isEmpty() && !textValue.contains(QRegularExpression(regex))) {
         error("Can't set " + item.singular + " " + attributeName + " because the given value \"" + textValue + "\" is not valid.");
         return;
@@ -990,27 +1220,24 @@ void Terminal::setTextAttribute(const ItemInfos item, const QString attribute, c
     createItems(item, ids);
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                QSqlQuery updateQuery;
-                updateQuery.prepare("UPDATE " + item.updateTable + " SET " + attribute + " = :value WHERE key = :key");
-                updateQuery.bindValue(":key", keyQuery.value(0).toInt());
-                updateQuery.bindValue(":value", textValue);
-                if (updateQuery.exec()) {
-                    successfulIds.append(id);
-                } else {
-                    qWarning() << Q_FUNC_INFO << updateQuery.executedQuery() << updateQuery.lastError().text();
-                    error("Failed setting " + attributeName + " of " + item.singular + " " + id + ".");
-                }
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            PreparedQuery updateQuery("UPDATE " + item.updateTable + " SET " + attribute + " = :value WHERE key = :key");
+            updateQuery->bindValue(":key", itemKey);
+            updateQuery->bindValue(":value", textValue);
+            if (updateQuery->exec()) {
+                successfulIds.append(id);
             } else {
-                warning("Failed to set " + attributeName + " of " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+                qWarning() << Q_FUNC_INFO << updateQuery->executedQuery() << updateQuery->lastError().text();
+                error("Failed setting " + attributeName + " of " + item.singular + " " + id + ".");
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            warning("Failed to set " + attributeName + " of " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     if (successfulIds.length() == 1) {
@@ -1018,7 +1245,6 @@ void Terminal::setTextAttribute(const ItemInfos item, const QString attribute, c
     } else if (successfulIds.length() > 1) {
         success("Set " + attributeName + " of " + item.plural + " " + successfulIds.join(", ") + " to \"" + textValue + "\".");
     }
-    emit dbChanged();
 }
 
 template <typename T> void Terminal::setNumberAttribute(const ItemInfos item, const QString attribute, const QString attributeName, QStringList ids, QList<Key> valueKeys, const NumberInfos number) {
@@ -1038,12 +1264,11 @@ template <typename T> void Terminal::setNumberAttribute(const ItemInfos item, co
     for (QString id : ids) {
         bool valueOk = true;
         if (difference) {
-            QSqlQuery currentValueQuery;
-            currentValueQuery.prepare("SELECT " + attribute + " FROM " + item.selectTable + " WHERE id = :id");
-            currentValueQuery.bindValue(":id", id);
-            if (currentValueQuery.exec()) {
-                if (currentValueQuery.next()) {
-                    value = keysToFloat(valueKeys, &valueOk, currentValueQuery.value(0).toFloat(), number);
+            PreparedQuery currentValueQuery("SELECT " + attribute + " FROM " + item.selectTable + " WHERE id = :id");
+            currentValueQuery->bindValue(":id", id);
+            if (currentValueQuery->exec()) {
+                if (currentValueQuery->next()) {
+                    value = keysToFloat(valueKeys, &valueOk, currentValueQuery->value(0).toFloat(), number);
                     if (!valueOk) {
                         error("Invalid value given for " + item.singular + " " + id + ".");
                     }
@@ -1052,33 +1277,30 @@ template <typename T> void Terminal::setNumberAttribute(const ItemInfos item, co
                     valueOk = false;
                 }
             } else {
-                qWarning() << Q_FUNC_INFO << currentValueQuery.executedQuery() << currentValueQuery.lastError().text();
+                qWarning() << Q_FUNC_INFO << currentValueQuery->executedQuery() << currentValueQuery->lastError().text();
                 error("Failed loading the current " + attributeName + " of " + item.singular + " " + id + ".");
                 valueOk = false;
             }
         }
         if (valueOk) {
-            QSqlQuery keyQuery;
-            keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-            keyQuery.bindValue(":id", id);
-            if (keyQuery.exec()) {
-                if (keyQuery.next()) {
-                    QSqlQuery updateQuery;
-                    updateQuery.prepare("UPDATE " + item.updateTable + " SET " + attribute + " = :value WHERE key = :key");
-                    updateQuery.bindValue(":key", keyQuery.value(0).toInt());
-                    updateQuery.bindValue(":value", value);
-                    if (updateQuery.exec()) {
-                        successfulIds.append(id);
-                    } else {
-                        qWarning() << Q_FUNC_INFO << updateQuery.executedQuery() << updateQuery.lastError().text();
-                        error("Failed setting " + attributeName + " of " + item.singular + " " + id + ".");
-                    }
+            bool itemKeyLoaded = false;
+            const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+            if (!itemKeyLoaded) {
+                error("Failed to load " + item.singular + " " + id + ".");
+                return;
+            }
+            if (itemKey >= 0) {
+                PreparedQuery updateQuery("UPDATE " + item.updateTable + " SET " + attribute + " = :value WHERE key = :key");
+                updateQuery->bindValue(":key", itemKey);
+                updateQuery->bindValue(":value", value);
+                if (updateQuery->exec()) {
+                    successfulIds.append(id);
                 } else {
-                    warning("Failed to set " + attributeName + " of " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+                    qWarning() << Q_FUNC_INFO << updateQuery->executedQuery() << updateQuery->lastError().text();
+                    error("Failed setting " + attributeName + " of " + item.singular + " " + id + ".");
                 }
             } else {
-                qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-                error("Failed loading " + item.singular + " " + id + ".");
+                warning("Failed to set " + attributeName + " of " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
             }
         }
     }
@@ -1095,7 +1317,6 @@ template <typename T> void Terminal::setNumberAttribute(const ItemInfos item, co
             success("Set " + attributeName + " of " + item.plural + " " + successfulIds.join(", ") + " to " + QString::number(value) + number.unit + ".");
         }
     }
-    emit dbChanged();
 }
 
 void Terminal::setItemAttribute(const ItemInfos item, const QString attribute, const QString attributeName, QStringList ids, QList<Key> valueKeys, const ItemInfos foreignItem) {
@@ -1114,47 +1335,42 @@ void Terminal::setItemAttribute(const ItemInfos item, const QString attribute, c
             error("Can't set " + item.singular + " " + attributeName + " because the given " + foreignItem.singular + " ID is invalid.");
             return;
         }
-        QSqlQuery foreignItemQuery;
-        foreignItemQuery.prepare("SELECT key FROM " + foreignItem.selectTable + " WHERE id = :id");
-        foreignItemQuery.bindValue(":id", foreignItemIds.first());
-        if (!foreignItemQuery.exec()) {
-            qWarning() << Q_FUNC_INFO << foreignItemQuery.executedQuery() << foreignItemQuery.lastError().text();
-            error("Failed to execute check if " + foreignItem.singular + " exists.");
+        bool foreignItemKeyLoaded = false;
+        foreignItemKey = ItemIndex::getKey(foreignItem.selectTable, foreignItemIds.first(), &foreignItemKeyLoaded);
+        if (!foreignItemKeyLoaded) {
+            error("Failed to load " + foreignItem.singular + " " + foreignItemIds.first() + ".");
             return;
         }
-        if (!foreignItemQuery.next()) {
+        if (foreignItemKey < 0) {
             error("Can't set " + item.singular + " " + attributeName + " because " + foreignItem.singular + " " + foreignItemIds.first() + " doesn't exist.");
             return;
         }
-        foreignItemKey = foreignItemQuery.value(0).toInt();
     }
     createItems(item, ids);
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                QSqlQuery updateQuery;
-                if (removeItem) {
-                    updateQuery.prepare("UPDATE " + item.updateTable + " SET " + attribute + " = NULL WHERE key = :key");
-                } else {
-                    updateQuery.prepare("UPDATE " + item.updateTable + " SET " + attribute + " = :item WHERE key = :key");
-                    updateQuery.bindValue(":item", foreignItemKey);
-                }
-                updateQuery.bindValue(":key", keyQuery.value(0).toInt());
-                if (updateQuery.exec()) {
-                    successfulIds.append(id);
-                } else {
-                    qWarning() << Q_FUNC_INFO << updateQuery.executedQuery() << updateQuery.lastError().text();
-                    error("Failed setting " + attributeName + " of " + item.singular + " " + id + ".");
-                }
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            PreparedQuery updateQuery;
+            if (removeItem) {
+                updateQuery.prepare("UPDATE " + item.updateTable + " SET " + attribute + " = NULL WHERE key = :key");
             } else {
-                warning("Failed to set " + attributeName + " of " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+                updateQuery.prepare("UPDATE " + item.updateTable + " SET " + attribute + " = :item WHERE key = :key");
+                updateQuery->bindValue(":item", foreignItemKey);
+            }
+            updateQuery->bindValue(":key", itemKey);
+            if (updateQuery->exec()) {
+                successfulIds.append(id);
+            } else {
+                qWarning() << Q_FUNC_INFO << updateQuery->executedQuery() << updateQuery->lastError().text();
+                error("Failed setting " + attributeName + " of " + item.singular + " " + id + ".");
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            warning("Failed to set " + attributeName + " of " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     if (removeItem) {
@@ -1170,7 +1386,6 @@ void Terminal::setItemAttribute(const ItemInfos item, const QString attribute, c
             success("Set " + attributeName + " of " + item.plural + " " + successfulIds.join(", ") + " to " + foreignItem.singular + " " + foreignItemId + ".");
         }
     }
-    emit dbChanged();
 }
 
 void Terminal::setItemListAttribute(const ItemInfos item, const QString attributeName, QStringList ids, QList<Key> valueKeys, const ItemInfos foreignItem, const QString valueTable) {
@@ -1188,19 +1403,17 @@ void Terminal::setItemListAttribute(const ItemInfos item, const QString attribut
             return;
         }
         for (QString foreignItemId : foreignItemIds) {
-            QSqlQuery foreignItemQuery;
-            foreignItemQuery.prepare("SELECT key FROM " + foreignItem.selectTable + " WHERE id = :id");
-            foreignItemQuery.bindValue(":id", foreignItemId);
-            if (foreignItemQuery.exec()) {
-                if (foreignItemQuery.next()) {
-                    foreignItemKeys.append(foreignItemQuery.value(0).toInt());
-                    foreignItemIdStrings.append(foreignItemId);
-                } else {
-                    warning("Can't add " + foreignItem.singular + " " + foreignItemId + " to " + item.singular + " " + attributeName + " because this " + foreignItem.singular + " doesn't exist.");
-                }
+            bool foreignItemKeyLoaded = false;
+            const int foreignItemKey = ItemIndex::getKey(foreignItem.selectTable, foreignItemId, &foreignItemKeyLoaded);
+            if (!foreignItemKeyLoaded) {
+                error("Failed to load " + foreignItem.singular + " " + foreignItemId + ".");
+                return;
+            }
+            if (foreignItemKey >= 0) {
+                foreignItemKeys.append(foreignItemKey);
+                foreignItemIdStrings.append(foreignItemId);
             } else {
-                qWarning() << Q_FUNC_INFO << foreignItemQuery.executedQuery() << foreignItemQuery.lastError().text();
-                error("Failed to execute check if " + foreignItem.singular + " " + foreignItemId + " exists.");
+                warning("Can't add " + foreignItem.singular + " " + foreignItemId + " to " + item.singular + " " + attributeName + " because this " + foreignItem.singular + " doesn't exist.");
             }
         }
         Q_ASSERT(foreignItemKeys.length() == foreignItemIdStrings.length());
@@ -1212,42 +1425,37 @@ void Terminal::setItemListAttribute(const ItemInfos item, const QString attribut
     createItems(item, ids);
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                const int itemKey = keyQuery.value(0).toInt();
-                bool allQueriesSuccessful = true;
-                QSqlQuery deleteQuery;
-                deleteQuery.prepare("DELETE FROM " + valueTable + " WHERE item_key =  :key");
-                deleteQuery.bindValue(":key", itemKey);
-                if (deleteQuery.exec()) {
-                    for (const int foreignItemKey : foreignItemKeys) {
-                        QSqlQuery insertQuery;
-                        insertQuery.prepare("INSERT INTO " + valueTable + " (item_key, valueitem_key) VALUES (:item, :foreign_item)");
-                        insertQuery.bindValue(":item", itemKey);
-                        insertQuery.bindValue(":foreign_item", foreignItemKey);
-                        if (!insertQuery.exec()) {
-                            allQueriesSuccessful = false;
-                            qWarning() << Q_FUNC_INFO << insertQuery.executedQuery() << insertQuery.lastError().text();
-                            error("Failed to insert a " + foreignItem.singular + " into " + item.singular + " " + id + ".");
-                        }
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            bool allQueriesSuccessful = true;
+            PreparedQuery deleteQuery("DELETE FROM " + valueTable + " WHERE item_key =  :key");
+            deleteQuery->bindValue(":key", itemKey);
+            if (deleteQuery->exec()) {
+                for (const int foreignItemKey : foreignItemKeys) {
+                    PreparedQuery insertQuery("INSERT INTO " + valueTable + " (item_key, valueitem_key) VALUES (:item, :foreign_item)");
+                    insertQuery->bindValue(":item", itemKey);
+                    insertQuery->bindValue(":foreign_item", foreignItemKey);
+                    if (!insertQuery->exec()) {
+                        allQueriesSuccessful = false;
+                        qWarning() << Q_FUNC_INFO << insertQuery->executedQuery() << insertQuery->lastError().text();
+                        error("Failed to insert a " + foreignItem.singular + " into " + item.singular + " " + id + ".");
                     }
-                } else {
-                    allQueriesSuccessful = false;
-                    qWarning() << Q_FUNC_INFO << deleteQuery.executedQuery() << deleteQuery.lastError().text();
-                    error("Failed deleting old " + attributeName + " of " + item.singular + " " + id + ".");
-                }
-                if (allQueriesSuccessful) {
-                    successfulIds.append(id);
                 }
             } else {
-                error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+                allQueriesSuccessful = false;
+                qWarning() << Q_FUNC_INFO << deleteQuery->executedQuery() << deleteQuery->lastError().text();
+                error("Failed deleting old " + attributeName + " of " + item.singular + " " + id + ".");
+            }
+            if (allQueriesSuccessful) {
+                successfulIds.append(id);
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     QString foreignItemString = foreignItem.plural + foreignItemIdStrings.join(", ");
@@ -1259,7 +1467,6 @@ void Terminal::setItemListAttribute(const ItemInfos item, const QString attribut
     } else if (successfulIds.length() > 1) {
         success("Set " + attributeName + " of " + item.plural + " " + successfulIds.join(", ") + " to " + foreignItemString + ".");
     }
-    emit dbChanged();
 }
 
 template <typename T> void Terminal::setItemSpecificNumberAttribute(const ItemInfos item, const QString attributeName, QStringList ids, QStringList foreignItemIds, QList<Key> valueKeys, const ItemInfos foreignItem, const QString valueTable, const NumberInfos number) {
@@ -1279,19 +1486,17 @@ template <typename T> void Terminal::setItemSpecificNumberAttribute(const ItemIn
     QList<int> foreignItemKeys;
     QStringList foreignItemIdStrings;
     for (QString foreignItemId : foreignItemIds) {
-        QSqlQuery foreignItemQuery;
-        foreignItemQuery.prepare("SELECT key FROM " + foreignItem.selectTable + " WHERE id = :id");
-        foreignItemQuery.bindValue(":id", foreignItemId);
-        if (foreignItemQuery.exec()) {
-            if (foreignItemQuery.next()) {
-                foreignItemKeys.append(foreignItemQuery.value(0).toInt());
-                foreignItemIdStrings.append(foreignItemId);
-            } else {
-                warning("Can't set " + attributeName + " for " + foreignItem.singular + " " + foreignItemId + " because this " + foreignItem.singular + " doesn't exist.");
-            }
+        bool foreignItemKeyLoaded = false;
+        const int foreignItemKey = ItemIndex::getKey(foreignItem.selectTable, foreignItemId, &foreignItemKeyLoaded);
+        if (!foreignItemKeyLoaded) {
+            error("Failed to load " + foreignItem.singular + " " + foreignItemId + ".");
+            return;
+        }
+        if (foreignItemKey >= 0) {
+            foreignItemKeys.append(foreignItemKey);
+            foreignItemIdStrings.append(foreignItemId);
         } else {
-            qWarning() << Q_FUNC_INFO << foreignItemQuery.executedQuery() << foreignItemQuery.lastError().text();
-            error("Failed to execute check if " + foreignItem.singular + " " + foreignItemId + " exists.");
+            warning("Can't set " + attributeName + " for " + foreignItem.singular + " " + foreignItemId + " because this " + foreignItem.singular + " doesn't exist.");
         }
     }
     Q_ASSERT(foreignItemKeys.length() == foreignItemIdStrings.length());
@@ -1302,71 +1507,65 @@ template <typename T> void Terminal::setItemSpecificNumberAttribute(const ItemIn
     createItems(item, ids);
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                const int itemKey = keyQuery.value(0).toInt();
-                bool allQueriesSuccessful = true;
-                for (const int foreignItemKey : foreignItemKeys) {
-                    if (removeValues) {
-                        QSqlQuery query;
-                        query.prepare("DELETE FROM " + valueTable + " WHERE item_key = :item AND foreignitem_key = :foreign_item");
-                        query.bindValue(":item", itemKey);
-                        query.bindValue(":foreign_item", foreignItemKey);
-                        if (!query.exec()) {
-                            allQueriesSuccessful = false;
-                            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-                            error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
-                        }
-                    } else {
-                        bool valueOk = true;
-                        if (difference) {
-                            QSqlQuery currentValueQuery;
-                            currentValueQuery.prepare("SELECT value FROM " + valueTable + " WHERE item_key = :item AND foreignitem_key = :foreign_item");
-                            currentValueQuery.bindValue(":item", itemKey);
-                            currentValueQuery.bindValue(":foreign_item", foreignItemKey);
-                            if (currentValueQuery.exec()) {
-                                if (currentValueQuery.next()) {
-                                    value = keysToFloat(valueKeys, &valueOk, currentValueQuery.value(0).toFloat(), number);
-                                } else {
-                                    value = keysToFloat(valueKeys, &valueOk, currentValueQuery.value(0).toFloat(), number);
-                                }
-                                if (!valueOk) {
-                                    error("Invalid value given for " + item.singular + " " + id + ".");
-                                }
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            bool allQueriesSuccessful = true;
+            for (const int foreignItemKey : foreignItemKeys) {
+                if (removeValues) {
+                    PreparedQuery query("DELETE FROM " + valueTable + " WHERE item_key = :item AND foreignitem_key = :foreign_item");
+                    query->bindValue(":item", itemKey);
+                    query->bindValue(":foreign_item", foreignItemKey);
+                    if (!query->exec()) {
+                        allQueriesSuccessful = false;
+                        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+                        error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
+                    }
+                } else {
+                    bool valueOk = true;
+                    if (difference) {
+                        PreparedQuery currentValueQuery("SELECT value FROM " + valueTable + " WHERE item_key = :item AND foreignitem_key = :foreign_item");
+                        currentValueQuery->bindValue(":item", itemKey);
+                        currentValueQuery->bindValue(":foreign_item", foreignItemKey);
+                        if (currentValueQuery->exec()) {
+                            if (currentValueQuery->next()) {
+                                value = keysToFloat(valueKeys, &valueOk, currentValueQuery->value(0).toFloat(), number);
                             } else {
-                                qWarning() << Q_FUNC_INFO << currentValueQuery.executedQuery() << currentValueQuery.lastError().text();
-                                error("Failed loading the current " + attributeName + " of " + item.singular + " " + id + ".");
-                                valueOk = false;
+                                value = keysToFloat(valueKeys, &valueOk, currentValueQuery->value(0).toFloat(), number);
                             }
-                        }
-                        if (valueOk) {
-                            QSqlQuery query;
-                            query.prepare("INSERT OR REPLACE INTO " + valueTable + " (item_key, foreignitem_key, value) VALUES (:item, :foreign_item, :value)");
-                            query.bindValue(":item", itemKey);
-                            query.bindValue(":foreign_item", foreignItemKey);
-                            query.bindValue(":value", value);
-                            if (!query.exec()) {
-                                allQueriesSuccessful = false;
-                                qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-                                error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
+                            if (!valueOk) {
+                                error("Invalid value given for " + item.singular + " " + id + ".");
                             }
                         } else {
+                            qWarning() << Q_FUNC_INFO << currentValueQuery->executedQuery() << currentValueQuery->lastError().text();
+                            error("Failed loading the current " + attributeName + " of " + item.singular + " " + id + ".");
+                            valueOk = false;
+                        }
+                    }
+                    if (valueOk) {
+                        PreparedQuery query("INSERT OR REPLACE INTO " + valueTable + " (item_key, foreignitem_key, value) VALUES (:item, :foreign_item, :value)");
+                        query->bindValue(":item", itemKey);
+                        query->bindValue(":foreign_item", foreignItemKey);
+                        query->bindValue(":value", value);
+                        if (!query->exec()) {
                             allQueriesSuccessful = false;
+                            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+                            error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
                         }
+                    } else {
+                        allQueriesSuccessful = false;
                     }
                 }
-                if (allQueriesSuccessful) {
-                    successfulIds.append(id);
-                }
-            } else {
-                error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+            }
+            if (allQueriesSuccessful) {
+                successfulIds.append(id);
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     QString foreignItemString = foreignItem.plural + " " + foreignItemIdStrings.join(", ");
@@ -1394,7 +1593,6 @@ template <typename T> void Terminal::setItemSpecificNumberAttribute(const ItemIn
             }
         }
     }
-    emit dbChanged();
 }
 
 void Terminal::setItemSpecificItemListAttribute(const ItemInfos item, const QString attributeName, QStringList ids, QStringList foreignItemIds, QList<Key> valueKeys, const ItemInfos foreignItem, const ItemInfos valueItem, const QString valueTable, const bool limitToOne) {
@@ -1418,19 +1616,17 @@ void Terminal::setItemSpecificItemListAttribute(const ItemInfos item, const QStr
             return;
         }
         for (QString valueItemId : valueItemIds) {
-            QSqlQuery valueItemQuery;
-            valueItemQuery.prepare("SELECT key FROM " + valueItem.selectTable + " WHERE id = :id");
-            valueItemQuery.bindValue(":id", valueItemId);
-            if (valueItemQuery.exec()) {
-                if (valueItemQuery.next()) {
-                    valueItemKeys.append(valueItemQuery.value(0).toInt());
-                    valueItemIdStrings.append(valueItemId);
-                } else {
-                    warning("Can't add " + valueItem.singular + " " + valueItemId + " to " + item.singular + " " + attributeName + " because this " + valueItem.singular + " doesn't exist.");
-                }
+            bool valueItemKeyLoaded = false;
+            const int valueItemKey = ItemIndex::getKey(valueItem.selectTable, valueItemId, &valueItemKeyLoaded);
+            if (!valueItemKeyLoaded) {
+                error("Failed to load " + valueItem.singular + " " + valueItemId + ".");
+                return;
+            }
+            if (valueItemKey >= 0) {
+                valueItemKeys.append(valueItemKey);
+                valueItemIdStrings.append(valueItemId);
             } else {
-                qWarning() << Q_FUNC_INFO << valueItemQuery.executedQuery() << valueItemQuery.lastError().text();
-                error("Failed to execute check if " + valueItem.singular + " " + valueItemId + " exists.");
+                warning("Can't add " + valueItem.singular + " " + valueItemId + " to " + item.singular + " " + attributeName + " because this " + valueItem.singular + " doesn't exist.");
             }
         }
         Q_ASSERT(valueItemKeys.length() == valueItemIdStrings.length());
@@ -1442,19 +1638,17 @@ void Terminal::setItemSpecificItemListAttribute(const ItemInfos item, const QStr
     QList<int> foreignItemKeys;
     QStringList foreignItemIdStrings;
     for (QString foreignItemId : foreignItemIds) {
-        QSqlQuery foreignItemQuery;
-        foreignItemQuery.prepare("SELECT key FROM " + foreignItem.selectTable + " WHERE id = :id");
-        foreignItemQuery.bindValue(":id", foreignItemId);
-        if (foreignItemQuery.exec()) {
-            if (foreignItemQuery.next()) {
-                foreignItemKeys.append(foreignItemQuery.value(0).toInt());
-                foreignItemIdStrings.append(foreignItemId);
-            } else {
-                warning("Can't set " + attributeName + " for " + foreignItem.singular + " " + foreignItemId + " because this " + foreignItem.singular + " doesn't exist.");
-            }
+        bool foreignItemKeyLoaded = false;
+        const int foreignItemKey = ItemIndex::getKey(foreignItem.selectTable, foreignItemId, &foreignItemKeyLoaded);
+        if (!foreignItemKeyLoaded) {
+            error("Failed to load " + foreignItem.singular + " " + foreignItemId + ".");
+            return;
+        }
+        if (foreignItemKey >= 0) {
+            foreignItemKeys.append(foreignItemKey);
+            foreignItemIdStrings.append(foreignItemId);
         } else {
-            qWarning() << Q_FUNC_INFO << foreignItemQuery.executedQuery() << foreignItemQuery.lastError().text();
-            error("Failed to execute check if " + foreignItem.singular + " " + foreignItemId + " exists.");
+            warning("Can't set " + attributeName + " for " + foreignItem.singular + " " + foreignItemId + " because this " + foreignItem.singular + " doesn't exist.");
         }
     }
     Q_ASSERT(foreignItemKeys.size() == foreignItemIdStrings.size());
@@ -1465,45 +1659,40 @@ void Terminal::setItemSpecificItemListAttribute(const ItemInfos item, const QStr
     createItems(item, ids);
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                const int itemKey = keyQuery.value(0).toInt();
-                bool allQueriesSuccessful = true;
-                for (const int foreignItemKey : foreignItemKeys) {
-                    QSqlQuery deleteQuery;
-                    deleteQuery.prepare("DELETE FROM " + valueTable + " WHERE item_key =  :item AND foreignitem_key = :foreign_item");
-                    deleteQuery.bindValue(":item", itemKey);
-                    deleteQuery.bindValue(":foreign_item", foreignItemKey);
-                    if (!deleteQuery.exec()) {
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            bool allQueriesSuccessful = true;
+            for (const int foreignItemKey : foreignItemKeys) {
+                PreparedQuery deleteQuery("DELETE FROM " + valueTable + " WHERE item_key =  :item AND foreignitem_key = :foreign_item");
+                deleteQuery->bindValue(":item", itemKey);
+                deleteQuery->bindValue(":foreign_item", foreignItemKey);
+                if (!deleteQuery->exec()) {
+                    allQueriesSuccessful = false;
+                    qWarning() << Q_FUNC_INFO << deleteQuery->executedQuery() << deleteQuery->lastError().text();
+                    error("Failed deleting old " + attributeName + " of " + item.singular + " " + id + ".");
+                }
+                for (const int valueItemKey : valueItemKeys) {
+                    PreparedQuery insertQuery("INSERT INTO " + valueTable + " (item_key, foreignitem_key, valueitem_key) VALUES (:item, :foreign_item, :value_item)");
+                    insertQuery->bindValue(":item", itemKey);
+                    insertQuery->bindValue(":foreign_item", foreignItemKey);
+                    insertQuery->bindValue(":value_item", valueItemKey);
+                    if (!insertQuery->exec()) {
                         allQueriesSuccessful = false;
-                        qWarning() << Q_FUNC_INFO << deleteQuery.executedQuery() << deleteQuery.lastError().text();
-                        error("Failed deleting old " + attributeName + " of " + item.singular + " " + id + ".");
-                    }
-                    for (const int valueItemKey : valueItemKeys) {
-                        QSqlQuery insertQuery;
-                        insertQuery.prepare("INSERT INTO " + valueTable + " (item_key, foreignitem_key, valueitem_key) VALUES (:item, :foreign_item, :value_item)");
-                        insertQuery.bindValue(":item", itemKey);
-                        insertQuery.bindValue(":foreign_item", foreignItemKey);
-                        insertQuery.bindValue(":value_item", valueItemKey);
-                        if (!insertQuery.exec()) {
-                            allQueriesSuccessful = false;
-                            qWarning() << Q_FUNC_INFO << insertQuery.executedQuery() << insertQuery.lastError().text();
-                            error("Failed to insert a " + foreignItem.singular + " into " + item.singular + " " + id + ".");
-                        }
+                        qWarning() << Q_FUNC_INFO << insertQuery->executedQuery() << insertQuery->lastError().text();
+                        error("Failed to insert a " + foreignItem.singular + " into " + item.singular + " " + id + ".");
                     }
                 }
-                if (allQueriesSuccessful) {
-                    successfulIds.append(id);
-                }
-            } else {
-                error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+            }
+            if (allQueriesSuccessful) {
+                successfulIds.append(id);
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     QString valueItemString = valueItem.plural + " " + valueItemIdStrings.join(", ");
@@ -1527,7 +1716,6 @@ void Terminal::setItemSpecificItemListAttribute(const ItemInfos item, const QStr
             success("Set " + attributeName + " of " + item.plural + " " + successfulIds.join(", ") + " at " + foreignItemString + " to " + valueItemString + ".");
         }
     }
-    emit dbChanged();
 }
 
 template <typename T> void Terminal::setIntegerSpecificNumberAttribute(const ItemInfos item, const QString attributeName, QStringList ids, QString numberId, QList<Key> valueKeys, const QString valueTable, const NumberInfos keyNumber, const NumberInfos valueNumber) {
@@ -1562,65 +1750,59 @@ template <typename T> void Terminal::setIntegerSpecificNumberAttribute(const Ite
     createItems(item, ids);
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                const int itemKey = keyQuery.value(0).toInt();
-                if (removeValues) {
-                    QSqlQuery query;
-                    query.prepare("DELETE FROM " + valueTable + " WHERE item_key = :item AND key = :key");
-                    query.bindValue(":item", itemKey);
-                    query.bindValue(":key", key);
-                    if (query.exec()) {
-                        successfulIds.append(id);
-                    } else {
-                        qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-                        error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
-                    }
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            if (removeValues) {
+                PreparedQuery query("DELETE FROM " + valueTable + " WHERE item_key = :item AND key = :key");
+                query->bindValue(":item", itemKey);
+                query->bindValue(":key", key);
+                if (query->exec()) {
+                    successfulIds.append(id);
                 } else {
-                    bool valueOk = true;
-                    if (difference) {
-                        QSqlQuery currentValueQuery;
-                        currentValueQuery.prepare("SELECT value FROM " + valueTable + " WHERE item_key = :item AND key = :key");
-                        currentValueQuery.bindValue(":item", itemKey);
-                        currentValueQuery.bindValue(":key", key);
-                        if (currentValueQuery.exec()) {
-                            if (currentValueQuery.next()) {
-                                value = keysToFloat(valueKeys, &valueOk, currentValueQuery.value(0).toFloat(), valueNumber);
-                            } else {
-                                value = keysToFloat(valueKeys, &valueOk, 0, valueNumber);
-                            }
-                            if (!valueOk) {
-                                error("Invalid value given for " + item.singular + " " + id + ".");
-                            }
+                    qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+                    error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
+                }
+            } else {
+                bool valueOk = true;
+                if (difference) {
+                    PreparedQuery currentValueQuery("SELECT value FROM " + valueTable + " WHERE item_key = :item AND key = :key");
+                    currentValueQuery->bindValue(":item", itemKey);
+                    currentValueQuery->bindValue(":key", key);
+                    if (currentValueQuery->exec()) {
+                        if (currentValueQuery->next()) {
+                            value = keysToFloat(valueKeys, &valueOk, currentValueQuery->value(0).toFloat(), valueNumber);
                         } else {
-                            qWarning() << Q_FUNC_INFO << currentValueQuery.executedQuery() << currentValueQuery.lastError().text();
-                            error("Failed loading the current " + attributeName + " of " + item.singular + " " + id + ".");
-                            valueOk = false;
+                            value = keysToFloat(valueKeys, &valueOk, 0, valueNumber);
                         }
-                    }
-                    if (valueOk) {
-                        QSqlQuery query;
-                        query.prepare("INSERT OR REPLACE INTO " + valueTable + " (item_key, key, value) VALUES (:item, :key, :value)");
-                        query.bindValue(":item", itemKey);
-                        query.bindValue(":key", key);
-                        query.bindValue(":value", value);
-                        if (query.exec()) {
-                            successfulIds.append(id);
-                        } else {
-                            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-                            error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
+                        if (!valueOk) {
+                            error("Invalid value given for " + item.singular + " " + id + ".");
                         }
+                    } else {
+                        qWarning() << Q_FUNC_INFO << currentValueQuery->executedQuery() << currentValueQuery->lastError().text();
+                        error("Failed loading the current " + attributeName + " of " + item.singular + " " + id + ".");
+                        valueOk = false;
+                    }
+                }
+                if (valueOk) {
+                    PreparedQuery query("INSERT OR REPLACE INTO " + valueTable + " (item_key, key, value) VALUES (:item, :key, :value)");
+                    query->bindValue(":item", itemKey);
+                    query->bindValue(":key", key);
+                    query->bindValue(":value", value);
+                    if (query->exec()) {
+                        successfulIds.append(id);
+                    } else {
+                        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+                        error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
                     }
                 }
-            } else {
-                error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     if (removeValues) {
@@ -1644,7 +1826,6 @@ template <typename T> void Terminal::setIntegerSpecificNumberAttribute(const Ite
             }
         }
     }
-    emit dbChanged();
 }
 
 void Terminal::setIntegerSpecificItemListAttribute(ItemInfos item, QString attributeName, QStringList ids, QString integerId, QList<Key> valueKeys, ItemInfos valueItem, QString valueTable, NumberInfos keyInteger, bool limitToOne) {
@@ -1683,19 +1864,17 @@ void Terminal::setIntegerSpecificItemListAttribute(ItemInfos item, QString attri
             return;
         }
         for (QString valueItemId : valueItemIds) {
-            QSqlQuery valueItemQuery;
-            valueItemQuery.prepare("SELECT key FROM " + valueItem.selectTable + " WHERE id = :id");
-            valueItemQuery.bindValue(":id", valueItemId);
-            if (valueItemQuery.exec()) {
-                if (valueItemQuery.next()) {
-                    valueItemKeys.append(valueItemQuery.value(0).toInt());
-                    valueItemIdStrings.append(valueItemId);
-                } else {
-                    warning("Can't add " + valueItem.singular + " " + valueItemId + " to " + item.singular + " " + attributeName + " because this " + valueItem.singular + " doesn't exist.");
-                }
+            bool valueItemKeyLoaded = false;
+            const int valueItemKey = ItemIndex::getKey(valueItem.selectTable, valueItemId, &valueItemKeyLoaded);
+            if (!valueItemKeyLoaded) {
+                error("Failed to load " + valueItem.singular + " " + valueItemId + ".");
+                return;
+            }
+            if (valueItemKey >= 0) {
+                valueItemKeys.append(valueItemKey);
+                valueItemIdStrings.append(valueItemId);
             } else {
-                qWarning() << Q_FUNC_INFO << valueItemQuery.executedQuery() << valueItemQuery.lastError().text();
-                error("Failed to execute check if " + valueItem.singular + " " + valueItemId + " exists.");
+                warning("Can't add " + valueItem.singular + " " + valueItemId + " to " + item.singular + " " + attributeName + " because this " + valueItem.singular + " doesn't exist.");
             }
         }
         Q_ASSERT(valueItemKeys.length() == valueItemIdStrings.length());
@@ -1711,43 +1890,38 @@ void Terminal::setIntegerSpecificItemListAttribute(ItemInfos item, QString attri
     createItems(item, ids);
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                const int itemKey = keyQuery.value(0).toInt();
-                bool allQueriesSuccessful = true;
-                QSqlQuery deleteQuery;
-                deleteQuery.prepare("DELETE FROM " + valueTable + " WHERE item_key =  :item AND key = :key");
-                deleteQuery.bindValue(":item", itemKey);
-                deleteQuery.bindValue(":key", key);
-                if (!deleteQuery.exec()) {
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            bool allQueriesSuccessful = true;
+            PreparedQuery deleteQuery("DELETE FROM " + valueTable + " WHERE item_key =  :item AND key = :key");
+            deleteQuery->bindValue(":item", itemKey);
+            deleteQuery->bindValue(":key", key);
+            if (!deleteQuery->exec()) {
+                allQueriesSuccessful = false;
+                qWarning() << Q_FUNC_INFO << deleteQuery->executedQuery() << deleteQuery->lastError().text();
+                error("Failed deleting old " + attributeName + " of " + item.singular + " " + id + ".");
+            }
+            for (const int valueItemKey : valueItemKeys) {
+                PreparedQuery insertQuery("INSERT INTO " + valueTable + " (item_key, key, valueitem_key) VALUES (:item, :key, :value_item)");
+                insertQuery->bindValue(":item", itemKey);
+                insertQuery->bindValue(":key", key);
+                insertQuery->bindValue(":value_item", valueItemKey);
+                if (!insertQuery->exec()) {
                     allQueriesSuccessful = false;
-                    qWarning() << Q_FUNC_INFO << deleteQuery.executedQuery() << deleteQuery.lastError().text();
-                    error("Failed deleting old " + attributeName + " of " + item.singular + " " + id + ".");
+                    qWarning() << Q_FUNC_INFO << insertQuery->executedQuery() << insertQuery->lastError().text();
+                    error("Failed to insert a " + valueItem.singular + " into " + item.singular + " " + id + ".");
                 }
-                for (const int valueItemKey : valueItemKeys) {
-                    QSqlQuery insertQuery;
-                    insertQuery.prepare("INSERT INTO " + valueTable + " (item_key, key, valueitem_key) VALUES (:item, :key, :value_item)");
-                    insertQuery.bindValue(":item", itemKey);
-                    insertQuery.bindValue(":key", key);
-                    insertQuery.bindValue(":value_item", valueItemKey);
-                    if (!insertQuery.exec()) {
-                        allQueriesSuccessful = false;
-                        qWarning() << Q_FUNC_INFO << insertQuery.executedQuery() << insertQuery.lastError().text();
-                        error("Failed to insert a " + valueItem.singular + " into " + item.singular + " " + id + ".");
-                    }
-                }
-                if (allQueriesSuccessful) {
-                    successfulIds.append(id);
-                }
-            } else {
-                error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+            }
+            if (allQueriesSuccessful) {
+                successfulIds.append(id);
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     QString valueItemString = valueItem.plural + " " + valueItemIdStrings.join(", ");
@@ -1767,7 +1941,6 @@ void Terminal::setIntegerSpecificItemListAttribute(ItemInfos item, QString attri
             success("Set " + attributeName + " of " + item.plural + " " + successfulIds.join(", ") + " at " + QString::number(key) + " to " + valueItemString + ".");
         }
     }
-    emit dbChanged();
 }
 
 template <typename T> void Terminal::setItemAndIntegerSpecificNumberAttribute(ItemInfos item, QString attributeName, QStringList ids, QStringList foreignItemIds, QString numberId, QList<Key> valueKeys, ItemInfos foreignItem, QString valueTable, NumberInfos keyNumber, NumberInfos valueNumber) {
@@ -1802,19 +1975,17 @@ template <typename T> void Terminal::setItemAndIntegerSpecificNumberAttribute(It
     QList<int> foreignItemKeys;
     QStringList foreignItemIdStrings;
     for (QString foreignItemId : foreignItemIds) {
-        QSqlQuery foreignItemQuery;
-        foreignItemQuery.prepare("SELECT key FROM " + foreignItem.selectTable + " WHERE id = :id");
-        foreignItemQuery.bindValue(":id", foreignItemId);
-        if (foreignItemQuery.exec()) {
-            if (foreignItemQuery.next()) {
-                foreignItemKeys.append(foreignItemQuery.value(0).toInt());
-                foreignItemIdStrings.append(foreignItemId);
-            } else {
-                warning("Can't set " + attributeName + " for " + foreignItem.singular + " " + foreignItemId + " because this " + foreignItem.singular + " doesn't exist.");
-            }
+        bool foreignItemKeyLoaded = false;
+        const int foreignItemKey = ItemIndex::getKey(foreignItem.selectTable, foreignItemId, &foreignItemKeyLoaded);
+        if (!foreignItemKeyLoaded) {
+            error("Failed to load " + foreignItem.singular + " " + foreignItemId + ".");
+            return;
+        }
+        if (foreignItemKey >= 0) {
+            foreignItemKeys.append(foreignItemKey);
+            foreignItemIdStrings.append(foreignItemId);
         } else {
-            qWarning() << Q_FUNC_INFO << foreignItemQuery.executedQuery() << foreignItemQuery.lastError().text();
-            error("Failed to execute check if " + foreignItem.singular + " " + foreignItemId + " exists.");
+            warning("Can't set " + attributeName + " for " + foreignItem.singular + " " + foreignItemId + " because this " + foreignItem.singular + " doesn't exist.");
         }
     }
     Q_ASSERT(foreignItemKeys.length() == foreignItemIdStrings.length());
@@ -1825,72 +1996,66 @@ template <typename T> void Terminal::setItemAndIntegerSpecificNumberAttribute(It
     createItems(item, ids);
     QStringList successfulIds;
     for (QString id : ids) {
-        QSqlQuery keyQuery;
-        keyQuery.prepare("SELECT key FROM " + item.selectTable + " WHERE id = :id");
-        keyQuery.bindValue(":id", id);
-        if (keyQuery.exec()) {
-            if (keyQuery.next()) {
-                const int itemKey = keyQuery.value(0).toInt();
-                bool allQueriesSuccessful = true;
-                for (const int foreignItemKey : foreignItemKeys) {
-                    if (removeValues) {
-                        QSqlQuery query;
-                        query.prepare("DELETE FROM " + valueTable + " WHERE item_key = :item AND foreignitem_key = :foreign_item AND key = :key");
-                        query.bindValue(":item", itemKey);
-                        query.bindValue(":foreign_item", foreignItemKey);
-                        query.bindValue(":key", key);
-                        if (!query.exec()) {
-                            allQueriesSuccessful = false;
-                            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-                            error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
-                        }
-                    } else {
-                        bool valueOk = true;
-                        if (difference) {
-                            QSqlQuery currentValueQuery;
-                            currentValueQuery.prepare("SELECT value FROM " + valueTable + " WHERE item_key = :item AND foreignitem_key = :foreign_item AND key = :key");
-                            currentValueQuery.bindValue(":item", itemKey);
-                            currentValueQuery.bindValue(":foreign_item", foreignItemKey);
-                            currentValueQuery.bindValue(":key", key);
-                            if (currentValueQuery.exec()) {
-                                if (currentValueQuery.next()) {
-                                    value = keysToFloat(valueKeys, &valueOk, currentValueQuery.value(0).toFloat(), valueNumber);
-                                } else {
-                                    value = keysToFloat(valueKeys, &valueOk, 0, valueNumber);
-                                }
-                                if (!valueOk) {
-                                    error("Invalid value given for " + item.singular + " " + id + ".");
-                                }
+        bool itemKeyLoaded = false;
+        const int itemKey = ItemIndex::getKey(item.selectTable, id, &itemKeyLoaded);
+        if (!itemKeyLoaded) {
+            error("Failed to load " + item.singular + " " + id + ".");
+            return;
+        }
+        if (itemKey >= 0) {
+            bool allQueriesSuccessful = true;
+            for (const int foreignItemKey : foreignItemKeys) {
+                if (removeValues) {
+                    PreparedQuery query("DELETE FROM " + valueTable + " WHERE item_key = :item AND foreignitem_key = :foreign_item AND key = :key");
+                    query->bindValue(":item", itemKey);
+                    query->bindValue(":foreign_item", foreignItemKey);
+                    query->bindValue(":key", key);
+                    if (!query->exec()) {
+                        allQueriesSuccessful = false;
+                        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+                        error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
+                    }
+                } else {
+                    bool valueOk = true;
+                    if (difference) {
+                        PreparedQuery currentValueQuery("SELECT value FROM " + valueTable + " WHERE item_key = :item AND foreignitem_key = :foreign_item AND key = :key");
+                        currentValueQuery->bindValue(":item", itemKey);
+                        currentValueQuery->bindValue(":foreign_item", foreignItemKey);
+                        currentValueQuery->bindValue(":key", key);
+                        if (currentValueQuery->exec()) {
+                            if (currentValueQuery->next()) {
+                                value = keysToFloat(valueKeys, &valueOk, currentValueQuery->value(0).toFloat(), valueNumber);
                             } else {
-                                qWarning() << Q_FUNC_INFO << currentValueQuery.executedQuery() << currentValueQuery.lastError().text();
-                                error("Failed loading the current " + attributeName + " of " + item.singular + " " + id + ".");
-                                valueOk = false;
+                                value = keysToFloat(valueKeys, &valueOk, 0, valueNumber);
                             }
-                        }
-                        if (valueOk) {
-                            QSqlQuery query;
-                            query.prepare("INSERT OR REPLACE INTO " + valueTable + " (item_key, foreignitem_key, key, value) VALUES (:item, :foreign_item, :key, :value)");
-                            query.bindValue(":item", itemKey);
-                            query.bindValue(":foreign_item", foreignItemKey);
-                            query.bindValue(":key", key);
-                            query.bindValue(":value", value);
-                            if (!query.exec()) {
-                                allQueriesSuccessful = false;
-                                qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-                                error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
+                            if (!valueOk) {
+                                error("Invalid value given for " + item.singular + " " + id + ".");
                             }
+                        } else {
+                            qWarning() << Q_FUNC_INFO << currentValueQuery->executedQuery() << currentValueQuery->lastError().text();
+                            error("Failed loading the current " + attributeName + " of " + item.singular + " " + id + ".");
+                            valueOk = false;
+                        }
+                    }
+                    if (valueOk) {
+                        PreparedQuery query("INSERT OR REPLACE INTO " + valueTable + " (item_key, foreignitem_key, key, value) VALUES (:item, :foreign_item, :key, :value)");
+                        query->bindValue(":item", itemKey);
+                        query->bindValue(":foreign_item", foreignItemKey);
+                        query->bindValue(":key", key);
+                        query->bindValue(":value", value);
+                        if (!query->exec()) {
+                            allQueriesSuccessful = false;
+                            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+                            error("Failed removing the " + attributeName + " of " + item.singular + " " + id + ".");
                         }
                     }
                 }
-                if (allQueriesSuccessful) {
-                    successfulIds.append(id);
-                }
-            } else {
-                error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
+            }
+            if (allQueriesSuccessful) {
+                successfulIds.append(id);
             }
         } else {
-            qWarning() << Q_FUNC_INFO << keyQuery.executedQuery() << keyQuery.lastError().text();
-            error("Failed loading " + item.singular + " " + id + ".");
+            error("Failed loading " + item.singular + " " + id + " because this " + item.singular + " wasn't found.");
         }
     }
     QString foreignItemString = foreignItem.plural + " " + foreignItemIdStrings.join(", ");
@@ -1918,7 +2083,6 @@ template <typename T> void Terminal::setItemAndIntegerSpecificNumberAttribute(It
             }
         }
     }
-    emit dbChanged();
 }
 
 void Terminal::reload() {
@@ -1996,9 +2160,9 @@ QStringList Terminal::keysToIds(QList<Key> keys) const {
     }
     const Key itemType = keys.first();
     keys.removeFirst();
-    QStringList ids;
+    IdSelection ids;
     if (keys.isEmpty()) {
-        QSqlQuery query;
+        PreparedQuery query;
         if (itemType == Model) {
             query.prepare("SELECT models.id FROM models, currentfixtures WHERE currentfixtures.model_key = models.key");
         } else if (itemType == Fixture) {
@@ -2022,15 +2186,14 @@ QStringList Terminal::keysToIds(QList<Key> keys) const {
         } else {
             return QStringList();
         }
-        if (query.exec()) {
-            while (query.next()) {
-                ids.append(query.value(0).toString());
+        if (query->exec()) {
+            while (query->next()) {
+                ids.add(query->value(0).toString());
             }
         } else {
-            qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
+            qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
         }
     } else {
-        QStringList allIds;
         QString table;
         if (itemType == Model) {
             table = modelInfos.selectTable;
@@ -2056,17 +2219,6 @@ QStringList Terminal::keysToIds(QList<Key> keys) const {
         } else {
             return QStringList();
         }
-        if (!table.isEmpty()) {
-            QSqlQuery query;
-            if (query.exec("SELECT id FROM " + table)) {
-                while (query.next()) {
-                    allIds.append(query.value(0).toString());
-                }
-            } else {
-                qWarning() << Q_FUNC_INFO << query.executedQuery() << query.lastError().text();
-            }
-        }
-
         keys.append(Plus);
         QStringList thruParts;
         QStringList idParts;
@@ -2079,25 +2231,22 @@ QStringList Terminal::keysToIds(QList<Key> keys) const {
                     if (!thruParts.isEmpty() || !idParts.isEmpty()) {
                         return QStringList();
                     }
-                    for (QString existingId : allIds) {
-                        if (idAdding) {
-                            ids.append(existingId);
-                        } else {
-                            ids.removeAll(existingId);
-                        }
+                    if (idAdding) {
+                        selectIds(&ids, table, QString(), QString());
+                    } else {
+                        ids.clear();
                     }
                     idStartsWithPeriod = false;
                 } else {
                     if (!thruParts.isEmpty()) {
                         return QStringList();
                     }
-                    for (QString id : allIds) {
-                        if (id.startsWith(idParts.join(".") + ".") || (id == idParts.join("."))) {
-                            if (idAdding) {
-                                ids.append(id);
-                            } else {
-                                ids.removeAll(id);
-                            }
+                    if (!idParts.isEmpty()) {
+                        const QString sortId = IdSelection::getSortId(idParts.join("."));
+                        if (idAdding) { // The ID itself and all IDs which start with it and a period
+                            selectIds(&ids, table, sortId, sortId + "/");
+                        } else {
+                            ids.removeRange(sortId, sortId + "/");
                         }
                     }
                     idParts.clear();
@@ -2134,38 +2283,26 @@ QStringList Terminal::keysToIds(QList<Key> keys) const {
                                 currentId.chop(2);
                             }
                             if (idAdding) {
-                                ids.append(currentId);
+                                ids.add(currentId);
                             } else {
-                                ids.removeAll(currentId);
+                                ids.remove(currentId);
                             }
                         }
                         thruParts.clear();
                         idStartsWithPeriod = false;
                     } else if (thruParts.isEmpty()) {
                         if (idAdding) {
-                            ids.append(id);
+                            ids.add(id);
                         } else {
-                            ids.removeAll(id);
+                            ids.remove(id);
                         }
                     } else {
-                        const QString thruId = thruParts.join(".");
-                        QStringList allIdsExtended = allIds;
-                        if (!allIdsExtended.contains(thruId)) {
-                            allIdsExtended.append(thruId);
-                        }
-                        if (!allIdsExtended.contains(id)) {
-                            allIdsExtended.append(id);
-                        }
-                        std::sort(allIdsExtended.begin(), allIdsExtended.end(), Terminal::compareIds);
-                        for (int index = allIdsExtended.indexOf(thruId); index <= allIdsExtended.indexOf(id); index++) {
-                            QString currentId = allIdsExtended.at(index);
-                            if (allIds.contains(currentId)) {
-                                if (idAdding) {
-                                    ids.append(currentId);
-                                } else {
-                                    ids.removeAll(currentId);
-                                }
-                            }
+                        const QString fromSortId = IdSelection::getSortId(thruParts.join("."));
+                        const QString toSortId = IdSelection::getSortId(id);
+                        if (idAdding) {
+                            selectIds(&ids, table, fromSortId, toSortId);
+                        } else {
+                            ids.removeRange(fromSortId, toSortId);
                         }
                     }
                     thruParts.clear();
@@ -2187,9 +2324,28 @@ QStringList Terminal::keysToIds(QList<Key> keys) const {
             }
         }
     }
-    ids.removeDuplicates();
-    std::sort(ids.begin(), ids.end(), Terminal::compareIds);
-    return ids;
+    return ids.getIds();
+}
+
+void Terminal::selectIds(IdSelection* ids, const QString table, const QString fromSortId, const QString toSortId) const {
+    if (table.isEmpty()) {
+        return;
+    }
+    PreparedQuery query;
+    if (fromSortId.isNull()) {
+        query.prepare("SELECT id, sortid FROM " + table);
+    } else {
+        query.prepare("SELECT id, sortid FROM " + table + " WHERE sortid BETWEEN :from AND :to");
+        query->bindValue(":from", fromSortId);
+        query->bindValue(":to", toSortId);
+    }
+    if (!query->exec()) {
+        qWarning() << Q_FUNC_INFO << query->executedQuery() << query->lastError().text();
+        return;
+    }
+    while (query->next()) {
+        ids->add(query->value(0).toString(), query->value(1).toString());
+    }
 }
 
 QString Terminal::keysToString(QList<Key> keys) const {
@@ -2201,6 +2357,50 @@ QString Terminal::keysToString(QList<Key> keys) const {
     return string.simplified();
 }
 
+bool Terminal::stringToKeys(const QString& command, QList<Key>* keys, QString* text) const {
+    int position = 0;
+    while (position < command.length()) {
+        const QChar character = command.at(position);
+        if (character.isSpace()) {
+            position++;
+        } else if ((character >= '0') && (character <= '9')) {
+            keys->append(static_cast<Key>(Zero + character.digitValue()));
+            position++;
+        } else if ((character == '.') || (character == ',')) {
+            keys->append(Period);
+            position++;
+        } else if (character == '+') {
+            keys->append(Plus);
+            position++;
+        } else if (character == '-') {
+            keys->append(Minus);
+            position++;
+        } else if (character == '"') {
+            // A text in quotes has to be the end of the command
+            const int end = command.indexOf('"', position + 1);
+            if ((end < 0) || !command.mid(end + 1).trimmed().isEmpty()) {
+                return false;
+            }
+            *text = command.mid(position + 1, end - position - 1);
+            position = command.length();
+        } else if (character.isLetter()) {
+            int end = position;
+            while ((end < command.length()) && command.at(end).isLetter()) {
+                end++;
+            }
+            const QString word = command.mid(position, end - position).toLower();
+            if (!scriptKeys.contains(word)) {
+                return false;
+            }
+            keys->append(scriptKeys.value(word));
+            position = end;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
 void Terminal::info(QString message) {
     messages->appendHtml("<span style=\"color: white\">" + message + "</span>");
     qInfo() << message;
@@ -2217,6 +2417,7 @@ void Terminal::warning(QString message) {
 }
 
 void Terminal::error(QString message) {
+    commandFailed = true;
     messages->appendHtml("<span style=\"color: red\">" + message + "</span>");
     qCritical() << message;
 }
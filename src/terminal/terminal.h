@@ -13,6 +13,9 @@
 #include <QtSql>
 
 #include "constants.h"
+#include "database/itemindex.h"
+#include "database/preparedquery.h"
+#include "terminal/idselection.h"
 
 class Terminal : public QWidget {
     Q_OBJECT
@@ -72,9 +75,21 @@ private:
     };
     const NumberInfos percentageInfos = {0, 100, false, "%"};
     const NumberInfos angleInfos = {0, 360, true, "°"};
+    const qint64 sortkeyGap = 1024;
+    struct Command {
+        Key selectionType;
+        QList<Key> selectionIdKeys;
+        QList<Key> attributeKeys;
+        QList<Key> valueKeys;
+        bool selection = false;
+        QStringList ids;
+        QHash<Key, QStringList> attributes;
+        QString attribute;
+    };
 
 public:
     Terminal(QWidget *parent = nullptr);
+    bool executeScript(const QString& fileName);
     void info(QString message);
     void success(QString message);
     void warning(QString message);
@@ -86,8 +101,11 @@ public slots:
     void reload();
 private:
     void execute();
-    void updateSortingKeys(ItemInfos item);
-    static bool compareIds(QString idA, QString idB);
+    bool parseCommand(QList<Key> keys, Command* command);
+    bool askForInput(const Command& command);
+    void executeCommand(const Command& command);
+    int getTotalChanges() const;
+    void updateSortingKeys(ItemInfos item, QSet<int> changedKeys);
     void setCurrentItem(ItemInfos item, QString itemTable, QList<Key> idKeys, QString updateQueryText);
     void setCueItem(ItemInfos item, QString valueTable, QList<Key> idKeys, bool multipleItemsAllowed);
     void createItems(ItemInfos item, QStringList ids);
@@ -105,17 +123,22 @@ private:
     template <typename T> void setItemAndIntegerSpecificNumberAttribute(ItemInfos item, QString attributeName, QStringList ids, QStringList foreignItemIds, QString numberId, QList<Key> valueKeys, ItemInfos foreignItem, QString valueTable, NumberInfos keyNumber, NumberInfos valueNumber);
     float keysToFloat(QList<Key> keys, bool* ok, float currentValue, NumberInfos number) const;
     QStringList keysToIds(QList<Key> keys) const;
+    void selectIds(IdSelection* ids, QString table, QString fromSortId, QString toSortId) const;
     QString keysToString(QList<Key> keys) const;
+    bool stringToKeys(const QString& command, QList<Key>* keys, QString* text) const;
     void writeKey(Key key);
     void backspace();
     void clearPrompt();
     QSettings* settings;
     QList<Key> promptKeys;
+    bool commandFailed = false;
+    QString commandText;
     QPlainTextEdit *messages;
     QLabel* promptLabel;
     QPushButton* blindButton;
     QPushButton* trackingButton;
     QHash<Key, QString> keyStrings;
+    QHash<QString, Key> scriptKeys;
 };
 
 #endif // TERMINAL_H
@@ -0,0 +1,18 @@
+QT += core
+QT += sql
+QT -= gui
+
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../../src
+
+SOURCES += \
+    ../../src/database/databaseprofile.cpp \
+    ../../src/database/queryplancheck.cpp \
+    main.cpp
+
+HEADERS += \
+    ../../src/database/databaseprofile.h \
+    ../../src/database/queryplancheck.h
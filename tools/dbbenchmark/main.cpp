@@ -0,0 +1,257 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <QtSql>
+
+#include "database/databaseprofile.h"
+#include "database/queryplancheck.h"
+
+struct Latencies {
+    QList<qint64> times;
+    void add(qint64 time) { times.append(time); }
+    QString format() {
+        if (times.isEmpty()) {
+            return "-";
+        }
+        std::sort(times.begin(), times.end());
+        qint64 total = 0;
+        for (const qint64 time : times) {
+            total += time;
+        }
+        auto microseconds = [] (const qint64 time) {
+            return QString::number(time / 1000.0, 'f', 1);
+        };
+        return microseconds(total / times.length()) + " / " + microseconds(times.at(times.length() / 2)) + " / " + microseconds(times.at((times.length() * 99) / 100)) + " / " + microseconds(times.last());
+    }
+};
+
+bool execQuery(QSqlQuery* query) {
+    if (!query->exec()) {
+        qWarning() << query->executedQuery() << query->lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool populate(QSqlDatabase database, const int fixtures, const int groups, const int cues) {
+    QSqlQuery query(database);
+    if (!database.transaction()) {
+        return false;
+    }
+    bool ok = true;
+    query.prepare("INSERT INTO fixtures (key, id, sortkey) VALUES (:key, :id, :key)");
+    for (int fixture = 1; ok && (fixture <= fixtures); fixture++) {
+        query.bindValue(":key", 1000000 + fixture);
+        query.bindValue(":id", "9000." + QString::number(fixture));
+        ok = execQuery(&query);
+    }
+    query.prepare("INSERT INTO groups (key, id, sortkey) VALUES (:key, :id, :key)");
+    for (int group = 1; ok && (group <= groups); group++) {
+        query.bindValue(":key", 1000000 + group);
+        query.bindValue(":id", "9000." + QString::number(group));
+        ok = execQuery(&query);
+    }
+    query.prepare("INSERT INTO group_fixtures (item_key, valueitem_key) VALUES (:group, :fixture)");
+    for (int fixture = 1; ok && (fixture <= fixtures); fixture++) {
+        query.bindValue(":group", 1000000 + ((fixture - 1) % groups) + 1);
+        query.bindValue(":fixture", 1000000 + fixture);
+        ok = execQuery(&query);
+    }
+    query.prepare("INSERT INTO intensities (key, id, sortkey, dimmer) VALUES (:key, :id, :key, 50)");
+    for (int intensity = 1; ok && (intensity <= groups); intensity++) {
+        query.bindValue(":key", 1000000 + intensity);
+        query.bindValue(":id", "9000." + QString::number(intensity));
+        ok = execQuery(&query);
+    }
+    query.prepare("INSERT INTO cuelists (key, id, sortkey) VALUES (1000000, '9000', 1000000)");
+    ok = ok && execQuery(&query);
+    query.prepare("INSERT INTO cues (key, id, sortkey, cuelist_key) VALUES (:key, :id, :key, 1000000)");
+    for (int cue = 1; ok && (cue <= cues); cue++) {
+        query.bindValue(":key", 1000000 + cue);
+        query.bindValue(":id", QString::number(cue));
+        ok = execQuery(&query);
+    }
+    query.prepare("INSERT INTO cue_group_intensities (item_key, foreignitem_key, valueitem_key) VALUES (:cue, :group, :intensity)");
+    for (int cue = 1; ok && (cue <= cues); cue++) {
+        for (int group = 1; ok && (group <= groups); group++) {
+            query.bindValue(":cue", 1000000 + cue);
+            query.bindValue(":group", 1000000 + group);
+            query.bindValue(":intensity", 1000000 + group);
+            ok = execQuery(&query);
+        }
+    }
+    if (!ok) {
+        database.rollback();
+        return false;
+    }
+    return database.commit();
+}
+
+// Like "Fixture 1 Thru <items> Set <value>" in the terminal: a key lookup and an UPDATE per Fixture, then the changed sorting keys in one batch
+qint64 runCommand(QSqlDatabase database, const int items, const int value, const bool transaction) {
+    QElapsedTimer timer;
+    timer.start();
+    if (transaction && !database.transaction()) {
+        return -1;
+    }
+    bool ok = true;
+    {
+        QSqlQuery keyQuery(database);
+        keyQuery.prepare("SELECT key FROM fixtures WHERE id = :id");
+        QSqlQuery updateQuery(database);
+        updateQuery.prepare("UPDATE fixtures SET address = :value WHERE key = :key");
+        for (int fixture = 1; ok && (fixture <= items); fixture++) {
+            keyQuery.bindValue(":id", "9000." + QString::number(fixture));
+            ok = execQuery(&keyQuery) && keyQuery.next();
+            if (ok) {
+                updateQuery.bindValue(":key", keyQuery.value(0));
+                updateQuery.bindValue(":value", value);
+                ok = execQuery(&updateQuery);
+            }
+            keyQuery.finish();
+        }
+        QVariantList keys;
+        QVariantList sortkeys;
+        for (int fixture = 1; fixture <= items; fixture++) {
+            keys.append(1000000 + fixture);
+            sortkeys.append(1000000 + fixture + value);
+        }
+        QSqlQuery sortkeyQuery(database);
+        sortkeyQuery.prepare("UPDATE fixtures SET sortkey = :sortkey WHERE key = :key");
+        sortkeyQuery.bindValue(":key", keys);
+        sortkeyQuery.bindValue(":sortkey", sortkeys);
+        if (ok && !sortkeyQuery.execBatch()) {
+            qWarning() << sortkeyQuery.executedQuery() << sortkeyQuery.lastError().text();
+            ok = false;
+        }
+    }
+    if (transaction) {
+        if (!ok) {
+            database.rollback();
+            return -1;
+        }
+        if (!database.commit()) {
+            return -1;
+        }
+    }
+    return ok ? timer.nsecsElapsed() : -1;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Zöglfrex Database Benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures edit, terminal command and engine read latency of a Zöglfrex file with the different database profiles");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "An empty .zfr file created with Zöglfrex, it is copied and not modified");
+    QCommandLineOption profilesOption("profiles", "The database profiles to compare", "profiles", DatabaseProfile::getNames().join(","));
+    parser.addOption(profilesOption);
+    QCommandLineOption editsOption("edits", "The number of single statement edits", "count", "1000");
+    parser.addOption(editsOption);
+    QCommandLineOption readsOption("reads", "The number of engine read cycles", "count", "1000");
+    parser.addOption(readsOption);
+    QCommandLineOption itemsOption("items", "The number of Fixtures changed by one terminal command", "count", "2000");
+    parser.addOption(itemsOption);
+    parser.process(app);
+    if (parser.positionalArguments().length() != 1) {
+        parser.showHelp(1);
+    }
+    const QString fileName = parser.positionalArguments().first();
+    const int edits = std::max(parser.value(editsOption).toInt(), 1);
+    const int reads = std::max(parser.value(readsOption).toInt(), 1);
+    const int items = std::max(parser.value(itemsOption).toInt(), 1);
+    const int fixtures = std::max(items, 500);
+    const int groups = 50;
+    const int cues = 200;
+
+    QTemporaryDir directory;
+    if (!directory.isValid()) {
+        qCritical() << "Failed to create a temporary directory" << directory.errorString();
+        return 1;
+    }
+    qInfo().noquote() << "Latencies in µs (average / median / 99th percentile / maximum)";
+    for (const QString profile : parser.value(profilesOption).split(",", Qt::SkipEmptyParts)) {
+        const QString copyName = directory.filePath(profile + ".zfr");
+        if (!QFile::copy(fileName, copyName)) {
+            qCritical() << "Failed to copy" << fileName << "to" << copyName;
+            return 1;
+        }
+        {
+            QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", profile);
+            database.setDatabaseName(copyName);
+            if (!database.open() || !DatabaseProfile::apply(database, profile)) {
+                qCritical() << "Failed to open" << copyName << "with profile" << profile;
+                return 1;
+            }
+            QSqlQuery(database).exec("PRAGMA foreign_keys = ON");
+            if (!populate(database, fixtures, groups, cues)) {
+                qCritical() << "Failed to fill the file with test data, is it an empty Zöglfrex file?";
+                return 1;
+            }
+            if (!QueryPlanCheck::check(database)) {
+                qWarning() << "Some queries don't use an index, the file may need to be opened with Zöglfrex once to upgrade it.";
+            }
+            QElapsedTimer timer;
+
+            // Dial ticks: one autocommitted UPDATE each, like AttributePanel::setValue
+            Latencies editLatencies;
+            QSqlQuery editQuery(database);
+            editQuery.prepare("UPDATE intensities SET dimmer = :value WHERE key = :key");
+            for (int edit = 0; edit < edits; edit++) {
+                editQuery.bindValue(":value", edit % 100);
+                editQuery.bindValue(":key", 1000000 + (edit % groups) + 1);
+                timer.start();
+                execQuery(&editQuery);
+                editLatencies.add(timer.nsecsElapsed());
+            }
+
+            // One engine cycle reads the intensity of every group in the current cue
+            Latencies readLatencies;
+            QSqlQuery cueQuery(database);
+            cueQuery.prepare("SELECT valueitem_key FROM cue_group_intensities WHERE item_key = :cue AND foreignitem_key = :group");
+            QSqlQuery intensityQuery(database);
+            intensityQuery.prepare("SELECT dimmer FROM intensities WHERE key = :key");
+            QSqlQuery fixturesQuery(database);
+            fixturesQuery.prepare("SELECT valueitem_key FROM group_fixtures WHERE item_key = :group");
+            for (int read = 0; read < reads; read++) {
+                timer.start();
+                for (int group = 1; group <= groups; group++) {
+                    cueQuery.bindValue(":cue", 1000000 + (read % cues) + 1);
+                    cueQuery.bindValue(":group", 1000000 + group);
+                    execQuery(&cueQuery);
+                    if (cueQuery.next()) {
+                        intensityQuery.bindValue(":key", cueQuery.value(0));
+                        execQuery(&intensityQuery);
+                        intensityQuery.next();
+                    }
+                    fixturesQuery.bindValue(":group", 1000000 + group);
+                    execQuery(&fixturesQuery);
+                    while (fixturesQuery.next()) {}
+                }
+                readLatencies.add(timer.nsecsElapsed());
+                // Interleave an edit as during live programming
+                editQuery.bindValue(":value", read % 100);
+                editQuery.bindValue(":key", 1000000 + (read % groups) + 1);
+                execQuery(&editQuery);
+            }
+            qInfo().noquote() << (profile + ":").leftJustified(13) << "Edit" << editLatencies.format() << "  Engine Read" << readLatencies.format();
+
+            // One terminal command over many Fixtures, statement by statement and in one transaction
+            auto milliseconds = [] (const qint64 time) {
+                return (time < 0) ? QString("failed") : (QString::number(time / 1000000.0, 'f', 1) + " ms");
+            };
+            const qint64 autocommitTime = runCommand(database, items, 1, false);
+            const qint64 transactionTime = runCommand(database, items, 2, true);
+            qInfo().noquote() << QString().leftJustified(13) << "Command over" << items << "Fixtures: Autocommit" << milliseconds(autocommitTime) << "  Transaction" << milliseconds(transactionTime);
+            database.close();
+        }
+        QSqlDatabase::removeDatabase(profile);
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <QtNetwork>
+
+#include "sacnreceiver.h"
+#include "sacnserver/sacnoutput.h"
+
+QList<int> parseUniverses(const QString text) {
+    QList<int> universes;
+    for (const QString part : text.split(",", Qt::SkipEmptyParts)) {
+        const QStringList range = part.trimmed().split("-");
+        const int start = range.first().toInt();
+        const int end = range.last().toInt();
+        for (int universe = std::max(start, 1); universe <= std::min(end, 63999); universe++) {
+            universes.append(universe);
+        }
+    }
+    return universes;
+}
+
+void printStatistics(const QString label, const SacnReceiver::Statistics statistics, const float seconds) {
+    qInfo().noquote() << label
+        << "Universes:" << statistics.universes
+        << "Packets/s:" << QString::number(statistics.dataPackets / seconds, 'f', 0)
+        << "Sync:" << statistics.syncPackets
+        << "Discovery:" << statistics.discoveryPackets
+        << "Jitter:" << QString::number(statistics.jitter, 'f', 3) + " ms"
+        << "Lost:" << statistics.lostPackets
+        << "Out of Order:" << statistics.outOfOrderPackets
+        << "Invalid:" << statistics.invalidPackets;
+}
+
+int runBenchmark(SacnReceiver* receiver, const QNetworkAddressEntry address, const bool multicast, const int maxUniverses, const int frames) {
+    SacnOutput output;
+    OutputBackend::Interface interface;
+    for (const QNetworkInterface networkInterface : QNetworkInterface::allInterfaces()) {
+        for (const QNetworkAddressEntry entry : networkInterface.addressEntries()) {
+            if (entry.ip() == address.ip()) {
+                interface.networkInterface = networkInterface;
+                interface.address = entry;
+            }
+        }
+    }
+    output.setInterfaces({interface});
+    qInfo().noquote() << "Universes  Frames  Send Time (avg)  Send Time (max)  Packets/s  Received  Lost  Out of Order";
+    for (int universeCount = 1; universeCount <= maxUniverses; universeCount *= 2) {
+        DmxFrame frame;
+        QHash<int, QList<quint32>> destinations;
+        for (int universe = 1; universe <= universeCount; universe++) {
+            frame.appendUniverse(universe, QByteArray(512, 0));
+            if (!multicast) {
+                destinations[universe] = {address.ip().toIPv4Address()};
+            }
+        }
+        output.setUnicastDestinations(destinations);
+        output.sendFrame(frame);
+        QThread::msleep(100);
+        receiver->reset();
+
+        QElapsedTimer sendTimer;
+        qint64 totalSendTime = 0;
+        qint64 maxSendTime = 0;
+        for (int frameNumber = 0; frameNumber < frames; frameNumber++) {
+            for (int universe = 0; universe < frame.universeCount; universe++) {
+                memset(frame.data[universe].data(), frameNumber % 256, frame.data.at(universe).size());
+            }
+            sendTimer.start();
+            output.sendFrame(frame);
+            const qint64 sendTime = sendTimer.nsecsElapsed();
+            totalSendTime += sendTime;
+            maxSendTime = std::max(sendTime, maxSendTime);
+            QCoreApplication::processEvents();
+        }
+        QThread::msleep(100);
+        QCoreApplication::processEvents();
+        const SacnReceiver::Statistics statistics = receiver->takeStatistics();
+        qInfo().noquote()
+            << QString::number(universeCount).rightJustified(9)
+            << QString::number(frames).rightJustified(7)
+            << (QString::number(totalSendTime / 1000.0 / frames, 'f', 1) + " µs").rightJustified(16)
+            << (QString::number(maxSendTime / 1000.0, 'f', 1) + " µs").rightJustified(16)
+            << QString::number((double)universeCount * frames * 1000000000.0 / std::max(totalSendTime, (qint64)1), 'f', 0).rightJustified(10)
+            << QString::number(statistics.dataPackets).rightJustified(9)
+            << QString::number(statistics.lostPackets).rightJustified(5)
+            << QString::number(statistics.outOfOrderPackets).rightJustified(13);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Zöglfrex sACN Monitor");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("sACN receiver and output benchmark for Zöglfrex");
+    parser.addHelpOption();
+    QCommandLineOption addressOption("address", "The IPv4 address of the network interface to listen on", "address", "127.0.0.1");
+    parser.addOption(addressOption);
+    QCommandLineOption universesOption("universes", "The universes to join, e.g. 1-16,20", "universes", "1-16");
+    parser.addOption(universesOption);
+    QCommandLineOption unicastOption("unicast", "Don't join multicast groups and only receive unicast packets");
+    parser.addOption(unicastOption);
+    QCommandLineOption benchmarkOption("benchmark", "Send synthetic frames with 1 up to 512 universes and measure the output path");
+    parser.addOption(benchmarkOption);
+    QCommandLineOption maxUniversesOption("max-universes", "The maximum number of universes in benchmark mode", "count", "512");
+    parser.addOption(maxUniversesOption);
+    QCommandLineOption framesOption("frames", "The number of frames per benchmark step", "count", "200");
+    parser.addOption(framesOption);
+    parser.process(app);
+
+    const QHostAddress address(parser.value(addressOption));
+    if (address.protocol() != QAbstractSocket::IPv4Protocol) {
+        qCritical() << "Invalid IPv4 address" << parser.value(addressOption);
+        return 1;
+    }
+    const bool multicast = !parser.isSet(unicastOption);
+    SacnReceiver receiver;
+    if (parser.isSet(benchmarkOption)) {
+        const int maxUniverses = std::min(std::max(parser.value(maxUniversesOption).toInt(), 1), 512);
+        QList<int> universes;
+        for (int universe = 1; universe <= maxUniverses; universe++) {
+            universes.append(universe);
+        }
+        if (multicast && (maxUniverses > 20)) {
+            qWarning() << "Many systems can't join more than 20 multicast groups per socket, so --unicast is recommended for large benchmarks.";
+        }
+        if (!receiver.listen(address, universes, multicast)) {
+            return 1;
+        }
+        QNetworkAddressEntry entry;
+        entry.setIp(address);
+        return runBenchmark(&receiver, entry, multicast, maxUniverses, std::max(parser.value(framesOption).toInt(), 1));
+    }
+
+    if (!receiver.listen(address, parseUniverses(parser.value(universesOption)), multicast)) {
+        return 1;
+    }
+    QElapsedTimer statisticsTimer;
+    statisticsTimer.start();
+    QTimer timer;
+    QObject::connect(&timer, &QTimer::timeout, &receiver, [&receiver, &statisticsTimer] {
+        const float seconds = statisticsTimer.restart() / 1000.0;
+        printStatistics(QDateTime::currentDateTime().toString("hh:mm:ss"), receiver.takeStatistics(), seconds);
+    });
+    timer.start(1000);
+    return app.exec();
+}
@@ -0,0 +1,25 @@
+QT += core
+QT += network
+QT -= gui
+
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../../src
+
+SOURCES += \
+    ../../src/datagramsender/datagramsender.cpp \
+    ../../src/outputbackend/outputbackend.cpp \
+    ../../src/outputthread/dmxframe.cpp \
+    ../../src/sacnserver/sacnoutput.cpp \
+    main.cpp \
+    sacnreceiver.cpp
+
+HEADERS += \
+    ../../src/datagramsender/datagramsender.h \
+    ../../src/outputbackend/outputbackend.h \
+    ../../src/outputthread/dmxframe.h \
+    ../../src/outputthread/frameoutput.h \
+    ../../src/sacnserver/sacnoutput.h \
+    sacnreceiver.h
@@ -0,0 +1,151 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "sacnreceiver.h"
+
+SacnReceiver::SacnReceiver(QObject* parent) : QObject(parent) {
+    socket = new QUdpSocket(this);
+    connect(socket, &QUdpSocket::readyRead, this, &SacnReceiver::readPackets);
+    clock.start();
+}
+
+bool SacnReceiver::listen(const QHostAddress address, const QList<int> universes, const bool multicast) {
+    if (!socket->bind(QHostAddress::AnyIPv4, 5568, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+        qCritical() << Q_FUNC_INFO << socket->errorString();
+        return false;
+    }
+    socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 8 * 1024 * 1024);
+    if (!multicast) {
+        return true;
+    }
+    QNetworkInterface networkInterface;
+    for (const QNetworkInterface interface : QNetworkInterface::allInterfaces()) {
+        for (const QNetworkAddressEntry entry : interface.addressEntries()) {
+            if (entry.ip() == address) {
+                networkInterface = interface;
+            }
+        }
+    }
+    if (!networkInterface.isValid()) {
+        qCritical() << Q_FUNC_INFO << "No network interface with address" << address.toString();
+        return false;
+    }
+    QList<QHostAddress> groups;
+    groups.append(QHostAddress("239.255.250.214"));
+    for (const int universe : universes) {
+        groups.append(QHostAddress("239.255." + QString::number(universe / 256) + "." + QString::number(universe % 256)));
+    }
+    for (const QHostAddress group : groups) {
+        if (!socket->joinMulticastGroup(group, networkInterface)) {
+            qWarning() << Q_FUNC_INFO << "Can't join multicast group" << group.toString() << socket->errorString();
+        }
+    }
+    return true;
+}
+
+SacnReceiver::Statistics SacnReceiver::takeStatistics() {
+    Statistics result = statistics;
+    int jitterUniverses = 0;
+    for (UniverseState& state : universeStates) {
+        if (state.intervals > 1) {
+            result.jitter += std::sqrt(state.intervalSquares / (state.intervals - 1)) / 1000000.0;
+            jitterUniverses++;
+        }
+        state.intervals = 0;
+        state.intervalMean = 0;
+        state.intervalSquares = 0;
+    }
+    if (jitterUniverses > 0) {
+        result.jitter /= jitterUniverses;
+    }
+    result.universes = universeStates.size();
+    statistics = Statistics();
+    return result;
+}
+
+void SacnReceiver::reset() {
+    readPackets();
+    universeStates.clear();
+    syncSequence = -1;
+    statistics = Statistics();
+}
+
+void SacnReceiver::readPackets() {
+    while (socket->hasPendingDatagrams()) {
+        QByteArray packet(socket->pendingDatagramSize(), 0);
+        socket->readDatagram(packet.data(), packet.size());
+        parsePacket(packet, clock.nsecsElapsed());
+    }
+}
+
+void SacnReceiver::parsePacket(const QByteArray& packet, const qint64 time) {
+    const QByteArray identifier("ASC-E1.17\0\0\0", 12);
+    if ((packet.size() < 44) || (packet.mid(4, 12) != identifier)) {
+        statistics.invalidPackets++;
+        return;
+    }
+    const int rootVector = readNumber(packet, 18, 4);
+    const int framingVector = readNumber(packet, 40, 4);
+    if ((rootVector == 0x04) && (framingVector == 0x02)) {
+        parseDataPacket(packet, time);
+    } else if ((rootVector == 0x08) && (framingVector == 0x01) && (packet.size() >= 49)) {
+        // Synchronization Packet
+        const int sequence = (uint8_t)packet.at(44);
+        if ((syncSequence >= 0) && (sequence != ((syncSequence + 1) % 256))) {
+            statistics.lostPackets++;
+        }
+        syncSequence = sequence;
+        statistics.syncPackets++;
+    } else if ((rootVector == 0x08) && (framingVector == 0x02) && (packet.size() >= 120)) {
+        // Universe Discovery Packet
+        statistics.discoveryPackets++;
+    } else {
+        statistics.invalidPackets++;
+    }
+}
+
+void SacnReceiver::parseDataPacket(const QByteArray& packet, const qint64 time) {
+    if (packet.size() < 126) {
+        statistics.invalidPackets++;
+        return;
+    }
+    const int sequence = (uint8_t)packet.at(111);
+    const int universe = readNumber(packet, 113, 2);
+    const int propertyValueCount = readNumber(packet, 123, 2);
+    if ((propertyValueCount < 1) || (packet.size() != (125 + propertyValueCount))) {
+        statistics.invalidPackets++;
+        return;
+    }
+    statistics.dataPackets++;
+    UniverseState& state = universeStates[universe];
+    if (state.sequence >= 0) {
+        const int8_t difference = (int8_t)(sequence - state.sequence);
+        if ((difference <= 0) && (difference > -20)) {
+            statistics.outOfOrderPackets++;
+            return;
+        }
+        statistics.lostPackets += std::max(difference - 1, 0);
+    }
+    state.sequence = sequence;
+    if (state.lastPacketTime >= 0) {
+        const double interval = time - state.lastPacketTime;
+        state.intervals++;
+        const double delta = interval - state.intervalMean;
+        state.intervalMean += delta / state.intervals;
+        state.intervalSquares += delta * (interval - state.intervalMean);
+    }
+    state.lastPacketTime = time;
+}
+
+int SacnReceiver::readNumber(const QByteArray& packet, const int index, const int bytes) const {
+    int number = 0;
+    for (int byte = 0; byte < bytes; byte++) {
+        number = (number * 256) + (uint8_t)packet.at(index + byte);
+    }
+    return number;
+}
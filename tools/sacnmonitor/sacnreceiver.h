@@ -0,0 +1,51 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SACNRECEIVER_H
+#define SACNRECEIVER_H
+
+#include <QtNetwork>
+
+class SacnReceiver : public QObject {
+    Q_OBJECT
+public:
+    struct Statistics {
+        int dataPackets = 0;
+        int syncPackets = 0;
+        int discoveryPackets = 0;
+        int invalidPackets = 0;
+        int lostPackets = 0;
+        int outOfOrderPackets = 0;
+        int universes = 0;
+        float jitter = 0;
+    };
+    SacnReceiver(QObject* parent = nullptr);
+    bool listen(QHostAddress address, QList<int> universes, bool multicast);
+    Statistics takeStatistics();
+    void reset();
+private slots:
+    void readPackets();
+private:
+    struct UniverseState {
+        int sequence = -1;
+        qint64 lastPacketTime = -1;
+        int intervals = 0;
+        double intervalMean = 0;
+        double intervalSquares = 0;
+    };
+    void parsePacket(const QByteArray& packet, qint64 time);
+    void parseDataPacket(const QByteArray& packet, qint64 time);
+    int readNumber(const QByteArray& packet, int index, int bytes) const;
+    QUdpSocket* socket;
+    QElapsedTimer clock;
+    QHash<int, UniverseState> universeStates;
+    int syncSequence = -1;
+    Statistics statistics;
+};
+
+#endif // SACNRECEIVER_H
@@ -0,0 +1,141 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <QtCore>
+
+#include "terminal/idselection.h"
+
+// The ID comparison and list handling keysToIds used before IdSelection, as a baseline
+bool compareIds(const QString a, const QString b) {
+    QStringList aParts = a.split(".");
+    QStringList bParts = b.split(".");
+    for (int part = 0; part < std::min(aParts.length(), bParts.length()); part++) {
+        const int aPart = aParts.at(part).toInt();
+        const int bPart = bParts.at(part).toInt();
+        if (aPart != bPart) {
+            return aPart < bPart;
+        }
+    }
+    return (aParts.length() < bParts.length());
+}
+
+struct Rows {
+    QStringList ids;
+    QStringList sortIds;
+};
+
+// The rows a sort ID range query returns
+Rows getRows(const Rows& table, const QString fromSortId, const QString toSortId) {
+    Rows rows;
+    const qsizetype begin = std::lower_bound(table.sortIds.cbegin(), table.sortIds.cend(), fromSortId) - table.sortIds.cbegin();
+    for (qsizetype row = begin; (row < table.sortIds.length()) && (table.sortIds.at(row) <= toSortId); row++) {
+        rows.ids.append(table.ids.at(row));
+        rows.sortIds.append(table.sortIds.at(row));
+    }
+    return rows;
+}
+
+qint64 median(QList<qint64> times) {
+    std::sort(times.begin(), times.end());
+    return times.at(times.length() / 2);
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Zöglfrex Selection Benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures how long the terminal needs to resolve large Fixture selections");
+    parser.addHelpOption();
+    QCommandLineOption fixturesOption("fixtures", "The number of Fixtures", "count", "10000");
+    parser.addOption(fixturesOption);
+    QCommandLineOption runsOption("runs", "The number of runs per selection", "count", "10");
+    parser.addOption(runsOption);
+    parser.process(app);
+    const int fixtures = std::max(parser.value(fixturesOption).toInt(), 100);
+    const int runs = std::max(parser.value(runsOption).toInt(), 1);
+
+    // Fixtures 1 to n, and 99 sub IDs of the Fixture in the 90th percentile
+    const int subFixture = (fixtures * 9) / 10;
+    Rows table;
+    for (int fixture = 1; fixture <= fixtures; fixture++) {
+        table.ids.append(QString::number(fixture));
+        if (fixture == subFixture) {
+            for (int part = 1; part <= 99; part++) {
+                table.ids.append(QString::number(fixture) + "." + QString::number(part));
+            }
+        }
+    }
+    for (const QString id : table.ids) {
+        table.sortIds.append(IdSelection::getSortId(id));
+    }
+
+    // Fixture 1 Thru n - 2 Thru 0.8n + 0.9n. Thru 0.9n.99
+    const QString firstId = "1";
+    const QString lastId = QString::number(fixtures);
+    const QString removeFromId = "2";
+    const QString removeToId = QString::number((fixtures * 8) / 10);
+    const QString subFromId = QString::number(subFixture) + ".1";
+    const QString subToId = QString::number(subFixture) + ".99";
+    qInfo().noquote() << "Fixture" << firstId << "Thru" << lastId << "-" << removeFromId << "Thru" << removeToId << "+" << subFromId << "Thru" << subToId << "with" << table.ids.length() << "Fixtures, median of" << runs << "runs";
+
+    // The database part is the same for both, so only the set operations are measured
+    const Rows allRows = getRows(table, IdSelection::getSortId(firstId), IdSelection::getSortId(lastId));
+    const Rows removedRows = getRows(table, IdSelection::getSortId(removeFromId), IdSelection::getSortId(removeToId));
+    const Rows subRows = getRows(table, IdSelection::getSortId(subFromId), IdSelection::getSortId(subToId));
+    QElapsedTimer timer;
+    QList<qint64> listTimes;
+    QList<qint64> selectionTimes;
+    QList<qint64> sortIdTimes;
+    QStringList listIds;
+    QStringList selectionIds;
+    for (int run = 0; run < runs; run++) {
+        timer.start();
+        QStringList ids;
+        for (const QString id : allRows.ids) {
+            ids.append(id);
+        }
+        for (const QString id : removedRows.ids) {
+            ids.removeAll(id);
+        }
+        for (const QString id : subRows.ids) {
+            ids.append(id);
+        }
+        ids.removeDuplicates();
+        std::sort(ids.begin(), ids.end(), compareIds);
+        listTimes.append(timer.nsecsElapsed());
+        listIds = ids;
+
+        timer.start();
+        IdSelection selection;
+        for (qsizetype row = 0; row < allRows.ids.length(); row++) {
+            selection.add(allRows.ids.at(row), allRows.sortIds.at(row));
+        }
+        selection.removeRange(IdSelection::getSortId(removeFromId), IdSelection::getSortId(removeToId));
+        for (qsizetype row = 0; row < subRows.ids.length(); row++) {
+            selection.add(subRows.ids.at(row), subRows.sortIds.at(row));
+        }
+        selectionIds = selection.getIds();
+        selectionTimes.append(timer.nsecsElapsed());
+
+        timer.start();
+        for (const QString id : table.ids) {
+            IdSelection::getSortId(id);
+        }
+        sortIdTimes.append(timer.nsecsElapsed());
+    }
+    if (listIds != selectionIds) {
+        qCritical() << "The selections differ:" << listIds.length() << "and" << selectionIds.length() << "Fixtures";
+        return 1;
+    }
+    qInfo().noquote() << "Selected Fixtures:" << selectionIds.length();
+    qInfo().noquote() << "QStringList:" << QString::number(median(listTimes) / 1000.0, 'f', 1) << "µs";
+    qInfo().noquote() << "IdSelection:" << QString::number(median(selectionTimes) / 1000.0, 'f', 1) << "µs";
+    qInfo().noquote() << "Sort IDs of all Fixtures:" << QString::number(median(sortIdTimes) / 1000.0, 'f', 1) << "µs";
+    return 0;
+}
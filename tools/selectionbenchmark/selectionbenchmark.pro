@@ -0,0 +1,15 @@
+QT += core
+QT -= gui
+
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../../src
+
+SOURCES += \
+    ../../src/terminal/idselection.cpp \
+    main.cpp
+
+HEADERS += \
+    ../../src/terminal/idselection.h
@@ -0,0 +1,102 @@
+/*
+    Copyright (c) Arne Bersch
+    This file is part of Zöglfrex.
+    Zöglfrex is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+    Zöglfrex is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License along with Zöglfrex. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Sample reader for the shared memory output of Zöglfrex, see docs/shared_memory.md
+// It doesn't use Qt on purpose, the layout header is all a reader needs.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "sharedmemoryoutput/sharedmemorylayout.h"
+
+const SharedMemoryHeader* openSharedMemory(const char* name) {
+    const int descriptor = shm_open(name, O_RDONLY, 0);
+    if (descriptor < 0) {
+        return nullptr;
+    }
+    struct stat status;
+    if ((fstat(descriptor, &status) < 0) || ((size_t)status.st_size < SHAREDMEMORY_SIZE)) {
+        close(descriptor);
+        return nullptr;
+    }
+    void* memory = mmap(nullptr, SHAREDMEMORY_SIZE, PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    const SharedMemoryHeader* header = static_cast<const SharedMemoryHeader*>(memory);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((memcmp(header->magic, SHAREDMEMORY_MAGIC, sizeof(SHAREDMEMORY_MAGIC)) != 0) || (header->version != SHAREDMEMORY_VERSION) || (header->headerSize != sizeof(SharedMemoryHeader)) || (header->slotSize != sizeof(SharedMemorySlot))) {
+        munmap(memory, SHAREDMEMORY_SIZE);
+        return nullptr;
+    }
+    return header;
+}
+
+int main(int argc, char* argv[]) {
+    const char* name = (argc > 1) ? argv[1] : "/zoeglfrex-dmx";
+    const SharedMemoryHeader* header = nullptr;
+    uint64_t lastFrameCount = 0;
+    int stalledSeconds = 0;
+    while (true) {
+        if (header == nullptr) {
+            header = openSharedMemory(name);
+            if (header == nullptr) {
+                printf("Waiting for shared memory %s\n", name);
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                continue;
+            }
+            lastFrameCount = header->frameCount.load(std::memory_order_acquire);
+            stalledSeconds = 0;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const uint64_t frameCount = header->frameCount.load(std::memory_order_acquire);
+        if (frameCount == lastFrameCount) {
+            // Zöglfrex removes the shared memory when it stops, so open it again
+            if (++stalledSeconds >= 2) {
+                munmap(const_cast<SharedMemoryHeader*>(header), SHAREDMEMORY_SIZE);
+                header = nullptr;
+            }
+            continue;
+        }
+        stalledSeconds = 0;
+        const uint64_t frames = frameCount - lastFrameCount;
+        lastFrameCount = frameCount;
+
+        // The data is read in place, the sequence tells if the slot was overwritten meanwhile
+        const SharedMemorySlot* slots = reinterpret_cast<const SharedMemorySlot*>(reinterpret_cast<const char*>(header) + header->headerSize);
+        const SharedMemorySlot* slot = &slots[(frameCount - 1) % header->slotCount];
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if ((sequence % 2) != 0) {
+            continue;
+        }
+        const uint32_t universeCount = std::min(slot->universeCount, header->maxUniverses);
+        const long long age = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() - slot->timestamp;
+        char values[64] = "";
+        if (universeCount > 0) {
+            int length = snprintf(values, sizeof(values), "Universe %u:", slot->universes[0].universe);
+            for (int address = 0; (address < 8) && (address < slot->universes[0].size) && (length > 0) && (length < (int)sizeof(values)); address++) {
+                length += snprintf(values + length, sizeof(values) - length, " %u", slot->data[0][address]);
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        printf("Frame %llu, %llu frames/s, %u universes, %lld ms old, %s\n", (unsigned long long)slot->frameNumber, (unsigned long long)frames, universeCount, age, values);
+        fflush(stdout);
+    }
+    return 0;
+}
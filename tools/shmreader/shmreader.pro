@@ -0,0 +1,15 @@
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+INCLUDEPATH += ../../src
+
+# shm_open is part of librt on older glibc versions
+unix:!macx: LIBS += -lrt
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../../src/sharedmemoryoutput/sharedmemorylayout.h